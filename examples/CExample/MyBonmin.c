@@ -113,3 +113,35 @@ Bool eval_h(Index n, Number *x, Bool new_x, Number obj_factor,
     return TRUE;
 }
 
+
+/* Optional combined callbacks (see SetBonminCombinedCallbacks), they are
+   written here with the single point callbacks above. */
+Bool eval_f_g_jac(Index n, Number* x, Bool new_x,
+                  Number* obj_value, Index m, Number* g,
+                  Index nele_jac, Number* jac_values,
+                  UserDataPtr user_data)
+{
+    assert(n==4);
+    assert(m==3);
+    assert(nele_jac==7);
+    return eval_f(n, x, new_x, obj_value, user_data)
+        && eval_g(n, x, new_x, m, g, user_data)
+        && eval_jac_g(n, x, new_x, m, nele_jac, NULL, NULL, jac_values, user_data);
+}
+
+Bool eval_batch(Index n, Index num_points, Number* x,
+                Number* obj_values, Index m, Number* g,
+                UserDataPtr user_data)
+{
+    Index k;
+    assert(n==4);
+    assert(m==3);
+    for(k = 0 ; k < num_points ; k++)
+    {
+        if(!eval_f(n, x + k*n, TRUE, obj_values + k, user_data))
+            return FALSE;
+        if(g != NULL && !eval_g(n, x + k*n, FALSE, m, g + k*m, user_data))
+            return FALSE;
+    }
+    return TRUE;
+}
@@ -28,3 +28,12 @@ Bool eval_h(Index n, Number *x, Bool new_x, Number obj_factor,
             Index m, Number *lambda, Bool new_lambda,
             Index nnz_h_lag, Index *iRow, Index *jCol,
             Number *values, UserDataPtr user_data);
+
+Bool eval_f_g_jac(Index n, Number* x, Bool new_x,
+                  Number* obj_value, Index m, Number* g,
+                  Index nele_jac, Number* jac_values,
+                  UserDataPtr user_data);
+
+Bool eval_batch(Index n, Index num_points, Number* x,
+                Number* obj_values, Index m, Number* g,
+                UserDataPtr user_data);
@@ -45,6 +45,10 @@ int main(int argc, char const *argv[])
                         index_style, &eval_f, &eval_g, &eval_grad_f,
                         &eval_jac_g, &eval_h, variable_types, variable_linearity_types,
                         constraint_linearity_types, NULL, NULL);
+    /* Objective, constraints and Jacobian in one call, and several points
+       in one call (used by outer approximation to check the points of the
+       MILP pool).*/
+    SetBonminCombinedCallbacks(bonmin_problem, &eval_f_g_jac, &eval_batch);
     AddBonminStrOption(bonmin_problem, "bonmin.algorithm", "B-OA");
 
 
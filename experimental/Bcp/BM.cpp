@@ -77,6 +77,12 @@ void BCP_parameter_set<BM_par>::create_keyword_list() {
 			     BCP_parameter(BCP_IntPar, PreferHighCombinationInBranching)));
     keys.push_back(make_pair(BCP_string("BM_NumNlpFailureMax"),
 			     BCP_parameter(BCP_IntPar, NumNlpFailureMax)));
+    keys.push_back(make_pair(BCP_string("BM_SBNumBranchesInRoot"),
+			     BCP_parameter(BCP_IntPar, SBNumBranchesInRoot)));
+    keys.push_back(make_pair(BCP_string("BM_SBNumBranchesInTree"),
+			     BCP_parameter(BCP_IntPar, SBNumBranchesInTree)));
+    keys.push_back(make_pair(BCP_string("BM_SBMaxLevel"),
+			     BCP_parameter(BCP_IntPar, SBMaxLevel)));
     keys.push_back(make_pair(BCP_string("BM_NL_filename"),
 			     BCP_parameter(BCP_StringPar, NL_filename)));
     keys.push_back(make_pair(BCP_string("BM_IpoptParamfile"),
@@ -93,6 +99,9 @@ void BCP_parameter_set<BM_par>::set_default_entries() {
     set_entry(DecreasingSortInSetupList, 1);
     set_entry(PreferHighCombinationInBranching, 0);
     set_entry(NumNlpFailureMax, 5);
+    set_entry(SBNumBranchesInRoot, 100);
+    set_entry(SBNumBranchesInTree, 100);
+    set_entry(SBMaxLevel, 12);
     set_entry(NL_filename, "");
     set_entry(IpoptParamfile, "");
 }
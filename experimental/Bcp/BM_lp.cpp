@@ -8,7 +8,6 @@
 
 #include "OsiClpSolverInterface.hpp"
 #include "BM.hpp"
-#include "BCP_message_mpi.hpp"
 #include "BCP_lp_node.hpp"
 #include "BCP_lp.hpp"
 
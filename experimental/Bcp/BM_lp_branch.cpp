@@ -475,12 +475,13 @@ BM_lp::do_distributed_SB(OsiBranchingInformation& branchInfo,
   collect_branch_data(branchInfo, solver, branchNum, branchData);
 
   // We have branchNum branches to process on pidNum+1 (the last is the local
-  // process) processes.
+  // process) processes. Every process we were given gets a request (maybe an
+  // empty one) so that it reports back and gets released by the TM.
   int branchLeft = branchNum;
   BM_BranchData* bD = branchData;
   for (int pidLeft = pidNum; pidLeft > 0; --pidLeft) {
-    int numSend = branchLeft / pidLeft;
-    if (numSend * pidLeft < branchLeft) {
+    int numSend = branchLeft / (pidLeft + 1);
+    if (numSend * (pidLeft + 1) < branchLeft) {
       ++numSend;
     }
     bm_buf.set_size(fixed_size);
@@ -509,8 +510,7 @@ BM_lp::do_distributed_SB(OsiBranchingInformation& branchInfo,
   BM_register_branch_results(branchLeft, bD, sbResult_);
 
   // Receive the results from the other processes
-  int numResults = branchLeft;
-  while (numResults < branchNum) {
+  for (int numReplies = 0; numReplies < pidNum; ++numReplies) {
     bm_buf.clear();
     receive_message(BCP_AnyProcess, bm_buf, BCP_Msg_User);
     bm_buf.unpack(tag);
@@ -527,8 +527,8 @@ BM_lp::do_distributed_SB(OsiBranchingInformation& branchInfo,
       bm_buf.unpack(bD[i].time);
     }
     BM_register_branch_results(numRes, bD, sbResult_);
-    numResults += numRes;
   }
+  delete[] branchData;
 }
 
 //-----------------------------------------------------------------------------
@@ -787,7 +787,7 @@ BM_lp::try_to_branch(OsiBranchingInformation& branchInfo,
       // parameter value.
       branchNum = CoinMin(branchNum, par.entry(BM_par::SBNumBranchesInRoot));
     } else {
-      if (nodeIndex < par.entry(BM_par::SBMaxLevel)) {
+      if (current_level() < par.entry(BM_par::SBMaxLevel)) {
 	branchNum = CoinMin(branchNum,
 			    CoinMax(pidNum + 1,
 				    par.entry(BM_par::SBNumBranchesInTree)));
@@ -10,8 +10,44 @@
 
 #include "BonAmplSetup.hpp"
 
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+
 //#############################################################################
 
+/** Write the content of an .nl file into a new temporary file. Returns the
+    stub of the file (the file itself is stub.nl, stub is an empty file
+    reserving the name). */
+static std::string
+BM_write_temporary_nl(const BCP_string& content)
+{
+    const char* dir = getenv("TMPDIR");
+    std::string name = std::string(dir ? dir : "/tmp") + "/bonminbcpXXXXXX";
+    char* tmpl = strdup(name.c_str());
+    int fd = mkstemp(tmpl);
+    if (fd < 0) {
+	free(tmpl);
+	throw BCP_fatal_error("BM_lp: can not create a temporary file.\n");
+    }
+    close(fd);
+    std::string stub(tmpl);
+    free(tmpl);
+
+    FILE* nl = fopen((stub + ".nl").c_str(), "wb");
+    if (!nl || fwrite(content.c_str(), 1, content.length(), nl) != content.length()) {
+	if (nl) {
+	    fclose(nl);
+	}
+	remove(stub.c_str());
+	throw BCP_fatal_error("BM_lp: can not write the temporary .nl file.\n");
+    }
+    fclose(nl);
+    return stub;
+}
+
+/****************************************************************************/
+
 void
 BM_tm::pack_module_data(BCP_buffer& buf, BCP_process_t ptype)
 {
@@ -40,20 +76,37 @@ BM_lp::unpack_module_data(BCP_buffer& buf)
     buf.unpack(nl_file_content);
     buf.unpack(ipopt_file_content);
 
+    /* The stock ASL can only read a model from a file: write the content
+       sent by the tree manager into a private temporary .nl file. */
+    std::string stub = BM_write_temporary_nl(nl_file_content);
+
     char* argv_[3];
     char** argv = argv_;
     argv[0] = NULL;
-    argv[1] = strdup("dont_even_try_to_open_it.nl");
+    argv[1] = strdup(stub.c_str());
     argv[2] = NULL;
     std::string ipopt_content(ipopt_file_content.c_str());
-    std::string nl_content(nl_file_content.c_str());
 
-    /* PIERRE create the setup for algorithm, last argument indicates that
-      continuous relaxation should not be created.*/
-    bonmin_.initialize(argv, ipopt_content, nl_content, false);
-    bonmin_.nonlinearSolver()->setExposeWarmStart(true);
+    bonmin_.readOptionsString(ipopt_content);
+    bonmin_.initialize(argv);
+    /* Node warm starts are shipped to the strong branching processes.*/
+    Bonmin::OsiTMINLPInterface* nlpSolver = bonmin_.nonlinearSolver();
+    if (nlpSolver->getWarmStartMode() < OsiTMINLPInterface::Optimum) {
+      nlpSolver->setWarmStartMode(OsiTMINLPInterface::Optimum);
+    }
 
     free(argv[1]);
+    remove((stub + ".nl").c_str());
+    remove(stub.c_str());
+
+    if (bonmin_.getAlgorithm() != B_BB) {
+      throw BCP_fatal_error("\
+BM_lp: bonminbcp only implements the B-BB algorithm.\n");
+    }
+    if (dynamic_cast<BonChooseVariable*>(bonmin_.branchingMethod()) == NULL) {
+      throw BCP_fatal_error("\
+BM_lp: bonminbcp needs a variable_selection based on pseudo-costs or strong branching.\n");
+    }
 
     /* synchronize bonmin & BCP parameters */
     Ipopt::SmartPtr<Ipopt::OptionsList> options = bonmin_.options();
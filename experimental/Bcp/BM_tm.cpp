@@ -86,28 +86,18 @@ BM_tm::initialize_core(BCP_vec<BCP_var_core*>& vars,
     OsiSolverInterface& clp  = *bonmin.continuousSolver();
     
     const int numCols = clp.getNumCols();
-    const int numRows = clp.getNumRows();
 
     const double* clb = clp.getColLower();
     const double* cub = clp.getColUpper();
 
-    double* obj = new double[numCols];
-    if (bonmin.getAlgorithm() == Bonmin::B_BB /* pure B&B */) {
-      std::cout<<"Doing branch and bound"<<std::endl;
-      CoinFillN(obj, numCols, 0.0);
-      matrix = NULL;
-    } else {
-      std::cout<<"Doing hybrid"<<std::endl;
-      CoinDisjointCopyN(clp.getObjCoefficients(), numCols, obj);
-      cuts.reserve(numRows);
-      const double* rlb = clp.getRowLower();
-      const double* rub = clp.getRowUpper();
-      for (int i = 0; i < numRows; ++i)	{
-	cuts.push_back(new BCP_cut_core(rlb[i], rub[i]));
-      }
-      matrix = new BCP_lp_relax(true /*column major ordered*/);
-      matrix->copyOf(*clp.getMatrixByCol(), obj, clb, cub, rlb, rub);
+    if (bonmin.getAlgorithm() != Bonmin::B_BB /* pure B&B */) {
+      throw BCP_fatal_error("\
+BM_tm: bonminbcp only implements the B-BB algorithm (set bonmin.algorithm B-BB).\n");
     }
+    std::cout<<"Doing branch and bound"<<std::endl;
+    double* obj = new double[numCols];
+    CoinFillN(obj, numCols, 0.0);
+    matrix = NULL;
 
     vars.reserve(numCols);
     for (int i = 0; i < numCols; ++i)	{
@@ -0,0 +1,117 @@
+#!/bin/bash
+# Copyright (C) 2026 Bonmin contributors
+# All Rights Reserved.
+# This file is distributed under the Eclipse Public License.
+#
+# Compare bonminbcp (one tree manager, several local worker processes started
+# through mpirun) with single process B-BB (bonmin) on a set of .nl files.
+#
+# usage: bonminbcp_bench.sh [-w "2 4 8"] [-o bonmin.opt] [-t timelimit] file.nl ...
+#
+# For each instance prints one line with the wallclock time and best objective
+# of bonmin, then for each number of workers the wallclock time of bonminbcp,
+# its speedup over bonmin and its best objective (flagged with a * if it
+# differs from the one of bonmin by more than 1e-6 relative). A last line
+# gives the geometric mean of the speedups and the number of mismatching
+# objectives for each number of workers.
+
+WORKERS="2 4"
+OPTFILE=""
+TIMELIMIT=3600
+BONMIN=${BONMIN:-bonmin}
+BONMINBCP=${BONMINBCP:-bonminbcp}
+MPIRUN=${MPIRUN:-mpirun}
+
+while getopts "w:o:t:" opt ; do
+  case $opt in
+    w) WORKERS="$OPTARG" ;;
+    o) OPTFILE="$OPTARG" ;;
+    t) TIMELIMIT="$OPTARG" ;;
+    *) echo "usage: $0 [-w \"2 4 8\"] [-o bonmin.opt] [-t timelimit] file.nl ..." ; exit 1 ;;
+  esac
+done
+shift $((OPTIND - 1))
+if test $# -eq 0 ; then
+  echo "usage: $0 [-w \"2 4 8\"] [-o bonmin.opt] [-t timelimit] file.nl ..."
+  exit 1
+fi
+
+RUNDIR=`mktemp -d ${TMPDIR:-/tmp}/bonminbcp_bench.XXXXXX`
+trap "rm -rf $RUNDIR" EXIT
+
+# Both codes run B-BB with the same options.
+if test -n "$OPTFILE" ; then
+  grep -v "^ *bonmin.algorithm" "$OPTFILE" > $RUNDIR/bonmin.opt
+fi
+echo "bonmin.algorithm B-BB" >> $RUNDIR/bonmin.opt
+echo "bonmin.time_limit $TIMELIMIT" >> $RUNDIR/bonmin.opt
+
+declare -A sumlog count mismatch
+
+now() {
+  date +%s.%N
+}
+
+elapsed() {
+  awk -v a="$1" -v b="$2" 'BEGIN { printf "%.3f", b - a }'
+}
+
+# same_obj a b: succeeds if both are numbers equal up to 1e-6 relative
+same_obj() {
+  awk -v a="$1" -v b="$2" 'BEGIN {
+    if (a == "" || b == "" || a == "-" || b == "-") exit 1
+    d = a - b ; if (d < 0) d = -d
+    m = (a < 0 ? -a : a) ; if (m < 1) m = 1
+    exit (d <= 1e-6 * m) ? 0 : 1 }'
+}
+
+printf "%-24s %12s %16s" "instance" "bonmin(s)" "obj"
+for w in $WORKERS ; do
+  printf " %12s %8s %17s" "bcp-$w(s)" "speedup" "obj"
+  sumlog[$w]=0 ; count[$w]=0 ; mismatch[$w]=0
+done
+printf "\n"
+
+for f in "$@" ; do
+  nl=`cd \`dirname $f\`; pwd`/`basename $f`
+  name=`basename $f .nl`
+
+  # single process branch-and-bound
+  start=`now`
+  (cd $RUNDIR && $BONMIN "$nl" > $RUNDIR/$name.bonmin.log 2>&1)
+  end=`now`
+  bbtime=`elapsed $start $end`
+  bbobj=`grep "Search completed - best objective" $RUNDIR/$name.bonmin.log | tail -1 | sed -e 's/.*best objective \([^,]*\),.*/\1/'`
+  printf "%-24s %12.2f %16s" "$name" $bbtime "${bbobj:--}"
+
+  # distributed branch-and-bound: 1 tree manager + w workers
+  for w in $WORKERS ; do
+    sed -e "/^BCP_LpProcessNum/d" -e "/^BM_NL_filename/d" -e "/^BM_IpoptParamfile/d" \
+        `dirname $0`/BM.par > $RUNDIR/$name.$w.par
+    echo "BCP_LpProcessNum $w" >> $RUNDIR/$name.$w.par
+    echo "BCP_MaxRunTime $TIMELIMIT" >> $RUNDIR/$name.$w.par
+    echo "BM_NL_filename $nl" >> $RUNDIR/$name.$w.par
+    echo "BM_IpoptParamfile $RUNDIR/bonmin.opt" >> $RUNDIR/$name.$w.par
+    start=`now`
+    (cd $RUNDIR && $MPIRUN -np $((w + 1)) $BONMINBCP $RUNDIR/$name.$w.par > $RUNDIR/$name.bcp$w.log 2>&1)
+    end=`now`
+    bcptime=`elapsed $start $end`
+    speedup=`awk -v a="$bbtime" -v b="$bcptime" 'BEGIN { printf "%.4f", a / b }'`
+    sumlog[$w]=`awk -v s="${sumlog[$w]}" -v r="$speedup" 'BEGIN { print s + log(r) }'`
+    count[$w]=$((count[$w] + 1))
+    obj=`grep "TM: The best solution found has value" $RUNDIR/$name.bcp$w.log | tail -1 | sed -e 's/.*has value //'`
+    flag=" "
+    if ! same_obj "$bbobj" "$obj" ; then
+      flag="*"
+      mismatch[$w]=$((mismatch[$w] + 1))
+    fi
+    printf " %12.2f %8.2f %16s%s" $bcptime $speedup "${obj:--}" "$flag"
+  done
+  printf "\n"
+done
+
+printf "%-24s %12s %16s" "geomean/mismatches" "" ""
+for w in $WORKERS ; do
+  printf " %12s %8.2f %17s" "" `awk -v s="${sumlog[$w]}" -v n="${count[$w]}" 'BEGIN { print exp(s / n) }'` "${mismatch[$w]}"
+done
+printf "\n"
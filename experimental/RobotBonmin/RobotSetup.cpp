@@ -43,7 +43,6 @@ namespace Bonmin
   void RobotSetup::registerAllOptions(Ipopt::SmartPtr<Bonmin::RegisteredOptions> roptions)
   {
      BonminSetup::registerAllOptions(roptions);
-     BonNWayChoose::registerOptions(roptions);
 
 
     roptions->AddLowerBoundedIntegerOption("branch_on_frac_only",
@@ -76,8 +76,8 @@ void initialize(char **& argv)
 
 
   protected:
-    /** Add nway objects*/
-    void addNWays();
+    /** Add nway objects (with consequences given by the SOS weights).*/
+    virtual void addNWays();
     /** Initialize a branch-and-with robot nway.*/
     void initializeRobot();
   };
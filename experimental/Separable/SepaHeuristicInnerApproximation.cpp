@@ -25,7 +25,9 @@
 #include "OsiAuxInfo.hpp"
 
 #include "CoinTime.hpp"
+#include "CoinError.hpp"
 
+#include <algorithm>
 #include <fstream>
 
 #include <iomanip>
@@ -37,8 +39,8 @@
 namespace Sepa{
 
 HeuristicInnerApproximation::HeuristicInnerApproximation(Bonmin::BonminSetup * setup) :
-  CbcHeuristic(), setup_(setup), howOften_(100), mip_(NULL),
-        nbAp_(50), time_limit_(10.) {
+  CbcHeuristic(), setup_(setup), howOften_(0), mip_(NULL),
+        nbAp_(50), time_limit_(10.), modelLoaded_(false) {
   Initialize(setup);
 }
 
@@ -49,7 +51,12 @@ HeuristicInnerApproximation::HeuristicInnerApproximation(
         howOften_(copy.howOften_), 
         mip_(new Bonmin::SubMipSolver(*copy.mip_)),
         nbAp_(copy.nbAp_),
-        time_limit_(copy.time_limit_)
+        time_limit_(copy.time_limit_),
+        modelLoaded_(copy.modelLoaded_),
+        innerRows_(copy.innerRows_),
+        innerVars_(copy.innerVars_),
+        breakpoints_(copy.breakpoints_),
+        secantRows_(copy.secantRows_)
  {
 }
 
@@ -60,7 +67,14 @@ HeuristicInnerApproximation::operator=(const HeuristicInnerApproximation& rhs) {
     setup_ = rhs.setup_;
     howOften_ = rhs.howOften_;
                 nbAp_ = rhs.nbAp_;
+    time_limit_ = rhs.time_limit_;
+    modelLoaded_ = rhs.modelLoaded_;
+    innerRows_ = rhs.innerRows_;
+    innerVars_ = rhs.innerVars_;
+    breakpoints_ = rhs.breakpoints_;
+    secantRows_ = rhs.secantRows_;
     delete mip_;
+    mip_ = NULL;
     if (rhs.mip_)
       mip_ = new Bonmin::SubMipSolver(*rhs.mip_);
   }
@@ -86,6 +100,13 @@ void HeuristicInnerApproximation::registerOptions(Ipopt::SmartPtr<
        "Time limit for inner approximation",
        0, true, 10, "");
  roptions->setOptionExtraInfo("number_inner_approximation_points", 63);
+
+ roptions->AddLowerBoundedIntegerOption("inner_approximation_frequency",
+       "Frequency (in terms of nodes) at which the inner approximation heuristic is run",
+       0, 0,
+       "0 runs it only at the root. The inner approximation is kept between runs "
+       "and refined around the incumbent.");
+ roptions->setOptionExtraInfo("inner_approximation_frequency", 63);
 }
 
 void
@@ -97,6 +118,9 @@ HeuristicInnerApproximation::Initialize(Bonmin::BonminSetup * b) {
        nbAp_, b->prefix());
    b->options()->GetNumericValue("inner_time_limit",
        time_limit_, b->prefix());
+   b->options()->GetIntegerValue("inner_approximation_frequency",
+       howOften_, b->prefix());
+   modelLoaded_ = false;
 }
 
 HeuristicInnerApproximation::~HeuristicInnerApproximation() {
@@ -105,21 +129,24 @@ delete mip_;
 
 /** Returns a feasible solution to the MINLP 
  * The heuristic constructs a MIP based approximating all univariate functions appearing in nonlinear constraints 
- * The linear approximation is obtained by adding inner chords linking pairs of points until covering the range of each variable **/
+ * The linear approximation is obtained by adding inner chords linking pairs of points until covering the range of each variable
+ * The MIP is built at the first call, later calls refine it around the incumbent and restart from the previous solution **/
 int
 HeuristicInnerApproximation::solution(double &solutionValue, double *betterSolution)
 {
-if(model_->getNodeCount() || model_->getCurrentPassNumber() > 1) return 0;
-if ((model_->getNodeCount()%howOften_)!=0||model_->getCurrentPassNumber()>1)
+if(model_->getCurrentPassNumber() > 1) return 0;
+if(howOften_ <= 0 ? model_->getNodeCount() != 0 : (model_->getNodeCount()%howOften_) != 0)
 return 0;
 
 int returnCode = 0; // 0 means it didn't find a feasible solution
 
+// Only evaluations are done with the nlp, no need to copy it.
 Bonmin::OsiTMINLPInterface * nlp = NULL;
 if(setup_->getAlgorithm() == Bonmin::B_BB)
-nlp = dynamic_cast<Bonmin::OsiTMINLPInterface *>(model_->solver()->clone());
+nlp = dynamic_cast<Bonmin::OsiTMINLPInterface *>(model_->solver());
 else
-nlp = dynamic_cast<Bonmin::OsiTMINLPInterface *>(setup_->nonlinearSolver()->clone());
+nlp = setup_->nonlinearSolver();
+assert(nlp);
 
 Bonmin::TMINLP2TNLP* minlp = nlp->problem();
 // set tolerances
@@ -144,29 +171,29 @@ double* new_g_sol = new double [numberRows];
 
 bool feasible = true;
 // load the problem to OSI
-#ifdef DEBUG_BON_HEURISTIC
-std::cout << "Loading the problem to OSI\n";
-#endif
 OsiSolverInterface *si = mip_->solver(); // the MIP solver
-
-bool delete_si = false;
 if(si == NULL) {
-  si = new OsiClpSolverInterface;
-  mip_->setLpSolver(si);
-  delete_si = true;
+  throw CoinError("No MIP solver for the inner approximation.", "solution",
+                  "Sepa::HeuristicInnerApproximation");
 }
-CoinMessageHandler * handler = model_->messageHandler()->clone();
-si->passInMessageHandler(handler);
-si->messageHandler()->setLogLevel(2);
+if(!modelLoaded_) {
 #ifdef DEBUG_BON_HEURISTIC
 std::cout << "Loading problem into si\n";
 #endif
 extractInnerApproximation(*nlp, *si, newSolution, true); // Call the function construncting the inner approximation description 
+modelLoaded_ = true;
+}
+else if(model_->bestSolution()) {
+// Make the inner approximation exact at the incumbent.
+refineInnerApproximation(*nlp, *si, model_->bestSolution());
+}
+// The refined model contains the previous one, its last solution is still feasible.
+mip_->setMipStart(mip_->getLastSolution());
 #ifdef DEBUG_BON_HEURISTIC
 std::cout << "problem loaded\n";
 std::cout << "**** Running optimization ****\n";
 #endif
-mip_->optimize(DBL_MAX, 2, time_limit_); // Optimize the MIP
+mip_->optimize(solutionValue, 2, time_limit_); // Optimize the MIP
 #ifdef DEBUG_BON_HEURISTIC
 std::cout << "Optimization finished\n";
 #endif
@@ -177,11 +204,6 @@ if(mip_->getLastSolution()) { // if the MIP solver returns a feasible solution
   else
   feasible = false;
 
-if(delete_si) {
-  delete si;
-}
-delete handler;
-
 
 #if 0 // Set to 1 if you need to test the feasibility of the returned solution
 const double* x_l = minlp->x_l();
@@ -235,8 +257,6 @@ if(feasible) {
 delete [] newSolution;
 delete [] new_g_sol;
 
-delete nlp;
-
 #ifdef DEBUG_BON_HEURISTIC
 std::cout<<"Inner approximation returnCode = "<<returnCode<<std::endl;
 #endif
@@ -429,8 +449,35 @@ HeuristicInnerApproximation::extractInnerApproximation(Bonmin::OsiTMINLPInterfac
    // Hassan IA initial description
    int InnerDesc = 1;
    if (InnerDesc == 1) {
-     OsiCuts cs;
-   
+     // Constraints depending on a single nonlinear variable keep their
+     // breakpoints to be refined later.
+     innerRows_.clear();
+     innerVars_.clear();
+     Bonmin::vector<int> inner(m);
+     for (int i = 0; i < m; i++) {
+       inner[i] = -1;
+       if (constTypes[i] == Ipopt::TNLP::LINEAR) continue;
+       inner[i] = static_cast<int>(innerRows_.size());
+       innerRows_.push_back(i);
+       innerVars_.push_back(-1);
+     }
+     Bonmin::vector<int> numNonLinearVars(m);
+     for (int i = 0; i < m; i++)
+       numNonLinearVars[i] = 0;
+     for (int k = 0; k < nnz_jac_g; k++) {
+       int i = jRow[k];
+       if (inner[i] < 0 || varTypes[jCol[k]] == Ipopt::TNLP::LINEAR) continue;
+       if (innerVars_[inner[i]] != jCol[k]) {
+         innerVars_[inner[i]] = jCol[k];
+         numNonLinearVars[i]++;
+       }
+     }
+     for (int i = 0; i < m; i++)
+       if (inner[i] >= 0 && numNonLinearVars[i] != 1)
+         innerVars_[inner[i]] = -1;
+     breakpoints_.assign(innerRows_.size(), std::vector<double>());
+     secantRows_.assign(innerRows_.size(), std::vector<int>());
+
      double * p = CoinCopyOfArray(colLower, n);
      double * pp = CoinCopyOfArray(colLower, n);
      double * up = CoinCopyOfArray(colUpper, n);
@@ -462,6 +509,10 @@ HeuristicInnerApproximation::extractInnerApproximation(Bonmin::OsiTMINLPInterfac
        }
      }
      printf("Number of linears %i\n", n_lin);
+
+     for (unsigned int k = 0; k < innerRows_.size(); k++)
+       if (innerVars_[k] >= 0)
+         breakpoints_[k].push_back(p[innerVars_[k]]);
    
      for (int j = 1; j < nbAp; j++) {
    
@@ -469,30 +520,91 @@ HeuristicInnerApproximation::extractInnerApproximation(Bonmin::OsiTMINLPInterfac
          pp[i] += step[i];
        }
    
-       for (int i = 0; (i < m ); i++) {
-         if (constTypes[i] == Ipopt::TNLP::LINEAR) continue;
-         bool status = getMyInnerApproximation(nlp, cs, i, p, pp);// Generate a chord connecting the two points
-         if(status == false){
+       for (unsigned int k = 0; k < innerRows_.size(); k++) {
+         int row = addSecant(nlp, si, innerRows_[k], p, pp);// Generate a chord connecting the two points
+         if(row < 0){
            printf("Error in generating inner approximation\n");
            exit(1);
          }
+         if (innerVars_[k] >= 0) {
+           breakpoints_[k].push_back(pp[innerVars_[k]]);
+           secantRows_[k].push_back(row);
+         }
        }
        std::copy(pp, pp+n, p);
       
      }
    
-     for(int i = 0; (i< m); i++) {
-         if (constTypes[i] == Ipopt::TNLP::LINEAR) continue;
-         getMyInnerApproximation(nlp, cs, i, p, up);// Generate a chord connecting the two points
+     for (unsigned int k = 0; k < innerRows_.size(); k++) {
+         int row = addSecant(nlp, si, innerRows_[k], p, up);// Generate a chord connecting the two points
+         if (innerVars_[k] < 0) continue;
+         if (row < 0) {// The description of this constraint can not be refined.
+           innerVars_[k] = -1;
+           continue;
+         }
+         breakpoints_[k].push_back(up[innerVars_[k]]);
+         secantRows_[k].push_back(row);
      }
 
         delete [] p; 
         delete [] pp;
         delete [] up; 
-     si.applyCuts(cs);
    }
    printf("************  Done extracting inner approx ********");
   }
 
-}
+/** Split the segment containing x of each univariate constraint: its secant is
+ * relaxed (the row is kept so that the basis of the sub-MIP stays valid) and the
+ * two secants through x are added. For a convex function this enlarges the
+ * inner approximation, which becomes exact at x.**/
+void
+HeuristicInnerApproximation::refineInnerApproximation(Bonmin::OsiTMINLPInterface & nlp,
+  OsiSolverInterface &si, const double * x) {
+   int n = nlp.getNumCols();
+   Bonmin::vector<double> p(n, 0.);
+   Bonmin::vector<double> pp(n, 0.);
+   double infty = si.getInfinity();
+   for (unsigned int k = 0; k < innerRows_.size(); k++) {
+     int v = innerVars_[k];
+     if (v < 0) continue;
+     std::vector<double> & bp = breakpoints_[k];
+     double t = x[v];
+     std::vector<double>::iterator it = std::upper_bound(bp.begin(), bp.end(), t);
+     if (it == bp.begin() || it == bp.end()) continue;// outside of the described range
+     int j = static_cast<int>(it - bp.begin()) - 1;
+     double minGap = std::max(1e-06 * (bp.back() - bp.front()), 1e-07);
+     if (t - bp[j] <= minGap || bp[j + 1] - t <= minGap) continue;
+
+     p[v] = bp[j];
+     pp[v] = t;
+     int left = addSecant(nlp, si, innerRows_[k], p(), pp());
+     p[v] = t;
+     pp[v] = bp[j + 1];
+     int right = addSecant(nlp, si, innerRows_[k], p(), pp());
+     p[v] = pp[v] = 0.;
+     if (left < 0 || right < 0) {
+       // Keep the description consistent, relax what was added.
+       if (left >= 0) si.setRowBounds(left, -infty, infty);
+       if (right >= 0) si.setRowBounds(right, -infty, infty);
+       continue;
+     }
+     si.setRowBounds(secantRows_[k][j], -infty, infty);
+     bp.insert(bp.begin() + j + 1, t);
+     secantRows_[k][j] = left;
+     secantRows_[k].insert(secantRows_[k].begin() + j + 1, right);
+   }
+  }
+
+int
+HeuristicInnerApproximation::addSecant(Bonmin::OsiTMINLPInterface & nlp, OsiSolverInterface &si,
+  int ind, const double * x, const double * x2) {
+   OsiCuts cs;
+   if (!getMyInnerApproximation(nlp, cs, ind, x, x2))
+     return -1;
+   const OsiRowCut & cut = cs.rowCut(0);
+   int row = si.getNumRows();
+   si.addRow(cut.row(), cut.lb(), cut.ub());
+   return row;
+  }
 
+}
@@ -14,6 +14,7 @@
 #include "BonBonminSetup.hpp"
 #include "CbcHeuristic.hpp"
 #include "CbcStrategy.hpp"
+#include <vector>
 
 namespace Bonmin {
 class SubMipSolver;
@@ -61,7 +62,7 @@ protected:
 	Bonmin::BonminSetup * setup_;
 
 private:
-	/// How often to do (code can change)
+	/// How often to do (in nodes, 0 only at the root)
 	int howOften_;
 
 	/// A subsolver for MIP
@@ -73,9 +74,34 @@ private:
         /// Time limit for mip
         double time_limit_;
 
+        /// Is the inner approximation loaded in the sub-MIP solver?
+        bool modelLoaded_;
+
+        /// Nonlinear constraints of the nlp described by secants
+        std::vector<int> innerRows_;
+
+        /// Variable of each constraint of innerRows_ if it is univariate (-1 otherwise)
+        std::vector<int> innerVars_;
+
+        /// Sorted breakpoints of each univariate constraint
+        std::vector<std::vector<double> > breakpoints_;
+
+        /// Row of the sub-MIP holding the secant between two consecutive breakpoints
+        std::vector<std::vector<int> > secantRows_;
+
+        /// Load the inner approximation in si (done once, the model is then refined)
         void extractInnerApproximation(Bonmin::OsiTMINLPInterface & nlp, OsiSolverInterface &si,
                                        const double * x, bool getObj);
 
+        /** Refine the inner approximation around x: the secant of the segment
+            containing x is replaced by the two secants through x.*/
+        void refineInnerApproximation(Bonmin::OsiTMINLPInterface & nlp, OsiSolverInterface &si,
+                                      const double * x);
+
+        /// Add the secant of constraint ind between x and x2 to si, returns its row (-1 if none)
+        int addSecant(Bonmin::OsiTMINLPInterface & nlp, OsiSolverInterface &si, int ind,
+                      const double * x, const double * x2);
+
         bool getMyInnerApproximation(Bonmin::OsiTMINLPInterface &si, OsiCuts &cs, int ind,
                 const double * x, const double * x2);
 
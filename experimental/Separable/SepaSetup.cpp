@@ -15,6 +15,7 @@
 #include "SepaTMINLP2OsiLP.hpp"
 #include "SepaHeuristicInnerApproximation.hpp"
 #include "BonOuterDescription.hpp"
+#include "BonOuterDescriptionCuts.hpp"
 
 namespace Sepa
 {
@@ -81,8 +82,10 @@ namespace Sepa
     linearizer_ = linearizer;
     if(do_outer)
       linearizer->set_num_approx(n_approx);
+    refineOuterDescription();
 
     Bonmin::BonminSetup::initialize(tminlp, createContinuousSolver);
+    feedOuterDescription();
 
     if (getAlgorithm() == Bonmin::B_OA)
       initializeSepa();
@@ -101,12 +104,43 @@ namespace Sepa
     linearizer_ = linearizer;
     if(do_outer)
       linearizer->set_num_approx(n_approx);
+    refineOuterDescription();
     
     BonminSetup::initialize(nlpSi, createContinuousSolver);
+    feedOuterDescription();
     if (getAlgorithm() == Bonmin::B_OA)
       initializeSepa();
   }
 
+  void SepaSetup::refineOuterDescription()
+  {
+    int frequency;
+    if (!options()->GetIntegerValue("outer_description_cuts", frequency, prefix_.c_str())) {
+      std::string o_name = prefix_ + "outer_description_cuts";
+      options()->SetIntegerValue(o_name.c_str(), 1, true, true);
+    }
+  }
+
+  void SepaSetup::feedOuterDescription()
+  {
+    Bonmin::OuterDescriptionCuts * outer = NULL;
+    for (CuttingMethods::iterator i = cutGenerators_.begin() ;
+         i != cutGenerators_.end() && outer == NULL ; i++)
+      outer = dynamic_cast<Bonmin::OuterDescriptionCuts *>(i->cgl);
+    if (outer == NULL || nonlinearSolver() == NULL)
+      return;
+    SepaTMINLP2OsiLP * linearizer =
+      dynamic_cast<SepaTMINLP2OsiLP *>(GetRawPtr(nonlinearSolver()->linearizer()));
+    if (linearizer == NULL)
+      return;
+    std::vector<std::vector<double> > points;
+    linearizer->refined_oa_points(points);
+    const std::vector<int> & rows = outer->nonLinearRows();
+    for (unsigned int k = 0 ; k < points.size() ; k++)
+      for (unsigned int j = 0 ; j < rows.size() ; j++)
+        outer->addBreakpoint(rows[j], &points[k][0]);
+  }
+
   void SepaSetup::initializeSepa()
   {
 
@@ -78,6 +78,13 @@ void initialize(char **& argv)
   protected:
     /** Initialize a branch-and-cut with some OA.*/
     void initializeSepa();
+    /** Refine the initial outer description during the search by default
+        (tangents are added where the LP solution violates it the most),
+        unless outer_description_cuts is set by the user.*/
+    void refineOuterDescription();
+    /** Record the points of the initial outer description as breakpoints
+        of the outer description cut generator.*/
+    void feedOuterDescription();
   };
 }/** end namespace Bonmin*/
 
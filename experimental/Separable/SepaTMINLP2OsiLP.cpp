@@ -346,7 +346,8 @@ SepaTMINLP2OsiLP::get_oa(int rowIdx, OsiCuts &cs, const double *x, bool getObj,
 }
 
 void 
-SepaTMINLP2OsiLP::get_refined_oa(OsiCuts & cs) const{
+SepaTMINLP2OsiLP::refined_oa_points(std::vector<std::vector<double> > & points) const{
+   points.clear();
    if(num_approx_ <= 0)
      return;
    int n;
@@ -357,26 +358,22 @@ SepaTMINLP2OsiLP::get_refined_oa(OsiCuts & cs) const{
    //Get problem information
    model_->get_nlp_info(n, m, nnz_jac_g, nnz_h_lag, index_style);
 
-  //const double * rowLower = model_->g_l();
-  //const double * rowUpper = model_->g_u();
   const double * colLower = model_->x_l();
   const double * colUpper = model_->x_u();
   Bonmin::vector<Ipopt::TNLP::LinearityType>  varTypes(n);
 
    model_->get_variables_linearity(n, varTypes());
-   //const Bonmin::TMINLP::VariableType* variableType = model_->var_types();
    // Hassan OA initial description
 
-   double * p = CoinCopyOfArray(colLower, n);
-   double * pp = CoinCopyOfArray(colLower, n);
-   double * up = CoinCopyOfArray(colUpper, n);
+   std::vector<double> p(colLower, colLower + n);
+   std::vector<double> up(colUpper, colUpper + n);
 
    std::vector<double> step(n);
 
 
      for (int i = 0; i < n; i++) {
        if (p[i] < -1e4){
-          p[i] = pp[i] = -1e4;
+          p[i] = -1e4;
        }
        if (up[i] > 1e4){
           up[i] = 1e4;
@@ -389,28 +386,29 @@ SepaTMINLP2OsiLP::get_refined_oa(OsiCuts & cs) const{
 
       if (varTypes[i] == Ipopt::TNLP::LINEAR) {
          step[i] = 0;
-         p[i] = pp[i] = up[i] = 0;
+         p[i] = up[i] = 0;
       }
       else
         step[i] = (up[i] - p[i]) / (num_approx_);
 
     }
-    get_oas(cs, p, 0, true);// Generate Tangents at current point        
+    points.push_back(p);
     for (int j = 1; j <= num_approx_; j++) {
 
       for (int i = 0; i < n; i++) {
-        pp[i] += step[i];
+        p[i] += step[i];
       }
-      
-      get_oas(cs, pp, 0, true);// Generate Tangents at current point
-
+      points.push_back(p);
    }
+   points.push_back(up);
+  }
 
-   get_oas(cs, up, 0, true);// Generate Tangents at current point
-      
-   delete [] p;
-   delete [] pp;
-   delete [] up;
+void 
+SepaTMINLP2OsiLP::get_refined_oa(OsiCuts & cs) const{
+   std::vector<std::vector<double> > points;
+   refined_oa_points(points);
+   for (unsigned int k = 0; k < points.size(); k++)
+     get_oas(cs, &points[k][0], 0, true);// Generate Tangents at the point
   }
 
 void 
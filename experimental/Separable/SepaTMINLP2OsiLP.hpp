@@ -11,6 +11,7 @@
 
 #include <cmath>
 #include <cstdio>
+#include <vector>
 #include "IpSmartPtr.hpp"
 #include "IpTNLP.hpp"
 #include "BonTypes.hpp"
@@ -65,6 +66,8 @@ namespace Sepa {
                 const double * x, bool getObj, bool global) const;
 
    virtual void get_refined_oa(OsiCuts & cs) const;
+   /** Points at which get_refined_oa linearizes the constraints.*/
+   void refined_oa_points(std::vector<std::vector<double> > & points) const;
    /** Get OA of one constraints in x.*/
    virtual void get_oa(int iRow, OsiCuts & cs, 
                 const double * x, bool getObj, bool global) const;
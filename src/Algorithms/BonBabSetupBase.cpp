@@ -12,9 +12,12 @@
 # include "BonFilterSolver.hpp"
 #endif
 #include "BonBabSetupBase.hpp"
+#include <atomic>
 #include <climits>
 #include <fstream>
+#include <map>
 #include <sstream>
+#include <typeindex>
 
 #include "BonDiver.hpp"
 #include "BonQpBranchingSolver.hpp"
@@ -246,7 +249,11 @@ namespace Bonmin
   {
     readOptionsFile();
     assert(IsValid(tminlp));
-    nonlinearSolver_ = new OsiTMINLPInterface;
+    bool reset = nonlinearSolver_ != NULL;
+    if (reset)
+      freeMethods();
+    else
+      nonlinearSolver_ = new OsiTMINLPInterface;
     int ival;
     options_->GetEnumValue("enable_dynamic_nlp", ival, "bonmin.");
     if(ival && ! tminlp->hasLinearObjective()){
@@ -255,7 +262,10 @@ namespace Bonmin
       linObj->setTminlp(GetRawPtr(tminlp));
       tminlp = GetRawPtr(linObj);
     }
-    nonlinearSolver_->initialize(roptions_, options_, journalist_, prefix(), tminlp);
+    if (reset)
+      nonlinearSolver_->resetModel(tminlp);
+    else
+      nonlinearSolver_->initialize(roptions_, options_, journalist_, prefix(), tminlp);
     if(messageHandler_ != NULL)
       nonlinearSolver_->passInMessageHandler(messageHandler_);
     else
@@ -323,26 +333,37 @@ namespace Bonmin
 
   BabSetupBase::~BabSetupBase()
   {
-    if (nonlinearSolver_ != continuousSolver_) {
-      delete nonlinearSolver_;
+    freeMethods();
+    delete nonlinearSolver_;
+
+    if(messageHandler_)
+      delete messageHandler_;
+  }
+
+  void
+  BabSetupBase::freeMethods()
+  {
+    if (continuousSolver_ != nonlinearSolver_) {
+      delete continuousSolver_;
     }
-    delete continuousSolver_;
+    continuousSolver_ = NULL;
     delete branchingMethod_;
+    branchingMethod_ = NULL;
     for (CuttingMethods::iterator i = cutGenerators_.begin() ; i != cutGenerators_.end() ; i++) {
       delete i->cgl;
       i->cgl = NULL;
     }
+    cutGenerators_.clear();
 
     for (HeuristicMethods::iterator i = heuristics_.begin() ; i != heuristics_.end() ; i++) {
       delete i->heuristic;
     }
+    heuristics_.clear();
 
     for (unsigned int i = 0 ; i < objects_.size() ; i++) {
       delete objects_[i];
     }
-
-    if(messageHandler_)
-      delete messageHandler_;
+    objects_.clear();
   }
 
 
@@ -475,6 +496,77 @@ namespace Bonmin
         "value 0 deactivates option");
     roptions->setOptionExtraInfo("solution_limit", 127);
 
+    roptions->AddLowerBoundedIntegerOption("solution_pool_size",
+        "Number of best distinct solutions kept to seed primal heuristics.",
+        0,5,
+        "Heuristics based on a neighborhood of the incumbent (RINS, local branching) "
+        "and the feasibility pump start from these points in turn. "
+        "As many integer feasible solutions of OA master problems are also kept.");
+    roptions->setOptionExtraInfo("solution_pool_size", 127);
+
+    roptions->AddStringOption1("checkpoint_file",
+        "File to which the state of the branch-and-bound is periodically saved.",
+        "", "*", "Any acceptable file name",
+        "The incumbent, the open nodes, the pseudo costs and the globally valid cuts are written "
+        "every checkpoint_interval seconds by a background thread. "
+        "An empty name disables checkpointing.");
+    roptions->setOptionExtraInfo("checkpoint_file", 127);
+
+    roptions->AddLowerBoundedNumberOption("checkpoint_interval",
+        "Wallclock time (in secs) between two checkpoints of the branch-and-bound.",
+        0.,0,600.,
+        "");
+    roptions->setOptionExtraInfo("checkpoint_interval", 127);
+
+    roptions->AddStringOption2("checkpoint_restart",
+        "Resume the branch-and-bound from the checkpoint in checkpoint_file.",
+        "no",
+        "no", "",
+        "yes", "",
+        "The incumbent, the pseudo costs and the cuts of the checkpoint are restored "
+        "and the open nodes which can still improve the incumbent are searched in turn, "
+        "best bound first, from their bounds and warm starts.");
+    roptions->setOptionExtraInfo("checkpoint_restart", 127);
+
+    roptions->AddLowerBoundedNumberOption("tree_memory_limit",
+        "Bound (in MB) on the memory taken by the open nodes of the branch-and-bound.",
+        0., false, 0.,
+        "When the estimated memory of the tree exceeds the bound, the warm starts of the "
+        "open nodes with the worst bounds are moved to tree_spill_file and read back when needed; "
+        "if this is not enough the search switches to depth first. "
+        "0 means no bound.");
+    roptions->setOptionExtraInfo("tree_memory_limit", 127);
+
+    roptions->AddStringOption1("tree_spill_file",
+        "File to which the warm starts of open nodes are moved when tree_memory_limit is reached.",
+        "bonmin_tree.spill",
+        "*", "Any acceptable file name",
+        "The file is removed at the end of the branch-and-bound.");
+    roptions->setOptionExtraInfo("tree_spill_file", 127);
+
+    roptions->AddStringOption3("profile_format",
+        "Profile the time spent in the main components of the algorithm.",
+        "none",
+        "none", "no profiling",
+        "text", "print a table",
+        "json", "print a JSON object (one per report, on one line)",
+        "Counts the calls to and measures the wallclock time spent in NLP solves, outer approximation, "
+        "strong branching, heuristics, sub-MILPs, copies of the NLP solver and evaluations of the functions "
+        "of the problem, and reports them at the end of the branch-and-bound.");
+    roptions->setOptionExtraInfo("profile_format", 127);
+
+    roptions->AddStringOption1("profile_file",
+        "File to which the profile is written.",
+        "", "*", "Any acceptable file name",
+        "An empty name (or a file which can not be opened) writes the profile to the standard output.");
+    roptions->setOptionExtraInfo("profile_file", 127);
+
+    roptions->AddLowerBoundedNumberOption("profile_interval",
+        "Wallclock time (in secs) between two reports of the profile during the branch-and-bound.",
+        0., false, 0.,
+        "0 means only one report at the end.");
+    roptions->setOptionExtraInfo("profile_interval", 127);
+
     roptions->AddLowerBoundedNumberOption("integer_tolerance",
         "Set integer tolerance.",
         0.,1,1e-06,
@@ -643,6 +735,21 @@ namespace Bonmin
   }
 
 
+  /** Registered options of each class of setup, built once per thread (the
+      reference counts of Ipopt's SmartPtr are not atomic, the setups of two
+      threads can not hold the same registered options).*/
+  static thread_local std::map<std::type_index, Ipopt::SmartPtr<Bonmin::RegisteredOptions> > registeredOptions;
+  /** Are the registered options shared? Not by default: a program adding
+      its own options to roptions() after initializing each setup would
+      register them twice.*/
+  static std::atomic<bool> sharingRegisteredOptions(false);
+
+  void
+  BabSetupBase::shareRegisteredOptions(bool share)
+  {
+    sharingRegisteredOptions.store(share);
+  }
+
   /** Initialize the options and the journalist.*/
   void
   BabSetupBase::initializeOptionsAndJournalist()
@@ -650,7 +757,19 @@ namespace Bonmin
     options_ = new Ipopt::OptionsList();
 
     journalist_= new Ipopt::Journalist();
-    roptions_ = new Bonmin::RegisteredOptions();
+    bool registered = false;
+    if (sharingRegisteredOptions.load()) {
+      Ipopt::SmartPtr<Bonmin::RegisteredOptions> & shared = registeredOptions[typeid(*this)];
+      if (IsNull(shared)) {
+        roptions_ = new Bonmin::RegisteredOptions();
+        registerOptions();
+        shared = roptions_;
+      }
+      roptions_ = shared;
+      registered = true;
+    }
+    else
+      roptions_ = new Bonmin::RegisteredOptions();
 
     try {
       Ipopt::SmartPtr<Ipopt::Journal> stdout_journal =
@@ -675,7 +794,8 @@ namespace Bonmin
     }
 #endif
 
-    registerOptions();
+    if (!registered)
+      registerOptions();
   }
 
   /** Get the options from given fileName */
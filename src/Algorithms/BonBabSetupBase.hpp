@@ -167,7 +167,11 @@ namespace Bonmin
     /** @{ */
     /** use existing TMINLP interface (containing the options).*/
     void use(const OsiTMINLPInterface& nlp);
-    /** Read options (if not done before) and create interface using tminlp.*/
+    /** Read options (if not done before) and create interface using tminlp.
+        If the setup already has an interface (it was used for another
+        model), the methods built for the previous model (see freeMethods)
+        are freed and the interface is reset with tminlp, keeping its NLP
+        solver (see OsiTMINLPInterface::resetModel).*/
     void use(Ipopt::SmartPtr<TMINLP> tminlp );
     /** use specific instanciation of a TMINLP2TNLP.*/
     void use(Ipopt::SmartPtr<TMINLP2TNLP> prob);
@@ -223,8 +227,19 @@ namespace Bonmin
       journalist_ = journalist;
     }
 
-    /** Initialize the options and the journalist.*/
+    /** Initialize the options and the journalist.
+        The registered options are built by registerOptions. If sharing is
+        on (see shareRegisteredOptions) they are built once per thread for
+        each class of setup and shared by all its instances and their
+        clones; options added to roptions() are then seen by the instances
+        initialized later and have to be registered only once. A setup
+        (and its clones) must then be used and destroyed by the thread that
+        initialized it.*/
     void initializeOptionsAndJournalist();
+
+    /** Share or not (the default) the registered options between the
+        setups initialized from now on.*/
+    static void shareRegisteredOptions(bool share);
     /** @} */
 
     /** @name Elements of the branch-and-bound setup.*/
@@ -332,6 +347,9 @@ namespace Bonmin
     }
 
   protected:
+    /** Free the continuous solver, the branching method, the cut
+        generators, the heuristics and the objects.*/
+    void freeMethods();
     /** Set the priorities into OsiTMINLPInterface when needed.*/
     void setPriorities();
     /** Add SOS constraints to OsiTMINLPInterface when needed.*/
@@ -16,6 +16,8 @@
 #endif
 #include "BonChooseVariable.hpp"
 #include "BonRandomChoice.hpp"
+#include "BonNWayObject.hpp"
+#include "BonNWayChoose.hpp"
 #include "BonDiver.hpp"
 #include "BonQpBranchingSolver.hpp"
 #include "BonLpBranchingSolver.hpp"
@@ -27,6 +29,7 @@
 #include "BonOaFeasChecker.hpp"
 #include "BonOaNlpOptim.hpp"
 #include "BonEcpCuts.hpp"
+#include "BonOuterDescriptionCuts.hpp"
 
 #include "BonCbcNode.hpp"
 #ifdef BONMIN_HAS_FILTERSQP
@@ -110,12 +113,15 @@ namespace Bonmin
     OaFeasibilityChecker::registerOptions(roptions);
     MinlpFeasPump::registerOptions(roptions);
     EcpCuts::registerOptions(roptions);
+    OuterDescriptionCuts::registerOptions(roptions);
     OaNlpOptim::registerOptions(roptions);
     SubMipSolver::registerOptions(roptions);
 
 
     BonCbcFullNodeInfo::registerOptions(roptions);
 
+    BonNWayChoose::registerOptions(roptions);
+
 
     registerMilpCutGenerators(roptions);
 
@@ -421,7 +427,17 @@ namespace Bonmin
       varSelection = NLP_STRONG_BRANCHING;
     }
 
-    switch (varSelection) {
+    int sosBranching;
+    options_->GetEnumValue("sos_branching",sosBranching,prefix_.c_str());
+    if (sosBranching) {
+      continuousSolver_->findIntegersAndSOS(false);
+      setPriorities();
+      addNWays();
+      Ipopt::SmartPtr<StrongBranchingSolver> strong_solver = NULL;
+      nonlinearSolver_->SetStrongBrachingSolver(strong_solver);
+      branchingMethod_ = new BonNWayChoose(*this, nonlinearSolver_);
+    }
+    else switch (varSelection) {
 #ifdef BONMIN_CURVATURE_BRANCHING
     case CURVATURE_ESTIMATOR:
 #endif
@@ -758,6 +774,16 @@ namespace Bonmin
       cutGenerators_.push_back(cg);
     }
 
+    options_->GetIntegerValue("outer_description_cuts",ival, prefix_.c_str());
+    if (ival != 0) {
+      CuttingMethod cg;
+      cg.frequency = ival;
+      OuterDescriptionCuts * outer = new OuterDescriptionCuts(*this);
+      cg.cgl = outer;
+      cg.id = "Outer description cuts";
+      cutGenerators_.push_back(cg);
+    }
+
     if (algo == B_Hyb || algo == B_Ecp)
       addMilpCutGenerators();
 
@@ -904,6 +930,47 @@ namespace Bonmin
   }
 
 
+  void
+  BonminSetup::addNWays()
+  {
+    const TMINLP::SosInfo * sos = nonlinearSolver()->model()->sosConstraints();
+    int numSos = (!getIntParameter(BabSetupBase::DisableSos) && sos) ? sos->num : 0;
+
+    // BonNWayChoose only branches on nway objects.
+    int numCols = nonlinearSolver()->getNumCols();
+    std::vector<bool> inSos(numCols, false);
+    for (int i = 0 ; i < numSos ; i++) {
+      if (sos->types[i] != 1)
+        throw CoinError("sos_branching nway only handles SOS of type 1.",
+                        "addNWays", "BonminSetup");
+      for (int j = sos->starts[i] ; j < sos->starts[i + 1] ; j++)
+        inSos[sos->indices[j]] = true;
+    }
+    for (int i = 0 ; i < numCols ; i++) {
+      if (nonlinearSolver()->isInteger(i) && !inSos[i])
+        throw CoinError("sos_branching nway needs every integer variable to be in an SOS constraint.",
+                        "addNWays", "BonminSetup");
+    }
+
+    if (numSos == 0)
+      return;
+    const int * sosPriorities = sos->priorities;
+    OsiObject ** objects = new OsiObject*[numSos];
+    for (int i = 0 ; i < numSos ; i++) {
+      int start = sos->starts[i];
+      int length = sos->starts[i + 1] - start;
+      objects[i] = new BonNWayObject(length, &sos->indices[start], i);
+      objects[i]->setPriority(1);
+      if (sosPriorities && sosPriorities[i]) {
+        objects[i]->setPriority(sosPriorities[i]);
+      }
+    }
+    nonlinearSolver()->addObjects(numSos, objects);
+    for (int i = 0 ; i < numSos ; i++)
+      delete objects[i];
+    delete [] objects;
+  }
+
   Algorithm BonminSetup::getAlgorithm()
   {
     if (algo_ != Dummy)
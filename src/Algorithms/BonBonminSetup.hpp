@@ -86,6 +86,9 @@ namespace Bonmin
     void initializeBBB();
     /** Initialize a branch-and-cut with some OA.*/
     void initializeBHyb(bool createContinuousSolver = false);
+    /** Add one BonNWayObject for each SOS constraint of the problem (used
+        with sos_branching nway).*/
+    virtual void addNWays();
   private:
     Algorithm algo_;
   };
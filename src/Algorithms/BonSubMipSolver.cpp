@@ -13,10 +13,15 @@
 #include "BonminConfig.h"
 #include "CbcModel.hpp"
 #include "CbcStrategy.hpp"
+#include "CbcEventHandler.hpp"
+#include "CbcCompareActual.hpp"
 #include "OsiAuxInfo.hpp"
 #include "OsiClpSolverInterface.hpp"
 
 #include <climits>
+#include <algorithm>
+#include <atomic>
+#include <thread>
 
 // if we use OsiCpx, then we also need to get access to Cplex directly
 // so disable OsiCpx if no Cplex
@@ -36,6 +41,7 @@ throw CoinError(s,f,func);
 
 #include "BonRegisteredOptions.hpp"
 #include "BonBabSetupBase.hpp"
+#include "BonProfiler.hpp"
 #include "BonCbcLpStrategy.hpp"
 
 
@@ -48,7 +54,11 @@ namespace Bonmin {
       optimal_(false),
       integerSolution_(NULL),
       strategy_(NULL),
-      ownClp_(false)
+      ownClp_(false),
+      portfolioSize_(1),
+      poolSolutions_(),
+      poolObjectives_(),
+      mipStart_()
   {
 
    int logLevel;
@@ -100,6 +110,8 @@ namespace Bonmin {
 
       b.options()->GetNumericValue("allowable_fraction_gap", gap_tol_, prefix);
 
+      b.options()->GetIntegerValue("milp_portfolio_size", portfolioSize_, prefix);
+
 
   }
   SubMipSolver::SubMipSolver(const SubMipSolver &copy):
@@ -111,7 +123,11 @@ namespace Bonmin {
       strategy_(NULL),
       milp_strat_(copy.milp_strat_),
       gap_tol_(copy.gap_tol_),
-      ownClp_(copy.ownClp_)
+      ownClp_(copy.ownClp_),
+      portfolioSize_(copy.portfolioSize_),
+      poolSolutions_(),
+      poolObjectives_(),
+      mipStart_(copy.mipStart_)
   {
 #ifdef BONMIN_HAS_OSICPX
      if(copy.cpx_ != NULL){
@@ -174,6 +190,31 @@ namespace Bonmin {
       delete [] integerSolution_;
       integerSolution_ = NULL;
     }
+    clearPool();
+    mipStart_.clear();
+  }
+
+  void
+  SubMipSolver::setMipStart(const double * x)
+  {
+    OsiSolverInterface * lp = solver();
+    if (x == NULL || lp == NULL)
+      mipStart_.clear();
+    else
+      mipStart_.assign(x, x + lp->getNumCols());
+  }
+
+  void
+  SubMipSolver::passMipStart(CbcModel & cbc) const
+  {
+    if (mipStart_.empty() || clp_ == NULL ||
+        static_cast<int>(mipStart_.size()) != clp_->getNumCols())
+      return;
+    // Cbc identifies the columns of a start by their names.
+    std::vector< std::pair<std::string, double> > start(mipStart_.size());
+    for (unsigned int i = 0 ; i < mipStart_.size() ; i++)
+      start[i] = std::make_pair(clp_->getColName(i), mipStart_[i]);
+    cbc.setMIPStart(start);
   }
 
   OsiSolverInterface * 
@@ -190,8 +231,12 @@ namespace Bonmin {
 
  void 
  SubMipSolver::find_good_sol(double cutoff, int loglevel, double max_time){
+     ProfileTimer timer(Profiler::SubMip);
 
-     if(clp_){
+     if(clp_ && portfolioSize_ > 1){
+       solveCbcPortfolio(cutoff, loglevel, max_time, true);
+     }
+     else if(clp_){
       CbcStrategyDefault * strat_default = NULL;
       if (!strategy_){
         strat_default = new CbcStrategyDefault(1,5,5, loglevel);
@@ -214,6 +259,7 @@ namespace Bonmin {
       cbc.setMaximumSeconds(max_time);
       cbc.setMaximumSolutions(1);
       cbc.setCutoff(cutoff);
+      passMipStart(cbc);
 
       
       cbc.branchAndBound();
@@ -223,10 +269,12 @@ namespace Bonmin {
         optimal_ = true;
       else optimal_ = false;
 
+      clearPool();
       if (cbc.getSolutionCount()) {
         if (!integerSolution_)
           integerSolution_ = new double[clp_->getNumCols()];
         CoinCopyN(cbc.bestSolution(), clp_->getNumCols(), integerSolution_);
+        addToPool(integerSolution_, cbc.getObjValue());
       }
       else if (integerSolution_) {
         delete [] integerSolution_;
@@ -326,7 +374,11 @@ namespace Bonmin {
   void
   SubMipSolver::optimize(double cutoff, int loglevel, double maxTime)
   {
-    if (clp_) {
+    ProfileTimer timer(Profiler::SubMip);
+    if (clp_ && portfolioSize_ > 1) {
+      solveCbcPortfolio(cutoff, loglevel, maxTime, false);
+    }
+    else if (clp_) {
       assert(strategy_);
       CbcStrategyDefault * strat_default = dynamic_cast<CbcStrategyDefault *>(strategy_->clone());
       assert(strat_default);
@@ -347,6 +399,7 @@ namespace Bonmin {
       cbc.solver()->messageHandler()->setLogLevel(0);
       cbc.setMaximumSeconds(maxTime);
       cbc.setCutoff(cutoff);
+      passMipStart(cbc);
       cbc.setDblParam( CbcModel::CbcAllowableFractionGap, gap_tol_);
 
       //cbc.solver()->writeMpsNative("FP.mps", NULL, NULL, 1);
@@ -357,10 +410,12 @@ namespace Bonmin {
         optimal_ = true;
       else optimal_ = false;
 
+      clearPool();
       if (cbc.getSolutionCount()) {
         if (!integerSolution_)
           integerSolution_ = new double[clp_->getNumCols()];
         CoinCopyN(cbc.bestSolution(), clp_->getNumCols(), integerSolution_);
+        addToPool(integerSolution_, cbc.getObjValue());
       }
       else if (integerSolution_) {
         delete [] integerSolution_;
@@ -544,6 +599,187 @@ namespace Bonmin {
       }
 }
 
+  /** Stops the runs of a portfolio once one of them has finished.*/
+  class PortfolioEventHandler : public CbcEventHandler
+  {
+  public:
+    PortfolioEventHandler(std::atomic<bool> * stop):
+        CbcEventHandler(),
+        stop_(stop)
+    {}
+
+    PortfolioEventHandler(const PortfolioEventHandler & other):
+        CbcEventHandler(other),
+        stop_(other.stop_)
+    {}
+
+    virtual CbcEventHandler * clone() const
+    {
+      return new PortfolioEventHandler(*this);
+    }
+
+    virtual CbcAction event(CbcEvent whichEvent)
+    {
+      if ((whichEvent == node || whichEvent == treeStatus) && stop_->load())
+        return stop;
+      return noAction;
+    }
+
+  private:
+    /** Set when a run of the portfolio has finished.*/
+    std::atomic<bool> * stop_;
+  };
+
+  /** Run member k of a portfolio, stop all the others if it finishes first.*/
+  static void
+  runPortfolioMember(CbcModel * cbc, int k, bool findGoodSol,
+                     std::atomic<bool> * stop, std::atomic<int> * winner)
+  {
+    cbc->branchAndBound();
+    bool finished = cbc->isProvenOptimal() || cbc->isProvenInfeasible() ||
+                    (findGoodSol && cbc->getSolutionCount() > 0);
+    int none = -1;
+    if (finished && winner->compare_exchange_strong(none, k))
+      stop->store(true);
+  }
+
+  /** Maximum number of solutions kept by each run of a portfolio.*/
+  static const int maxSavedSolutions = 10;
+
+  void
+  SubMipSolver::solveCbcPortfolio(double cutoff, int loglevel, double maxTime,
+                                  bool findGoodSol)
+  {
+    CbcStrategyDefault * strat_default = NULL;
+    if (findGoodSol && !strategy_) {
+      strat_default = new CbcStrategyDefault(1,5,5, loglevel);
+      strat_default->setupPreProcessing();
+    }
+    const CbcStrategy & strategy = (strat_default != NULL) ?
+      *strat_default : *strategy_;
+
+    clp_->resolve();
+
+    // Run k differs from run 0 by its random seed and its node selection
+    // (depth first, best bound or Cbc's default in turn).
+    std::atomic<bool> stop(false);
+    std::atomic<int> winner(-1);
+    PortfolioEventHandler handler(&stop);
+    OsiBabSolver empty;
+    std::vector<CbcModel *> runs(portfolioSize_);
+    for (int k = 0 ; k < portfolioSize_ ; k++) {
+      CbcModel * cbc = new CbcModel(*clp_);
+      cbc->solver()->setAuxiliaryInfo(&empty);
+
+      //Change Cbc messages prefixes
+      strcpy(cbc->messagesPointer()->source_,"OCbc");
+
+      cbc->setStrategy(strategy);
+      cbc->setLogLevel(k == 0 ? loglevel : 0);
+      cbc->solver()->messageHandler()->setLogLevel(0);
+      cbc->setMaximumSeconds(maxTime);
+      // Runs share the process, cpu time would go k times too fast.
+      cbc->setUseElapsedTime(true);
+      cbc->setCutoff(cutoff);
+      passMipStart(*cbc);
+      if (findGoodSol)
+        cbc->setMaximumSolutions(1);
+      else
+        cbc->setDblParam(CbcModel::CbcAllowableFractionGap, gap_tol_);
+      cbc->setMaximumSavedSolutions(maxSavedSolutions);
+      cbc->passInEventHandler(&handler);
+      if (k > 0) {
+        cbc->setRandomSeed(cbc->getRandomSeed() + 7919 * k);
+        if (k % 3 == 1) {
+          CbcCompareDepth compare;
+          cbc->setNodeComparison(compare);
+        }
+        else if (k % 3 == 2) {
+          CbcCompareObjective compare;
+          cbc->setNodeComparison(compare);
+        }
+      }
+      runs[k] = cbc;
+    }
+
+    std::vector<std::thread> threads;
+    for (int k = 1 ; k < portfolioSize_ ; k++) {
+      threads.push_back(std::thread(runPortfolioMember, runs[k], k, findGoodSol,
+                                    &stop, &winner));
+    }
+    runPortfolioMember(runs[0], 0, findGoodSol, &stop, &winner);
+    for (unsigned int i = 0 ; i < threads.size() ; i++) {
+      threads[i].join();
+    }
+
+    // Take the run which has finished first, otherwise the best solution found.
+    int best = winner.load();
+    optimal_ = best >= 0 &&
+               (runs[best]->isProvenOptimal() || runs[best]->isProvenInfeasible());
+    if (best < 0) {
+      for (int k = 0 ; k < portfolioSize_ ; k++) {
+        if (runs[k]->getSolutionCount() &&
+            (best < 0 || runs[k]->getObjValue() < runs[best]->getObjValue()))
+          best = k;
+      }
+    }
+
+    // All runs solve the same problem, their bounds are all valid.
+    lowBound_ = optimal_ ? runs[best]->getBestPossibleObjValue() : -COIN_DBL_MAX;
+    nodeCount_ = 0;
+    iterationCount_ = 0;
+    clearPool();
+    int n = clp_->getNumCols();
+    for (int k = 0 ; k < portfolioSize_ ; k++) {
+      CbcModel * cbc = runs[k];
+      if (!optimal_)
+        lowBound_ = std::max(lowBound_, cbc->getBestPossibleObjValue());
+      nodeCount_ += cbc->getNodeCount();
+      iterationCount_ += cbc->getIterationCount();
+      if (cbc->getSolutionCount())
+        addToPool(cbc->bestSolution(), cbc->getObjValue());
+      for (int i = 0 ; i < cbc->numberSavedSolutions() ; i++)
+        addToPool(cbc->savedSolution(i), cbc->savedSolutionObjective(i));
+    }
+
+    if (best >= 0 && runs[best]->getSolutionCount()) {
+      if (!integerSolution_)
+        integerSolution_ = new double[n];
+      CoinCopyN(runs[best]->bestSolution(), n, integerSolution_);
+    }
+    else if (integerSolution_) {
+      delete [] integerSolution_;
+      integerSolution_ = NULL;
+    }
+
+    for (int k = 0 ; k < portfolioSize_ ; k++)
+      delete runs[k];
+    if (strat_default != NULL)
+      delete strat_default;
+  }
+
+  void
+  SubMipSolver::clearPool()
+  {
+    poolSolutions_.clear();
+    poolObjectives_.clear();
+  }
+
+  void
+  SubMipSolver::addToPool(const double * x, double obj)
+  {
+    int n = clp_->getNumCols();
+    unsigned int pos = static_cast<unsigned int>(
+        std::lower_bound(poolObjectives_.begin(), poolObjectives_.end(), obj) -
+        poolObjectives_.begin());
+    for (unsigned int i = 0 ; i < poolSolutions_.size() ; i++) {
+      if (std::equal(x, x + n, poolSolutions_[i].begin()))
+        return;
+    }
+    poolObjectives_.insert(poolObjectives_.begin() + pos, obj);
+    poolSolutions_.insert(poolSolutions_.begin() + pos, std::vector<double>(x, x + n));
+  }
+
    /** Assign a strategy. */
    void 
    SubMipSolver::setStrategy(CbcStrategyDefault * strategy)
@@ -590,6 +826,14 @@ namespace Bonmin {
         "");
     roptions->setOptionExtraInfo("milp_strategy",64);
 
+    roptions->AddLowerBoundedIntegerOption("milp_portfolio_size",
+        "Number of diversified Cbc runs made at the same time to solve MILPs.",
+        1, 1,
+        "Each run works on its own copy of the MILP with a different random seed and node selection. "
+        "The result of the first run to finish is taken (or the best solution found by all runs when time runs out) "
+        "and the solutions found by all runs are merged. Only used when milp_solver is Cbc_D or Cbc_Par.");
+    roptions->setOptionExtraInfo("milp_portfolio_size",64);
+
     roptions->SetRegisteringCategory("Output and Loglevel", RegisteredOptions::BonminCategory);
     roptions->AddBoundedIntegerOption("milp_log_level",
         "specify MILP solver log level.",
@@ -14,12 +14,14 @@
 #include "BonminConfig.h"
 #include "IpSmartPtr.hpp"
 #include <string>
+#include <vector>
 /* forward declarations.*/
 class OsiSolverInterface;
 class OsiClpSolverInterface;
 class OsiCpxSolverInterface;
 class CbcStrategy;
 class CbcStrategyDefault;
+class CbcModel;
 
 #include "OsiCuts.hpp"
 
@@ -44,6 +46,10 @@ namespace Bonmin {
       /** Assign lp solver. */
       void setLpSolver(OsiSolverInterface * lp);
 
+      /** Set a solution from which the next solves start (NULL to remove it).
+          It is kept until the lp solver changes; only used with Cbc. */
+      void setMipStart(const double * x);
+
       /** Assign a strategy. */
       void setStrategy(CbcStrategyDefault * strategy);
 
@@ -108,12 +114,41 @@ namespace Bonmin {
         return iterationCount_;
       }
 
+      /** Returns number of solutions found in last solve with Cbc
+          (merged from all the solves of the portfolio).*/
+      inline int numberPoolSolutions() const
+      {
+        return static_cast<int>(poolObjectives_.size());
+      }
+
+      /** Returns i-th best solution found in last solve with Cbc.*/
+      inline const double * poolSolution(int i) const
+      {
+        return &poolSolutions_[i][0];
+      }
+
+      /** Returns objective value of i-th best solution found in last solve with Cbc.*/
+      inline double poolObjective(int i) const
+      {
+        return poolObjectives_[i];
+      }
+
 
       OsiSolverInterface * solver();
 
      /** Register options for that Oa based cut generation method. */
      static void registerOptions(Ipopt::SmartPtr<Bonmin::RegisteredOptions> roptions);
     private:
+      /** Solve the MILP with a portfolio of diversified Cbc runs in parallel.*/
+      void solveCbcPortfolio(double cutoff, int loglevel, double maxTime,
+                             bool findGoodSol);
+      /** Pass the start solution (if any) to a Cbc run.*/
+      void passMipStart(CbcModel & cbc) const;
+      /** Empty the solution pool.*/
+      void clearPool();
+      /** Add a solution to the pool (if it is not there already).*/
+      void addToPool(const double * x, double obj);
+
       /** If lp solver is clp (then have to use Cbc) (not owned).*/
       OsiClpSolverInterface *clp_;
       /** If mip solver is cpx this is it (owned). */
@@ -136,6 +171,14 @@ namespace Bonmin {
       double gap_tol_;
       /** say if owns copy of clp_.*/
       bool ownClp_;
+      /** Number of Cbc runs made in parallel.*/
+      int portfolioSize_;
+      /** Solutions found in last solve with Cbc (sorted by objective value).*/
+      std::vector<std::vector<double> > poolSolutions_;
+      /** Objective values of poolSolutions_.*/
+      std::vector<double> poolObjectives_;
+      /** Solution from which Cbc runs start (empty if none).*/
+      std::vector<double> mipStart_;
     };
 
 }
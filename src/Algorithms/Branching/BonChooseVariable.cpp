@@ -7,6 +7,7 @@
 #include "CoinTime.hpp"
 #include "IpBlas.hpp"
 #include "BonMsgUtils.hpp"
+#include "BonProfiler.hpp"
 
 // This couples Cbc code into Bonmin code...
 #include "CbcModel.hpp"
@@ -36,6 +37,9 @@ namespace Bonmin
     ADD_MSG(BRANCH_VAR, std_m, 4, "Branched on variable %i, bestWhichWay: %i");
     ADD_MSG(CHOSEN_VAR, std_m, 4,"           Choosing %d");
     ADD_MSG(UPDATE_PS_COST, std_m, 4,"update %3d %3d %e %e %3d");
+    ADD_MSG(PS_COST_READ, std_m, 1,"Read pseudo costs of %d variables from %s");
+    ADD_MSG(PS_COST_WRITE, std_m, 1,"Wrote pseudo costs of %d variables to %s");
+    ADD_MSG(PS_COST_FILE_ERROR, warn_m, 1,"Could not %s pseudo costs file %s");
   }
   const std::string BonChooseVariable::CNAME = "BonChooseVariable";
 
@@ -44,7 +48,12 @@ namespace Bonmin
       results_(),
       cbc_model_(NULL),
       only_pseudo_when_trusted_(false),
-      pseudoCosts_()
+      pseudoCosts_(),
+      pseudoCostsInput_(),
+      pseudoCostsOutput_(),
+      pseudoCostsRead_(false),
+      initialPseudoCosts_(),
+      initialPseudoCostsNames_()
   {
     jnlst_ = b.journalist();
     Ipopt::SmartPtr<Ipopt::OptionsList> options = b.options();
@@ -80,6 +89,8 @@ namespace Bonmin
     options->GetIntegerValue("number_strong_branch_root", numberStrongRoot_, b.prefix());
     options->GetIntegerValue("min_number_strong_branch", minNumberStrongBranch_, b.prefix());
     options->GetIntegerValue("number_look_ahead", numberLookAhead_, b.prefix());
+    options->GetStringValue("pseudo_costs_input_file", pseudoCostsInput_, b.prefix());
+    options->GetStringValue("pseudo_costs_output_file", pseudoCostsOutput_, b.prefix());
 
     start_time_ = CoinCpuTime();
   }
@@ -102,7 +113,12 @@ namespace Bonmin
       numberLookAhead_(rhs.numberLookAhead_),
       minNumberStrongBranch_(rhs.minNumberStrongBranch_),
       pseudoCosts_(rhs.pseudoCosts_),
-      trustStrongForPseudoCosts_(rhs.trustStrongForPseudoCosts_)
+      trustStrongForPseudoCosts_(rhs.trustStrongForPseudoCosts_),
+      pseudoCostsInput_(rhs.pseudoCostsInput_),
+      pseudoCostsOutput_(rhs.pseudoCostsOutput_),
+      pseudoCostsRead_(rhs.pseudoCostsRead_),
+      initialPseudoCosts_(rhs.initialPseudoCosts_),
+      initialPseudoCostsNames_(rhs.initialPseudoCostsNames_)
   {
     jnlst_ = rhs.jnlst_;
     handler_ = rhs.handler_->clone();
@@ -134,6 +150,11 @@ namespace Bonmin
       trustStrongForPseudoCosts_ = rhs.trustStrongForPseudoCosts_;
       numberLookAhead_ = rhs.numberLookAhead_;
       results_ = rhs.results_;
+      pseudoCostsInput_ = rhs.pseudoCostsInput_;
+      pseudoCostsOutput_ = rhs.pseudoCostsOutput_;
+      pseudoCostsRead_ = rhs.pseudoCostsRead_;
+      initialPseudoCosts_ = rhs.initialPseudoCosts_;
+      initialPseudoCostsNames_ = rhs.initialPseudoCostsNames_;
     }
     return *this;
   }
@@ -197,6 +218,57 @@ namespace Bonmin
     roptions->AddLowerBoundedIntegerOption("number_look_ahead", "Sets limit of look-ahead strong-branching trials",
         0, 0,"");
     roptions->setOptionExtraInfo("number_look_ahead", 31);
+
+    roptions->AddStringOption1("pseudo_costs_input_file",
+        "File from which pseudo costs and strong branching statistics are initialized.",
+        "", "*", "Any acceptable file name",
+        "The file is written by a previous run with pseudo_costs_output_file, "
+        "variables are matched by their names. An empty name disables reading.");
+    roptions->setOptionExtraInfo("pseudo_costs_input_file", 63);
+    roptions->AddStringOption1("pseudo_costs_output_file",
+        "File to which pseudo costs and strong branching statistics are written at the end of the search.",
+        "", "*", "Any acceptable file name",
+        "An empty name disables writing.");
+    roptions->setOptionExtraInfo("pseudo_costs_output_file", 63);
+  }
+
+  void
+  BonChooseVariable::readPseudoCosts()
+  {
+    pseudoCostsRead_ = true;
+    if (!pseudoCostsInput_.empty()) {
+      int numberRead = pseudoCosts_.read(pseudoCostsInput_.c_str(), *solver_);
+      if (numberRead < 0)
+        message(PS_COST_FILE_ERROR)<<"read"<<pseudoCostsInput_<<CoinMessageEol;
+      else
+        message(PS_COST_READ)<<numberRead<<pseudoCostsInput_<<CoinMessageEol;
+    }
+    if (initialPseudoCosts_.numberObjects() > 0) {
+      int numberCopied = pseudoCosts_.copyByName(initialPseudoCosts_, initialPseudoCostsNames_,
+          PseudoCosts::objectNames(*solver_, pseudoCosts_.numberObjects()));
+      message(PS_COST_READ)<<numberCopied<<"checkpoint"<<CoinMessageEol;
+    }
+  }
+
+  void
+  BonChooseVariable::setInitialPseudoCosts(const PseudoCosts & costs,
+      const std::vector<std::string> & names)
+  {
+    initialPseudoCosts_ = costs;
+    initialPseudoCostsNames_ = names;
+    pseudoCostsRead_ = false;
+  }
+
+  void
+  BonChooseVariable::writePseudoCosts() const
+  {
+    if (pseudoCostsOutput_.empty() || solver_ == NULL)
+      return;
+    int numberWritten = pseudoCosts_.write(pseudoCostsOutput_.c_str(), *solver_);
+    if (numberWritten < 0)
+      message(PS_COST_FILE_ERROR)<<"write"<<pseudoCostsOutput_<<CoinMessageEol;
+    else
+      message(PS_COST_WRITE)<<numberWritten<<pseudoCostsOutput_<<CoinMessageEol;
   }
 
 
@@ -338,6 +410,8 @@ namespace Bonmin
       pseudoCosts_.initialize(numberObjects);
       pseudoCosts_.setNumberBeforeTrusted(saveNumberBeforeTrusted);
     }
+    if (!pseudoCostsRead_)
+      readPseudoCosts();
     double check = -COIN_DBL_MAX;
     int checkIndex=0;
     int bestPriority=COIN_INT_MAX;
@@ -788,6 +862,7 @@ namespace Bonmin
   				    OsiBranchingInformation *info,
   				    int numberToDo, int returnCriterion)
   {
+    ProfileTimer timer(Profiler::StrongBranching);
     // Prepare stuff for look-ahead heuristic
     double bestLookAhead_ = -COIN_DBL_MAX;
     int trialsSinceBest_ = 0;
@@ -981,6 +1056,8 @@ namespace Bonmin
   BonChooseVariable::updateInformation(const OsiBranchingInformation *info,
       int branch, OsiHotInfo * hotInfo)
   {
+    pseudoCosts_.addStrongBranchingResult(hotInfo->whichObject(), branch,
+        branch ? hotInfo->upStatus() : hotInfo->downStatus());
     if(!trustStrongForPseudoCosts_) return;
     int index = hotInfo->whichObject();
     assert (index<solver_->numberObjects());
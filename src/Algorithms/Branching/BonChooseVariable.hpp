@@ -10,6 +10,7 @@
 #include "BonOsiTMINLPInterface.hpp"
 #include "CoinMessageHandler.hpp"
 #include "BonBabSetupBase.hpp"
+#include "BonPseudoCosts.hpp"
 // Forward declaration
 class CbcModel;
 
@@ -127,6 +128,9 @@ namespace Bonmin
       BRANCH_VAR,
       CHOSEN_VAR,
       UPDATE_PS_COST,
+      PS_COST_READ,
+      PS_COST_WRITE,
+      PS_COST_FILE_ERROR,
       BON_CHOOSE_MESSAGES_DUMMY_END
     };
 
@@ -246,12 +250,23 @@ namespace Bonmin
 
 
     /** Access to pseudo costs storage.*/
-    const OsiPseudoCosts & pseudoCosts() const{
+    const PseudoCosts & pseudoCosts() const{
       return pseudoCosts_;}
 
     /** Access to pseudo costs storage.*/
-    OsiPseudoCosts & pseudoCosts() {
+    PseudoCosts & pseudoCosts() {
       return pseudoCosts_;}
+
+    /** Write the pseudo costs to the file given by pseudo_costs_output_file
+        (nothing is done if the option is not set).*/
+    void writePseudoCosts() const;
+
+    /** Set pseudo costs from which to start (for example those of a
+        checkpoint), names[i] is the name of the column of object i of costs.
+        They are loaded the first time the candidate list is set up, after
+        those of pseudo_costs_input_file.*/
+    void setInitialPseudoCosts(const PseudoCosts & costs,
+        const std::vector<std::string> & names);
   protected:
 
     /// Holding on the a pointer to the journalist
@@ -328,12 +343,27 @@ namespace Bonmin
     /** Always strong branch that many first candidate in the list regardless of numberTrusted.*/
     int minNumberStrongBranch_;
     /** Stores the pseudo costs. */
-    OsiPseudoCosts pseudoCosts_;
+    PseudoCosts pseudoCosts_;
     /** Wether or not to trust strong branching results for updating pseudo costs.*/
     int trustStrongForPseudoCosts_;
    
     //@}
 
+    /** File from which pseudo costs are initialized (empty if none).*/
+    std::string pseudoCostsInput_;
+    /** File to which pseudo costs are saved at the end (empty if none).*/
+    std::string pseudoCostsOutput_;
+    /** Have the pseudo costs been read from pseudoCostsInput_?*/
+    bool pseudoCostsRead_;
+    /** Pseudo costs to start from (numberObjects() is 0 if none).*/
+    PseudoCosts initialPseudoCosts_;
+    /** Column names of the objects of initialPseudoCosts_.*/
+    std::vector<std::string> initialPseudoCostsNames_;
+
+    /** Read the pseudo costs from pseudoCostsInput_ and initialPseudoCosts_ (done once, the first
+        time the candidate list is set up when all objects are known).*/
+    void readPseudoCosts();
+
     /** detecting if this is root node */
     bool isRootNode(const OsiBranchingInformation *info) const;
 
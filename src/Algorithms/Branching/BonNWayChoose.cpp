@@ -2,9 +2,12 @@
 // Corporation and others.  All Rights Reserved.
 
 #include <climits>
+#include <thread>
 #include "CoinPragma.hpp"
 #include "BonNWayChoose.hpp"
 #include "BonNWayObject.hpp"
+#include "BonOsiTMINLPInterface.hpp"
+#include "BonIpoptSolver.hpp"
 #include "CoinTime.hpp"
 
 #ifndef NDEBUG
@@ -15,9 +18,57 @@
 namespace Bonmin
 {
 
+  struct BonNWayChoose::StrongBranchingBatch
+  {
+    /** Branching object of the nway object (each thread branches on a copy).*/
+    const BonNWayBranchingObject * branch;
+    /** Number of branches.*/
+    int number_branches;
+    /** Information on the node.*/
+    const OsiBranchingInformation * info;
+    /** Bounds of the node.*/
+    const double * saveLower;
+    const double * saveUpper;
+    /** Objective value given to infeasible branches.*/
+    double big_val;
+    /** Index of the nway object among the nway objects.*/
+    int nwayIndex;
+    /** The nway object.*/
+    const BonNWayObject * nway;
+    /** Stop evaluating branches when the usefulness of the object can not exceed
+        this value (-COIN_DBL_MAX to never stop).*/
+    double score_to_beat;
+    /** Wallclock time at start and time allowed.*/
+    double timeStart;
+    double timeRemaining;
+
+    /** Mutex protecting what follows.*/
+    std::mutex mutex;
+    /** Next branch to evaluate.*/
+    int next;
+    /** Has the batch been stopped?*/
+    bool stop;
+    /** For each branch (in branching order), 0 if not evaluated, 1 if feasible,
+        2 if infeasible.*/
+    std::vector<int> status;
+    /** Objective value, variable and sequence branched on for each branch.*/
+    std::vector<double> obj;
+    std::vector<int> var;
+    std::vector<int> seq;
+    /** Unit changes for the branches evaluated, COIN_DBL_MAX for the others.*/
+    std::vector<double> optimistic_changes;
+    /** Number of iterations and of branches done.*/
+    int iterations;
+    int done;
+  };
+
 
   BonNWayChoose::BonNWayChoose(BabSetupBase &b, const OsiSolverInterface* solver):
       OsiChooseVariable(solver),
+      num_threads_(1),
+      thread_solvers_(),
+      eval_mutex_(),
+      score_to_beat_(-COIN_DBL_MAX),
       br_depth_(0),
       bounds_(),
       unit_changes_(),
@@ -33,11 +84,14 @@ namespace Bonmin
     options->GetIntegerValue("nway_branch_log_level", log_, b.prefix());
     options->GetEnumValue("do_fixings", do_fixings_, b.prefix());
     options->GetEnumValue("use_geo_means", geo_means_, b.prefix());
+    options->GetIntegerValue("nway_strong_branching_threads", num_threads_, b.prefix());
     /** Set values of standard branching options.*/
     int numberObjects = solver_->numberObjects();
-    std::cout<<"Number objects "<<numberObjects<<std::endl;
+    if(log_ > 0)
+      std::cout<<"Number objects "<<numberObjects<<std::endl;
     start_time_ = CoinCpuTime();
     OsiObject ** object = solver->objects();
+    start_nway_ = numberObjects;
     for (int i=0;i<numberObjects;i++) {
        BonNWayObject * nway = dynamic_cast<BonNWayObject *>(object[i]);
       if(!nway) continue;
@@ -49,6 +103,10 @@ namespace Bonmin
 
   BonNWayChoose::BonNWayChoose(const BonNWayChoose & rhs) :
       OsiChooseVariable(rhs),
+      num_threads_(rhs.num_threads_),
+      thread_solvers_(),
+      eval_mutex_(),
+      score_to_beat_(-COIN_DBL_MAX),
       br_depth_(rhs.br_depth_),
       do_fixings_(rhs.do_fixings_),
       cutoff_multiplier_(rhs.cutoff_multiplier_),
@@ -69,6 +127,7 @@ namespace Bonmin
   BonNWayChoose::operator=(const BonNWayChoose & rhs)
   {
     if (this != &rhs) {
+      num_threads_ = rhs.num_threads_;
       br_depth_ = rhs.br_depth_;
       do_fixings_ = rhs.do_fixings_;
       cutoff_multiplier_ = rhs.cutoff_multiplier_;
@@ -95,6 +154,7 @@ namespace Bonmin
 
   BonNWayChoose::~BonNWayChoose ()
   {
+    assert(thread_solvers_.empty());
   }
 
   void
@@ -135,6 +195,22 @@ namespace Bonmin
         "all", "Fix whenever possible",
         "");
 
+    roptions->AddLowerBoundedIntegerOption("nway_strong_branching_threads",
+        "Number of threads solving the branches of an nway object in strong branching.",
+        1,1,
+        "Each thread has its own copy of the NLP solver (only supported with Ipopt, FilterSQP "
+        "always uses one thread). Evaluations of the functions of the problem are serialized "
+        "between threads. With more than one thread, the evaluation of an object below the root "
+        "stops as soon as its usefulness can not exceed the one of the best object found so far.");
+    roptions->setOptionExtraInfo("nway_strong_branching_threads", 8);
+
+    roptions->AddStringOption2("sos_branching",
+        "Type of branching on SOS constraints in B-BB.",
+        "standard",
+        "standard", "Two-way branching on the SOS (variable_selection chooses the objects).",
+        "nway", "n-way branching (one child per member of the SOS) chosen with nway strong branching.",
+        "With \"nway\" every integer variable has to be in an SOS of type 1 and variable_selection is ignored.");
+    roptions->setOptionExtraInfo("sos_branching", 8);
 
   }
 
@@ -190,6 +266,38 @@ namespace Bonmin
     return r_val;
   }
 
+  double
+  BonNWayChoose::usefulness_bound(const OsiBranchingInformation * info,
+                size_t n, const int * vars,const std::vector<double> &bounds, const std::vector<double> &unit_changes) const
+  {
+    // Same as compute_usefulness, each score is non decreasing in the unit change.
+    // A product is only monotone if all its factors are non-negative.
+    const double * solution = info->solution_;
+    double obj_val = info->objectiveValue_;
+    const double * lower = info->lower_;
+    const double * upper = info->upper_;
+    double integerTolerance = info->integerTolerance_;
+    double cutoff = info->cutoff_*cutoff_multiplier_;
+    double r_val = (geo_means_) ? 1 : 0;
+
+    for(size_t  i = 0 ; i < n ; i++){
+      int iCol = vars[i];
+      if(fabs(lower[iCol] - upper[iCol]) < integerTolerance) {
+        continue; //Variable is fixed
+      }
+      double residual = upper[iCol] - solution[iCol];
+      double change = (unit_changes[i] == COIN_DBL_MAX) ? COIN_DBL_MAX : residual*unit_changes[i];
+      double score = std::min(cutoff - obj_val, std::max(change,bounds[i] - obj_val));
+      if(geo_means_){
+        if(score < 0.) return COIN_DBL_MAX;
+        r_val*=score;
+      }
+      else
+        r_val += score;
+    }
+    return r_val;
+  }
+
   int
   BonNWayChoose::setupList ( OsiBranchingInformation *info, bool initialize)
   {
@@ -432,6 +540,7 @@ namespace Bonmin
 
 
     solver->markHotStart();
+    setupThreadSolvers(solver);
     for (int i=0;i<numberLeft;i++) {
       int iObject = list_[i];
       const int objectPriority = solver->object(iObject)->priority();
@@ -440,6 +549,7 @@ namespace Bonmin
       }
       else break;
       double score;
+      score_to_beat_ = best_score;
       int r_val = doStrongBranching(solver, info, iObject, saveLower.data(),
                                      saveUpper.data(), score);
       if(r_val == -1) {
@@ -468,10 +578,99 @@ namespace Bonmin
           break;
         }
     }
+    deleteThreadSolvers(solver);
     solver->unmarkHotStart();
     return returnCode;
   }
 
+  void
+  BonNWayChoose::setupThreadSolvers(OsiSolverInterface * solver)
+  {
+    assert(thread_solvers_.empty());
+    if(num_threads_ <= 1) return;
+    OsiTMINLPInterface * nlp = dynamic_cast<OsiTMINLPInterface *>(solver);
+    // FilterSQP keeps the problem being solved in global variables.
+    if(nlp == NULL || dynamic_cast<IpoptSolver *>(nlp->solver()) == NULL)
+      return;
+    for(int i = 1 ; i < num_threads_ ; i++){
+      OsiTMINLPInterface * copy = nlp->cloneForThread(&eval_mutex_);
+      copy->markHotStart();
+      thread_solvers_.push_back(copy);
+    }
+    node_solution_.assign(solver->getColSolution(), solver->getColSolution() + solver->getNumCols());
+    // The node solver is used by the calling thread.
+    nlp->problem()->setEvalMutex(&eval_mutex_);
+  }
+
+  void
+  BonNWayChoose::deleteThreadSolvers(OsiSolverInterface * solver)
+  {
+    if(thread_solvers_.empty()) return;
+    for(size_t i = 0 ; i < thread_solvers_.size() ; i++){
+      thread_solvers_[i]->unmarkHotStart();
+      delete thread_solvers_[i];
+    }
+    thread_solvers_.clear();
+    OsiTMINLPInterface * nlp = dynamic_cast<OsiTMINLPInterface *>(solver);
+    assert(nlp);
+    nlp->problem()->setEvalMutex(NULL);
+  }
+
+  void
+  BonNWayChoose::runBatch(OsiSolverInterface * solver, StrongBranchingBatch & batch) const
+  {
+    const OsiBranchingInformation * info = batch.info;
+    int numberColumns = solver->getNumCols();
+    const double * lower = solver->getColLower();
+    const double * upper = solver->getColUpper();
+    const bool prune = info->depth_ > 0 && batch.score_to_beat > -COIN_DBL_MAX;
+    while(true){
+      int k;
+      {
+        std::lock_guard<std::mutex> lock(batch.mutex);
+        if(batch.stop || batch.next >= batch.number_branches) break;
+        k = batch.next++;
+      }
+      BonNWayBranchingObject branch(*batch.branch);
+      branch.set_branch_index(k);
+      branch.branch(solver);
+      int v_br = branch.var_branched_on();
+      int s_br = branch.seq_branched_on();
+      solver->solveFromHotStart();
+      int iterations = solver->getIterationCount();
+      double obj_val = solver->getObjValue();
+      bool infeasible = solver->isProvenPrimalInfeasible() ||
+         (solver->isProvenOptimal() && obj_val > info->cutoff_);
+
+      // Restore bounds
+      for (int j=0;j<numberColumns;j++) {
+        if (batch.saveLower[j] != lower[j])
+  	solver->setColLower(j,batch.saveLower[j]);
+        if (batch.saveUpper[j] != upper[j])
+  	solver->setColUpper(j,batch.saveUpper[j]);
+      }
+
+      std::lock_guard<std::mutex> lock(batch.mutex);
+      batch.status[k] = infeasible ? 2 : 1;
+      batch.obj[k] = obj_val;
+      batch.var[k] = v_br;
+      batch.seq[k] = s_br;
+      batch.iterations += iterations;
+      batch.done++;
+      if(prune){
+        double residual = info->upper_[v_br] - info->solution_[v_br];
+        batch.optimistic_changes[s_br] = ((infeasible ? batch.big_val : obj_val)
+                                          - info->objectiveValue_)/residual;
+        double bound = usefulness_bound(info, batch.nway->numberMembers(), batch.nway->members(),
+                                        bounds_[batch.nwayIndex], batch.optimistic_changes);
+        if(bound <= batch.score_to_beat)
+          batch.stop = true;
+      }
+      if(CoinWallclockTime() - batch.timeStart > batch.timeRemaining)
+        batch.stop = true;
+    }
+  }
+
   /*  This is a utility function which does strong branching on
       one nway object and stores the results in appropriate arrays of the class
       and maybe more.
@@ -493,7 +692,9 @@ namespace Bonmin
     const double * upper = info->upper_;
 
     int numberColumns = solver->getNumCols();
-    double timeStart = CoinCpuTime();
+    // With several threads cpu time runs faster than wallclock time.
+    const bool parallel = !thread_solvers_.empty();
+    double timeStart = parallel ? CoinWallclockTime() : CoinCpuTime();
 
     int numberObjects = info->solver_->numberObjects();
     const BonNWayObject * nway = ASSERTED_CAST<const BonNWayObject *>(solver->object(objectIndex));
@@ -509,6 +710,81 @@ namespace Bonmin
     big_val += fabs(big_val)*1e-5;
     std::vector<double> unit_changes(numberObjects - start_nway_, -DBL_MAX);
     //std::vector<double> unit_changes(numberObjects - start_nway_, 0);
+    // Information on the node used to compute the usefulness, in parallel
+    // the solution and bounds of the node solver change while it is used.
+    OsiBranchingInformation node_info(*info);
+    const OsiBranchingInformation * score_info = info;
+    if(parallel){
+      node_info.solution_ = node_solution_.data();
+      node_info.lower_ = saveLower;
+      node_info.upper_ = saveUpper;
+      score_info = &node_info;
+
+      StrongBranchingBatch batch;
+      batch.branch = branch;
+      batch.number_branches = number_branches;
+      batch.info = &node_info;
+      batch.saveLower = saveLower;
+      batch.saveUpper = saveUpper;
+      batch.big_val = big_val;
+      batch.nwayIndex = nwayIndex;
+      batch.nway = nway;
+      batch.score_to_beat = score_to_beat_;
+      batch.timeStart = CoinWallclockTime();
+      batch.timeRemaining = info->timeRemaining_;
+      batch.next = 0;
+      batch.stop = false;
+      batch.status.assign(number_branches, 0);
+      batch.obj.assign(number_branches, 0.);
+      batch.var.assign(number_branches, -1);
+      batch.seq.assign(number_branches, -1);
+      batch.optimistic_changes.assign(unit_changes.size(), COIN_DBL_MAX);
+      batch.iterations = 0;
+      batch.done = 0;
+
+      std::vector<std::thread> threads;
+      for(size_t i = 0 ; i < thread_solvers_.size() ; i++){
+        threads.push_back(std::thread(&BonNWayChoose::runBatch, this,
+                                      thread_solvers_[i], std::ref(batch)));
+      }
+      runBatch(solver, batch);
+      for(size_t i = 0 ; i < threads.size() ; i++){
+        threads[i].join();
+      }
+      numberStrongIterations_ += batch.iterations;
+      numberStrongDone_ += batch.done;
+
+      // Same bookkeeping as below in the order of the branches, fixings are
+      // only applied once all branches are done.
+      for(int k = 0 ; k < number_branches ; k++){
+        if(batch.status[k] == 0) continue;
+        int v_br = batch.var[k];
+        int s_br = batch.seq[k];
+        double residual = saveUpper[v_br] - node_solution_[v_br];
+        if(batch.status[k] == 2){//infeasible
+          if(info->depth_ == 0){
+            bounds_[nwayIndex][s_br] = big_val;
+          }
+          unit_changes[s_br] = (big_val - info->objectiveValue_)/residual;
+          if(do_fixings_ > 1){
+            n_can_be_fixed++;
+            if(log_ > 0)
+              printf("Fixing variable %i to 0 the cutoff is %g\n", v_br, big_val);
+            saveUpper[v_br] = saveLower[v_br];
+            solver->setColUpper(v_br, saveLower[v_br]);
+            for(size_t i = 0 ; i < thread_solvers_.size() ; i++)
+              thread_solvers_[i]->setColUpper(v_br, saveLower[v_br]);
+          }
+        }
+        else{
+          if(info->depth_ == 0){
+            bounds_[nwayIndex][s_br] = batch.obj[k];
+          }
+          unit_changes[s_br] = (batch.obj[k] - info->objectiveValue_)/residual;
+        }
+      }
+      branches_left = 0;
+    }
     while(branches_left){ 
 
       branch->branch(solver);
@@ -550,8 +826,9 @@ namespace Bonmin
       }
       branches_left = branch->numberBranchesLeft();
     }
+    delete branch;
 
-    score = compute_usefulness(info, nway->numberMembers(), nway->members(), bounds_[nwayIndex], unit_changes);
+    score = compute_usefulness(score_info, nway->numberMembers(), nway->members(), bounds_[nwayIndex], unit_changes);
     if(info->depth_ == 0){//At root bounds contains valid bound on obj after branching, remember
         if(do_fixings_ == 1 || do_fixings_ == 3)
         nway->set_bounds(bounds_[nwayIndex]);
@@ -579,7 +856,7 @@ namespace Bonmin
    if(n_can_be_fixed){
      return 1;
     }
-    bool hitMaxTime = ( CoinCpuTime()-timeStart > info->timeRemaining_)
+    bool hitMaxTime = ( (parallel ? CoinWallclockTime() : CoinCpuTime())-timeStart > info->timeRemaining_)
     		|| ( CoinCpuTime() - start_time_ > time_limit_);
     if (hitMaxTime) {
     return 3;
@@ -3,6 +3,9 @@
 #ifndef BonNWayChoose_H
 #define BonNWayChoose_H
 
+#include <mutex>
+#include <vector>
+
 #include "OsiChooseVariable.hpp"
 #include "BonBabSetupBase.hpp"
 #include "BonNWayObject.hpp"
@@ -12,11 +15,19 @@
 namespace Bonmin
 {
 
-  /** This class chooses a variable to branch on
+  class OsiTMINLPInterface;
+
+  /** This class chooses an nway object to branch on
 
-      This is the base class for the branching rules in Bonmin (inherits
-      from OsiChooseVariable). This class implements a simple strong branching algorithm where the changes in the objective
-      value induced by branching on a specific object are estimated with the pure virtual function fill_changes.
+      It implements a strong branching algorithm on BonNWayObject's: each
+      branch of a candidate (all members but one fixed to their lower bound)
+      is solved and the usefulness of the object is computed from the changes
+      in the objective value. Pseudo costs of the members are used once they
+      are trusted.
+
+      With nway_strong_branching_threads > 1 the branches of a candidate are
+      solved in parallel, each thread with its own copy of the NLP solver
+      (see OsiTMINLPInterface::cloneForThread).
   */
 
   class BonNWayChoose : public OsiChooseVariable
@@ -88,6 +99,37 @@ namespace Bonmin
     /** Default Constructor, forbiden for some reason.*/
     BonNWayChoose ();
 
+    /** Branches of one object evaluated in parallel and their outcome.*/
+    struct StrongBranchingBatch;
+
+    /** Evaluate branches of batch with solver until there are none left
+        (or the batch is stopped).*/
+    void runBatch(OsiSolverInterface * solver, StrongBranchingBatch & batch) const;
+
+    /** Upper bound on the usefulness of an nway object given the changes of
+        its branches (a change of COIN_DBL_MAX for branches not evaluated).
+        Returns COIN_DBL_MAX if no bound can be given.*/
+    double usefulness_bound(const OsiBranchingInformation * info,
+                size_t n, const int * vars, const std::vector<double> &bounds, const std::vector<double> &unit_changes) const;
+
+    /** Create the solvers of the other threads for strong branching on solver.*/
+    void setupThreadSolvers(OsiSolverInterface * solver);
+
+    /** Delete the solvers of the other threads.*/
+    void deleteThreadSolvers(OsiSolverInterface * solver);
+
+    /** Number of threads for strong branching.*/
+    int num_threads_;
+    /** Solvers of the other threads (the calling thread uses the solver of the node).*/
+    std::vector<OsiTMINLPInterface *> thread_solvers_;
+    /** Mutex serializing the evaluations of the TMINLP when several threads strong branch.*/
+    std::mutex eval_mutex_;
+    /** Best usefulness found so far in the current strong branching loop.*/
+    double score_to_beat_;
+    /** Solution of the node (copied when strong branching in parallel since
+        the node solver is used by the calling thread).*/
+    std::vector<double> node_solution_;
+
     /** depth of strong-branching.*/
     int br_depth_;
     /** Do we fix?*.*/
@@ -13,8 +13,9 @@
 #ifndef BonNWayObject_H
 #define BonNWayObject_H
 #include "OsiBranchingObject.hpp"
-#include "CbcConsequence.hpp"
+#include <cassert>
 #include <list>
+#include <vector>
 
 namespace Bonmin {
 class n_way_consequences {
@@ -188,6 +189,12 @@ public:
     inline int state_branched_on(){
       return branchIndex_ - 1;
     }
+
+    /** Set the number of branches already done (next call to branch()
+        does branch branchIndex). Used to evaluate branches out of order.*/
+    inline void set_branch_index(int branchIndex){
+      branchIndex_ = branchIndex;
+    }
 private:
     /// Points back to object
     const BonNWayObject * object_;
@@ -8,6 +8,12 @@
 // Date : 04/12/2007
 
 #include "BonPseudoCosts.hpp"
+#include "OsiSolverInterface.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <string>
 
 
 namespace Bonmin
@@ -20,7 +26,10 @@ namespace Bonmin
 
   /** Copy constructor.*/
   PseudoCosts::PseudoCosts(const PseudoCosts & rhs):
-   OsiPseudoCosts(rhs)
+   OsiPseudoCosts(rhs),
+   strongNumber_(rhs.strongNumber_),
+   upInfeasible_(rhs.upInfeasible_),
+   downInfeasible_(rhs.downInfeasible_)
   {
   }
 
@@ -31,9 +40,192 @@ namespace Bonmin
   {
     if (this != &rhs) {
         OsiPseudoCosts::operator=(rhs);
+        strongNumber_ = rhs.strongNumber_;
+        upInfeasible_ = rhs.upInfeasible_;
+        downInfeasible_ = rhs.downInfeasible_;
     }
     return *this;
   }
 
+  void
+  PseudoCosts::initialize(int n)
+  {
+    OsiPseudoCosts::initialize(n);
+    strongNumber_.assign(n, 0);
+    upInfeasible_.assign(n, 0);
+    downInfeasible_.assign(n, 0);
+  }
+
+  void
+  PseudoCosts::addStrongBranchingResult(int index, int way, int status)
+  {
+    if (index < 0 || index >= static_cast<int>(strongNumber_.size()))
+      return;
+    if (way == 0)
+      strongNumber_[index]++;
+    if (status == 1) {
+      if (way)
+        upInfeasible_[index]++;
+      else
+        downInfeasible_[index]++;
+    }
+  }
+
+  /** Identifies (and versions) pseudo-costs files.*/
+  static const char pseudoCostsMagic[8] = {'B', 'O', 'N', 'P', 'S', 'C', 0, 1};
+
+  std::vector<std::string>
+  PseudoCosts::objectNames(const OsiSolverInterface & solver, int numberObjects)
+  {
+    std::vector<std::string> names(numberObjects);
+    for (int i = 0 ; i < numberObjects && i < solver.numberObjects() ; i++) {
+      int iCol = solver.object(i)->columnNumber();
+      if (iCol >= 0)
+        names[i] = solver.getColName(iCol);
+    }
+    return names;
+  }
+
+  int
+  PseudoCosts::write(const char * fileName, const OsiSolverInterface & solver) const
+  {
+    std::ofstream out(fileName, std::ios::binary | std::ios::trunc);
+    if (!out)
+      return -1;
+    return write(out, objectNames(solver, numberObjects_));
+  }
+
+  int
+  PseudoCosts::write(std::ostream & out, const std::vector<std::string> & names) const
+  {
+    int numberWritten = 0;
+    for (int i = 0 ; i < numberObjects_ && i < static_cast<int>(names.size()) ; i++)
+      if (!names[i].empty()) numberWritten++;
+
+    out.write(pseudoCostsMagic, sizeof(pseudoCostsMagic));
+    out.write(reinterpret_cast<const char *>(&numberBeforeTrusted_), sizeof(int));
+    out.write(reinterpret_cast<const char *>(&numberWritten), sizeof(int));
+    for (int i = 0 ; i < numberObjects_ && i < static_cast<int>(names.size()) ; i++) {
+      const std::string & name = names[i];
+      if (name.empty())
+        continue;
+      int length = static_cast<int>(name.size());
+      out.write(reinterpret_cast<const char *>(&length), sizeof(int));
+      out.write(name.c_str(), length);
+      out.write(reinterpret_cast<const char *>(upTotalChange_ + i), sizeof(double));
+      out.write(reinterpret_cast<const char *>(downTotalChange_ + i), sizeof(double));
+      int counts[5] = {upNumber_[i], downNumber_[i], 0, 0, 0};
+      if (i < static_cast<int>(strongNumber_.size())) {
+        counts[2] = strongNumber_[i];
+        counts[3] = upInfeasible_[i];
+        counts[4] = downInfeasible_[i];
+      }
+      out.write(reinterpret_cast<const char *>(counts), sizeof(counts));
+    }
+    if (!out)
+      return -1;
+    return numberWritten;
+  }
+
+  int
+  PseudoCosts::read(const char * fileName, const OsiSolverInterface & solver)
+  {
+    std::ifstream in(fileName, std::ios::binary);
+    if (!in)
+      return -1;
+    return read(in, objectNames(solver, numberObjects_));
+  }
+
+  int
+  PseudoCosts::read(std::istream & in, const std::vector<std::string> & names)
+  {
+    char magic[sizeof(pseudoCostsMagic)];
+    int numberBeforeTrusted;
+    int numberRecords;
+    in.read(magic, sizeof(magic));
+    in.read(reinterpret_cast<char *>(&numberBeforeTrusted), sizeof(int));
+    in.read(reinterpret_cast<char *>(&numberRecords), sizeof(int));
+    if (!in || memcmp(magic, pseudoCostsMagic, sizeof(magic)) != 0 || numberRecords < 0)
+      return -1;
+
+    std::map<std::string, int> objectOfName;
+    for (int i = 0 ; i < numberObjects_ && i < static_cast<int>(names.size()) ; i++) {
+      if (!names[i].empty())
+        objectOfName[names[i]] = i;
+    }
+    if (static_cast<int>(strongNumber_.size()) < numberObjects_) {
+      strongNumber_.resize(numberObjects_, 0);
+      upInfeasible_.resize(numberObjects_, 0);
+      downInfeasible_.resize(numberObjects_, 0);
+    }
+
+    int numberLoaded = 0;
+    std::string name;
+    for (int k = 0 ; k < numberRecords ; k++) {
+      int length;
+      in.read(reinterpret_cast<char *>(&length), sizeof(int));
+      if (!in || length < 0 || length > (1 << 20))
+        return -1;
+      name.resize(length);
+      if (length > 0)
+        in.read(&name[0], length);
+      double changes[2];
+      int counts[5];
+      in.read(reinterpret_cast<char *>(changes), sizeof(changes));
+      in.read(reinterpret_cast<char *>(counts), sizeof(counts));
+      if (!in)
+        return -1;
+      std::map<std::string, int>::iterator it = objectOfName.find(name);
+      if (it == objectOfName.end())
+        continue;
+      int i = it->second;
+      upTotalChange_[i] = changes[0];
+      downTotalChange_[i] = changes[1];
+      upNumber_[i] = counts[0];
+      downNumber_[i] = counts[1];
+      strongNumber_[i] = counts[2];
+      upInfeasible_[i] = counts[3];
+      downInfeasible_[i] = counts[4];
+      numberLoaded++;
+    }
+    return numberLoaded;
+  }
+
+  int
+  PseudoCosts::copyByName(const PseudoCosts & other, const std::vector<std::string> & otherNames,
+      const std::vector<std::string> & names)
+  {
+    std::map<std::string, int> objectOfName;
+    for (int i = 0 ; i < other.numberObjects_ && i < static_cast<int>(otherNames.size()) ; i++) {
+      if (!otherNames[i].empty())
+        objectOfName[otherNames[i]] = i;
+    }
+    if (static_cast<int>(strongNumber_.size()) < numberObjects_) {
+      strongNumber_.resize(numberObjects_, 0);
+      upInfeasible_.resize(numberObjects_, 0);
+      downInfeasible_.resize(numberObjects_, 0);
+    }
+    int numberCopied = 0;
+    for (int i = 0 ; i < numberObjects_ && i < static_cast<int>(names.size()) ; i++) {
+      if (names[i].empty())
+        continue;
+      std::map<std::string, int>::iterator it = objectOfName.find(names[i]);
+      if (it == objectOfName.end())
+        continue;
+      int k = it->second;
+      upTotalChange_[i] = other.upTotalChange_[k];
+      downTotalChange_[i] = other.downTotalChange_[k];
+      upNumber_[i] = other.upNumber_[k];
+      downNumber_[i] = other.downNumber_[k];
+      if (k < static_cast<int>(other.strongNumber_.size())) {
+        strongNumber_[i] = other.strongNumber_[k];
+        upInfeasible_[i] = other.upInfeasible_[k];
+        downInfeasible_[i] = other.downInfeasible_[k];
+      }
+      numberCopied++;
+    }
+    return numberCopied;
+  }
+
 }/* End Bonmin namespace.*/
 
@@ -12,6 +12,9 @@
 
 #include "BonminConfig.h"
 #include "OsiChooseVariable.hpp"
+#include <iosfwd>
+#include <string>
+#include <vector>
 namespace Bonmin
 {
 
@@ -85,6 +88,69 @@ namespace Bonmin
     void addInfo(int way, double originalObj, double originalInfeas,
         double newObj, double newInfeas, int status);
 
+    /** Resize the tables for n objects (all the statistics are reset).*/
+    void initialize(int n);
+
+    /** Record a strong branching on object index in direction way
+        (status is 1 if the child was found infeasible).*/
+    void addStrongBranchingResult(int index, int way, int status);
+
+    /** Number of strong branchings done on each object.*/
+    const int * strongNumber() const
+    {
+      return strongNumber_.empty() ? NULL : &strongNumber_[0];
+    }
+
+    /** Number of up children found infeasible by strong branching.*/
+    const int * upInfeasible() const
+    {
+      return upInfeasible_.empty() ? NULL : &upInfeasible_[0];
+    }
+
+    /** Number of down children found infeasible by strong branching.*/
+    const int * downInfeasible() const
+    {
+      return downInfeasible_.empty() ? NULL : &downInfeasible_[0];
+    }
+
+    /** Write the tables in binary form to fileName. Each object is
+        identified by the name of its column in solver (objects which are
+        not attached to a column are skipped).
+        Returns the number of objects written (-1 if the file can not be written).*/
+    int write(const char * fileName, const OsiSolverInterface & solver) const;
+
+    /** Read tables written by write. Entries are matched with the objects
+        of solver through the column names, other entries are ignored.
+        Returns the number of objects loaded (-1 if the file can not be read).*/
+    int read(const char * fileName, const OsiSolverInterface & solver);
+
+    /** Write the tables to out, object i being identified by names[i]
+        (objects with an empty name are skipped). Same format as the file
+        version. Returns the number of objects written (-1 on error).*/
+    int write(std::ostream & out, const std::vector<std::string> & names) const;
+
+    /** Read tables written by write from in, entries are matched with the
+        objects through names. Returns the number of objects loaded (-1 on error).*/
+    int read(std::istream & in, const std::vector<std::string> & names);
+
+    /** Copy the statistics of the objects of other into this, objects are
+        matched by their names (otherNames[i] and names[i] are the names of
+        object i of other and of this). Returns the number of objects copied.*/
+    int copyByName(const PseudoCosts & other, const std::vector<std::string> & otherNames,
+        const std::vector<std::string> & names);
+
+    /** Name of the column of each of the first numberObjects objects of
+        solver (empty if the object is not attached to a column).*/
+    static std::vector<std::string> objectNames(const OsiSolverInterface & solver,
+        int numberObjects);
+
+  private:
+    /** Number of strong branchings done on each object.*/
+    std::vector<int> strongNumber_;
+    /** Number of up children found infeasible by strong branching.*/
+    std::vector<int> upInfeasible_;
+    /** Number of down children found infeasible by strong branching.*/
+    std::vector<int> downInfeasible_;
   };
 
 }/* End Bonmin namespace.*/
@@ -19,6 +19,7 @@
 #endif
 #include "OsiAuxInfo.hpp"
 #include "BonSolverHelp.hpp"
+#include "BonProfiler.hpp"
 
 #include <climits>
 
@@ -64,6 +65,7 @@ namespace Bonmin
       BabInfo * babInfo,
       double & cutoff, const CglTreeInfo & info) const
   {
+    ProfileTimer timer(Profiler::OaGeneration);
 
     double lastPeriodicLog = CoinCpuTime();
 
@@ -100,6 +102,10 @@ namespace Bonmin
     //milpFeasible = feasible;
     isInteger = (subMip_->getLastSolution() != NULL);
     nLocalSearch_++;
+    for (int i = 0 ; i < subMip_->numberPoolSolutions() ; i++) {
+      babInfo->solutionPool().add(subMip_->poolSolution(i), lp->getNumCols(),
+          subMip_->poolObjective(i), SolutionPool::MilpFeasible);
+    }
 
     if (milpOptimal)
       handler_->message(SOLVED_LOCAL_SEARCH, messages_)<<subMip_->nodeCount()<<subMip_->iterationCount()<<CoinMessageEol;
@@ -117,6 +123,14 @@ namespace Bonmin
 #endif
     double * nlpSol = NULL;
     double ub = cutoff;
+    double poolObj = post_pool_check(babInfo, *subMip_, cutoff);
+    if (poolObj < ub) {
+      ub = poolObj;
+      cutoff = ub > 0 ? ub *(1 - parameters_.cbcCutoffIncrement_) : ub*(1 + parameters_.cbcCutoffIncrement_);
+      lp->setDblParam(OsiDualObjectiveLimit, cutoff);
+      numSols_++;
+      feasible = milpBound < cutoff;
+    }
     double gap = 1;
     while (isInteger && feasible) {
       numberPasses++;
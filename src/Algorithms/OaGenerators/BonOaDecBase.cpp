@@ -11,6 +11,7 @@
 #include <climits>
 
 #include <algorithm>
+#include <vector>
 #include "BonOaDecBase.hpp"
 
 
@@ -23,8 +24,6 @@
 #include "BonCbcLpStrategy.hpp"
 #include "BonCbc.hpp"
 #include "BonSolverHelp.hpp"
-//The following two are to interupt the solution of sub-mip through CTRL-C
-extern CbcModel * OAModel;
 
 namespace Bonmin {
 
@@ -384,6 +383,8 @@ OaDecompositionBase::post_nlp_solve(BabInfo * babInfo, double cutoff) const{
         lpSolution[numcols] = nlp_->getObjValue();
         babInfo->setSolution(lpSolution,
             numcols + 1, lpSolution[numcols]);
+        babInfo->solutionPool().add(lpSolution, numcols, lpSolution[numcols],
+            SolutionPool::MinlpFeasible);
         delete [] lpSolution;
       }
     }
@@ -399,6 +400,50 @@ OaDecompositionBase::post_nlp_solve(BabInfo * babInfo, double cutoff) const{
   return return_value;
 }
 
+double
+OaDecompositionBase::post_pool_check(BabInfo * babInfo, const SubMipSolver & subMip,
+    double cutoff) const{
+  double best = COIN_DBL_MAX;
+  int npoints = subMip.numberPoolSolutions();
+  if (npoints == 0 || babInfo == NULL)
+    return best;
+  // The points of the pool are integer feasible, evaluate all of them with
+  // one call to see which ones are also feasible for the nonlinear
+  // constraints (the MILP may have more columns than the nlp).
+  int numcols = nlp_->getNumCols();
+  std::vector<double> x(numcols * npoints);
+  for (int k = 0 ; k < npoints ; k++)
+    CoinCopyN(subMip.poolSolution(k), numcols, &x[k * numcols]);
+  std::vector<double> obj(npoints);
+  std::vector<double> violation(npoints);
+  if (!nlp_->getConstraintsViolations(npoints, &x[0], &obj[0], &violation[0]))
+    return best;
+  double tolerance;
+  nlp_->getDblParam(OsiPrimalTolerance, tolerance);
+  int bestPoint = -1;
+  for (int k = 0 ; k < npoints ; k++) {
+    if (violation[k] > tolerance)
+      continue;
+    babInfo->solutionPool().add(&x[k * numcols], numcols, obj[k],
+        SolutionPool::MinlpFeasible);
+    if (obj[k] < cutoff && obj[k] < best) {
+      best = obj[k];
+      bestPoint = k;
+    }
+  }
+  if (bestPoint >= 0) {
+    handler_->message(UPDATE_UB, messages_)
+    <<best
+    <<CoinCpuTime()-timeBegin_
+    <<CoinMessageEol;
+    std::vector<double> solution(numcols + 1);
+    CoinCopyN(&x[bestPoint * numcols], numcols, &solution[0]);
+    solution[numcols] = best;
+    babInfo->setSolution(&solution[0], numcols + 1, best);
+  }
+  return best;
+}
+
 void 
 OaDecompositionBase::setupMipSolver(BabSetupBase &b, const std::string & prefix){
 
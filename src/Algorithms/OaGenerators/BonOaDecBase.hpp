@@ -224,6 +224,13 @@ private:
     /** Solve the nlp and do output.
         \return true if feasible*/
     bool post_nlp_solve(BabInfo * babInfo, double cutoff) const;
+    /** Check the points kept in the pool of subMip (integer feasible for
+        the MILP) against the nonlinear constraints, all of them with one
+        evaluation. The feasible ones go to the solution pool of babInfo,
+        the best one is passed to babInfo if it is better than cutoff.
+        \return its objective value (COIN_DBL_MAX if none)*/
+    double post_pool_check(BabInfo * babInfo, const SubMipSolver & subMip,
+        double cutoff) const;
     /** @} */
 
     /// virtual method which performs the OA algorithm by modifying lp and nlp.
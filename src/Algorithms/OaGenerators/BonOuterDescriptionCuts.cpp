@@ -0,0 +1,248 @@
+// (C) Copyright Bonmin contributors 2026
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+//
+// Date : 10/19/2026
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <functional>
+
+#include "BonOuterDescriptionCuts.hpp"
+#include "BonBabSetupBase.hpp"
+#include "BonOsiTMINLPInterface.hpp"
+
+namespace Bonmin
+{
+
+  OuterDescriptionCuts::OuterDescriptionCuts(BabSetupBase & b):
+      CglCutGenerator(),
+      nlp_(b.nonlinearSolver()),
+      n_(0),
+      nnzJac_(0),
+      nonLinear_(),
+      position_(),
+      breakpoints_(),
+      numPoints_(),
+      errorBound_(),
+      numCuts_(0),
+      maxPoints_(20),
+      maxCutsPerRound_(10),
+      tolerance_(1e-05),
+      global_(true)
+  {
+    b.options()->GetIntegerValue("outer_description_max_points", maxPoints_, b.prefix());
+    b.options()->GetIntegerValue("outer_description_cuts_per_round", maxCutsPerRound_, b.prefix());
+    b.options()->GetNumericValue("outer_description_tol", tolerance_, b.prefix());
+    int ivalue;
+    b.options()->GetEnumValue("oa_cuts_scope", ivalue, b.prefix());
+    global_ = ivalue;
+
+    assert(nlp_ != NULL);
+    Ipopt::Index n, m, nnz_jac_g, nnz_h_lag;
+    Ipopt::TNLP::IndexStyleEnum index_style;
+    nlp_->problem()->get_nlp_info(n, m, nnz_jac_g, nnz_h_lag, index_style);
+    n_ = n;
+    nnzJac_ = nnz_jac_g;
+    position_.resize(m, -1);
+    errorBound_.resize(m, 0.);
+    if (m > 0) {
+      std::vector<Ipopt::TNLP::LinearityType> types(m);
+      nlp_->problem()->get_constraints_linearity(m, &types[0]);
+      for (int i = 0 ; i < m ; i++) {
+        if (types[i] == Ipopt::TNLP::NON_LINEAR) {
+          position_[i] = static_cast<int>(nonLinear_.size());
+          nonLinear_.push_back(i);
+        }
+      }
+    }
+    breakpoints_.resize(nonLinear_.size());
+    numPoints_.resize(nonLinear_.size(), 0);
+  }
+
+  OuterDescriptionCuts::OuterDescriptionCuts(const OuterDescriptionCuts & other):
+      CglCutGenerator(other),
+      nlp_(other.nlp_),
+      n_(other.n_),
+      nnzJac_(other.nnzJac_),
+      nonLinear_(other.nonLinear_),
+      position_(other.position_),
+      breakpoints_(other.breakpoints_),
+      numPoints_(other.numPoints_),
+      errorBound_(other.errorBound_),
+      numCuts_(other.numCuts_),
+      maxPoints_(other.maxPoints_),
+      maxCutsPerRound_(other.maxCutsPerRound_),
+      tolerance_(other.tolerance_),
+      global_(other.global_)
+  {}
+
+  OuterDescriptionCuts::~OuterDescriptionCuts()
+  {}
+
+  int
+  OuterDescriptionCuts::nonLinearIndex(int row) const
+  {
+    if (row < 0 || row >= static_cast<int>(position_.size()))
+      return -1;
+    return position_[row];
+  }
+
+  int
+  OuterDescriptionCuts::numBreakpoints(int row) const
+  {
+    int k = nonLinearIndex(row);
+    if (k < 0)
+      return 0;
+    return numPoints_[k];
+  }
+
+  double
+  OuterDescriptionCuts::maxErrorBound() const
+  {
+    double bound = 0.;
+    for (unsigned int k = 0 ; k < nonLinear_.size() ; k++)
+      bound = std::max(bound, errorBound_[nonLinear_[k]]);
+    return bound;
+  }
+
+  bool
+  OuterDescriptionCuts::isBreakpoint(int k, const double * x,
+      const int * ind, int nnz) const
+  {
+    const std::vector<double> & points = breakpoints_[k];
+    if (nnz == 0)
+      return numPoints_[k] > 0;
+    for (size_t p = 0 ; p + nnz <= points.size() ; p += nnz) {
+      int j = 0;
+      for (; j < nnz ; j++) {
+        double xj = x[ind[j]];
+        if (fabs(points[p + j] - xj) > 1e-09 * (1. + fabs(xj)))
+          break;
+      }
+      if (j == nnz)
+        return true;
+    }
+    return false;
+  }
+
+  void
+  OuterDescriptionCuts::addBreakpoint(int row, const double * x)
+  {
+    int k = nonLinearIndex(row);
+    if (k < 0)
+      return;
+    std::vector<int> ind(n_);
+    std::vector<double> values(n_);
+    double g;
+    int start[2];
+    if (!nlp_->problem()->eval_gi_and_grad_gi(n_, x, true, 1, &row, &g,
+        start, &ind[0], &values[0]))
+      return;
+    int nnz = start[1];
+    if (nlp_->problem()->index_style() == Ipopt::TNLP::FORTRAN_STYLE) {
+      for (int j = 0 ; j < nnz ; j++)
+        ind[j]--;
+    }
+    if (isBreakpoint(k, x, &ind[0], nnz))
+      return;
+    for (int j = 0 ; j < nnz ; j++)
+      breakpoints_[k].push_back(x[ind[j]]);
+    numPoints_[k]++;
+  }
+
+  void
+  OuterDescriptionCuts::generateCuts(const OsiSolverInterface &si, OsiCuts & cs,
+      const CglTreeInfo info) const
+  {
+    int nRows = static_cast<int>(nonLinear_.size());
+    if (nRows == 0)
+      return;
+    // The LP may have more columns than the nlp (objective variable),
+    // the first n_ are the variables of the nlp.
+    const double * x = si.getColSolution();
+    if (x == NULL || si.getNumCols() < n_)
+      return;
+
+    // Evaluate all the nonlinear constraints at once.
+    std::vector<double> g(nRows);
+    std::vector<int> start(nRows + 1);
+    std::vector<int> ind(std::max(nnzJac_, 1));
+    std::vector<double> values(ind.size());
+    if (!nlp_->problem()->eval_gi_and_grad_gi(n_, x, true, nRows, &nonLinear_[0],
+        &g[0], &start[0], &ind[0], &values[0]))
+      return;
+    if (nlp_->problem()->index_style() == Ipopt::TNLP::FORTRAN_STYLE) {
+      for (int j = 0 ; j < start[nRows] ; j++)
+        ind[j]--;
+    }
+
+    const double * rowLower = nlp_->getRowLower();
+    const double * rowUpper = nlp_->getRowUpper();
+    std::vector<std::pair<double, int> > violated;
+    for (int k = 0 ; k < nRows ; k++) {
+      int row = nonLinear_[k];
+      double violation = std::max(g[k] - rowUpper[row], rowLower[row] - g[k]);
+      violation = std::max(violation, 0.);
+      errorBound_[row] = violation;
+      if (violation > tolerance_)
+        violated.push_back(std::make_pair(violation, k));
+    }
+    if (violated.empty())
+      return;
+
+    // Most violated first (all of them: a constraint which has all its
+    // breakpoints is skipped and the next one is taken).
+    std::sort(violated.begin(), violated.end(),
+        std::greater<std::pair<double, int> >());
+
+    int numAdded = 0;
+    for (unsigned int c = 0 ; c < violated.size() && numAdded < maxCutsPerRound_ ; c++) {
+      int k = violated[c].second;
+      int nnz = start[k + 1] - start[k];
+      const int * support = &ind[start[k]];
+      bool known = isBreakpoint(k, x, support, nnz);
+      // A tangent at a known breakpoint is still violated if the cut has
+      // left the LP, put it back but do not count a new breakpoint.
+      if (!known) {
+        if (numPoints_[k] >= maxPoints_)
+          continue;
+        for (int j = 0 ; j < nnz ; j++)
+          breakpoints_[k].push_back(x[support[j]]);
+        numPoints_[k]++;
+      }
+      nlp_->getConstraintOuterApproximation(cs, nonLinear_[k], x, NULL, global_);
+      numAdded++;
+    }
+    numCuts_ += numAdded;
+  }
+
+  void
+  OuterDescriptionCuts::registerOptions(Ipopt::SmartPtr<Bonmin::RegisteredOptions> roptions)
+  {
+    roptions->SetRegisteringCategory("Outer description cuts", RegisteredOptions::BonminCategory);
+    roptions->AddLowerBoundedIntegerOption("outer_description_cuts",
+        "Specify the frequency (in terms of nodes) at which the outer description of the nonlinear constraints is refined.",
+        0,0,
+        "At each call, tangents are added at the LP solution to the nonlinear constraints it violates the most. "
+        "A frequency of 0 amounts to never refine the description.");
+    roptions->setOptionExtraInfo("outer_description_cuts",7);
+    roptions->AddLowerBoundedIntegerOption("outer_description_max_points",
+        "Maximal number of breakpoints kept per nonlinear constraint by the outer description.",
+        1,20,
+        "");
+    roptions->setOptionExtraInfo("outer_description_max_points",7);
+    roptions->AddLowerBoundedIntegerOption("outer_description_cuts_per_round",
+        "Maximal number of tangents added at each refinement of the outer description.",
+        1,10,
+        "");
+    roptions->setOptionExtraInfo("outer_description_cuts_per_round",7);
+    roptions->AddLowerBoundedNumberOption("outer_description_tol",
+        "Violation under which a nonlinear constraint is considered to be well described.",
+        0,true,1e-05,
+        "");
+    roptions->setOptionExtraInfo("outer_description_tol",7);
+  }
+
+} /* end namespace Bonmin.*/
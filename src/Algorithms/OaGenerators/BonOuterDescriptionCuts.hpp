@@ -0,0 +1,126 @@
+// (C) Copyright Bonmin contributors 2026
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+//
+// Date : 10/19/2026
+
+#ifndef BonOuterDescriptionCuts_HPP
+#define BonOuterDescriptionCuts_HPP
+
+#include <vector>
+
+#include "CglCutGenerator.hpp"
+#include "BonRegisteredOptions.hpp"
+
+namespace Bonmin
+{
+  class BabSetupBase;
+  class OsiTMINLPInterface;
+
+  /** Incremental outer description of the nonlinear constraints.
+   *  The generator keeps, for each nonlinear constraint, the list of points
+   *  (breakpoints) at which it has been linearized. Each call evaluates the
+   *  nonlinear constraints at the current LP solution and adds a tangent
+   *  only to the constraints which are violated the most (at most
+   *  maxCutsPerRound_ per call and maxPoints_ per constraint).
+   *  The violation of a constraint at the last LP solution is kept as an
+   *  estimate of the error of its current outer description.
+   *  Intended for separable (or more generally convex) models where a few
+   *  well placed tangents give a tight description.
+   */
+  class BONMINLIB_EXPORT OuterDescriptionCuts: public CglCutGenerator
+  {
+  public:
+    /** Constructor.*/
+    OuterDescriptionCuts(BabSetupBase & b);
+
+    /** Copy constructor (breakpoints are copied).*/
+    OuterDescriptionCuts(const OuterDescriptionCuts & other);
+
+    /** clone */
+    CglCutGenerator * clone() const
+    {
+      return new OuterDescriptionCuts(*this);
+    }
+
+    /** Destructor.*/
+    virtual ~OuterDescriptionCuts();
+
+    /** Generate tangents for the nonlinear constraints most violated by the
+        LP solution of si.*/
+    virtual void generateCuts(const OsiSolverInterface &si, OsiCuts & cs,
+        const CglTreeInfo info = CglTreeInfo()) const;
+
+    /** Record x as a breakpoint of constraint row (for example a point used
+        to build the initial outer description).*/
+    void addBreakpoint(int row, const double * x);
+
+    /** Number of breakpoints of constraint row.*/
+    int numBreakpoints(int row) const;
+
+    /** Violation of constraint row at the last LP solution examined
+        (0 for a linear constraint or if the constraint was satisfied).*/
+    double errorBound(int row) const
+    {
+      return errorBound_[row];
+    }
+
+    /** Largest error bound over all nonlinear constraints.*/
+    double maxErrorBound() const;
+
+    /** Indices of the nonlinear constraints.*/
+    const std::vector<int> & nonLinearRows() const
+    {
+      return nonLinear_;
+    }
+
+    /** Total number of tangents generated.*/
+    int numCuts() const
+    {
+      return numCuts_;
+    }
+
+    /** Register the options of the generator.*/
+    static void registerOptions(Ipopt::SmartPtr<Bonmin::RegisteredOptions> roptions);
+
+  private:
+    /** Assignment operator (not implemented).*/
+    OuterDescriptionCuts & operator=(const OuterDescriptionCuts &);
+
+    /** Position of row in nonLinear_ (-1 if the row is linear).*/
+    int nonLinearIndex(int row) const;
+
+    /** Is x (restricted to the support of nonlinear row k) already a
+        breakpoint of the row?*/
+    bool isBreakpoint(int k, const double * x, const int * ind, int nnz) const;
+
+    /** Pointer to the nonlinear solver (not owned).*/
+    OsiTMINLPInterface * nlp_;
+    /** Number of variables of the nlp.*/
+    int n_;
+    /** Number of nonzeroes in the jacobian of the nlp.*/
+    int nnzJac_;
+    /** Nonlinear constraints of the nlp.*/
+    std::vector<int> nonLinear_;
+    /** Position of each constraint in nonLinear_ (-1 if linear).*/
+    std::vector<int> position_;
+    /** For each nonlinear constraint, its breakpoints one after the other
+        (values of the variables of the support of the constraint).*/
+    mutable std::vector<std::vector<double> > breakpoints_;
+    /** Number of breakpoints of each nonlinear constraint.*/
+    mutable std::vector<int> numPoints_;
+    /** For each constraint, its violation at the last LP solution.*/
+    mutable std::vector<double> errorBound_;
+    /** Number of tangents generated.*/
+    mutable int numCuts_;
+    /** Maximal number of breakpoints per constraint.*/
+    int maxPoints_;
+    /** Maximal number of tangents per call.*/
+    int maxCutsPerRound_;
+    /** Violation under which a constraint is considered well described.*/
+    double tolerance_;
+    /** Are the cuts globally valid?*/
+    bool global_;
+  };
+} /* end namespace Bonmin.*/
+#endif
@@ -193,6 +193,22 @@ namespace Bonmin {
    return true;
   }
 
+  bool
+  TMINLP2TNLPQuadCuts::get_obj_grad_structure(Index n, Index& nnz_grad_f,
+        Index* jCol){
+    if(obj_.empty()){
+      return TMINLP2TNLP::get_obj_grad_structure(n, nnz_grad_f, jCol);}
+    int offset = (index_style() == TNLP::FORTRAN_STYLE);
+    nnz_grad_f = 0;
+    for(int i = 0 ; i < n ; i++){
+      if(obj_[i] != 0.){
+        if(jCol != NULL) jCol[nnz_grad_f] = i + offset;
+        nnz_grad_f++;
+      }
+    }
+    return true;
+  }
+
   bool TMINLP2TNLPQuadCuts::eval_gi(Index n, const Number* x, bool new_x,
                            Index i, Number& gi)
   {
@@ -280,6 +296,43 @@ namespace Bonmin {
     }
     return false;
   }
+
+  bool TMINLP2TNLPQuadCuts::eval_gi_and_grad_gi(Index n, const Number* x, bool new_x,
+                                Index nrows, const Index* rows, Number* g,
+                                Index* start, Index* jCol, Number* values)
+  {
+    int m_orig = num_constraints() - (int)quadRows_.size();
+    bool has_cuts = false;
+    for(int k = 0 ; k < nrows && !has_cuts ; k++){
+      has_cuts = rows[k] >= m_orig;
+    }
+    if(!has_cuts){
+      return TMINLP2TNLP::eval_gi_and_grad_gi(n, x, new_x, nrows, rows, g,
+                                              start, jCol, values);
+    }
+    int offset = TMINLP2TNLP::index_style() == Ipopt::TNLP::FORTRAN_STYLE;
+    start[0] = 0;
+    for(int k = 0 ; k < nrows ; k++){
+      int nnz;
+      if(rows[k] < m_orig){
+        Index s[2];
+        if(!TMINLP2TNLP::eval_gi_and_grad_gi(n, x, new_x, 1, rows + k, g + k,
+                                             s, jCol + start[k], values + start[k]))
+          return false;
+        nnz = s[1];
+      }
+      else {
+        QuadRow * r = quadRows_[rows[k] - m_orig];
+        nnz = r->nnz_grad();
+        r->gradiant_struct(nnz, jCol + start[k], offset);
+        r->eval_grad(nnz, x, new_x, values + start[k]);
+        g[k] = r->eval_f(x, new_x);
+      }
+      new_x = false;
+      start[k + 1] = start[k] + nnz;
+    }
+    return true;
+  }
     /** Return the hessian of the
      *  lagrangian. The vectors iRow and jCol only need to be set once
      *  (during the first call). The first call is used to set the
@@ -86,6 +86,11 @@ namespace Bonmin
     virtual bool eval_grad_f(Ipopt::Index n, const Ipopt::Number* x, bool new_x,
         Ipopt::Number* grad_f);
 
+    /** Returns the structure of the gradient of the objective (that of the
+        linear objective if one has been set).*/
+    virtual bool get_obj_grad_structure(Ipopt::Index n, Ipopt::Index& nnz_grad_f,
+        Ipopt::Index* jCol);
+
     /** Returns the vector of constraint values in x (appends constraint values for quadratics).*/
     virtual bool eval_g(Ipopt::Index n, const Ipopt::Number* x, bool new_x,
         Ipopt::Index m, Ipopt::Number* g);
@@ -106,6 +111,11 @@ namespace Bonmin
     virtual bool eval_grad_gi(Ipopt::Index n, const Ipopt::Number* x, bool new_x,
                               Ipopt::Index i, Ipopt::Index& nele_grad_gi, Ipopt::Index* jCol,
                               Ipopt::Number* values);
+    /** compute the values and gradients of a list of constraints
+        (some of which may be quadratic cuts) */
+    virtual bool eval_gi_and_grad_gi(Ipopt::Index n, const Ipopt::Number* x, bool new_x,
+        Ipopt::Index nrows, const Ipopt::Index* rows, Ipopt::Number* g,
+        Ipopt::Index* start, Ipopt::Index* jCol, Ipopt::Number* values);
     /** Return the hessian of the
      *  lagrangian. The vectors iRow and jCol only need to be set once
      *  (during the first call). The first call is used to set the
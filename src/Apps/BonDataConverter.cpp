@@ -0,0 +1,83 @@
+// (C) Copyright Bonmin contributors 2026
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+//
+// Date : 10/19/2026
+
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include "BonminConfig.h"
+
+#include "CoinPragma.hpp"
+#include "CoinError.hpp"
+#include "BonBoundsReader.hpp"
+#include "BonStartPointReader.hpp"
+#include "BonSolReader.hpp"
+#include "BonDataFile.hpp"
+
+/************************************************************************
+
+Converts bounds files (BoundsReader), starting point files
+(StartPointReader) and solution files (SolReader) between their text and
+binary formats:
+
+  BonDataConverter bounds|start|sol inputFile outputFile [-text]
+
+The input file can be in either format, the output file is binary unless
+-text is given.
+
+************************************************************************/
+
+int main (int argc, char *argv[])
+{
+  using namespace Bonmin;
+
+  if(argc < 4 || (argc > 4 && strcmp(argv[4], "-text") != 0)) {
+    std::cerr<<"Usage: "<<argv[0]<<" bounds|start|sol inputFile outputFile [-text]"
+             <<std::endl;
+    return 1;
+  }
+  std::string kind = argv[1];
+  std::string input = argv[2];
+  std::string output = argv[3];
+  bool binary = argc < 5;
+
+  bool ok = false;
+  try {
+    if(kind == "bounds") {
+      BoundsReader reader(input);
+      reader.read();
+      ok = DataFile::writeBounds(output, binary,
+          reader.numberLowers(), reader.indexLowers(), reader.lowerBounds(),
+          reader.numberUppers(), reader.indexUppers(), reader.upperBounds());
+    }
+    else if(kind == "start") {
+      StartPointReader reader(input);
+      if(reader.readFile())
+        ok = DataFile::writeStartPoint(output, binary,
+            reader.numberPrimals(), reader.getPrimals(),
+            reader.numberDuals(), reader.getDuals());
+    }
+    else if(kind == "sol") {
+      SolReader reader(input, "");
+      if(reader.readFile())
+        ok = DataFile::writeSolution(output, binary, reader.n_cols(), reader.x());
+    }
+    else {
+      std::cerr<<"Unknown kind of file "<<kind<<std::endl;
+      return 1;
+    }
+  }
+  catch(CoinError &E) {
+    std::cerr<<E.className()<<"::"<<E.methodName()
+             <<std::endl
+             <<E.message()<<std::endl;
+  }
+  if(!ok) {
+    std::cerr<<"Could not convert "<<input<<" to "<<output<<std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -9,8 +9,16 @@
 // Date : 02/15/2006
 
 
+#include <algorithm>
 #include <cassert>
+#include <cstdlib>
+#include <cstring>
 #include <iomanip>
+#include <fstream>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <thread>
 
 #include "BonminConfig.h"
 
@@ -20,6 +28,7 @@
 #include "BonBoundsReader.hpp"
 #include "BonStartPointReader.hpp"
 #include "CoinTime.hpp"
+#include "CoinFinite.hpp"
 
 #include "BonAmplSetup.hpp"
 
@@ -27,15 +36,206 @@
 /************************************************************************
  
 This mains is used for resolving the problem with fixed bounds and eventually a starting point
+
+  BonNodeSolver problem.nl [boundsFile [startingPointFile]]
+
+or, in batch mode, for resolving it for each record of a file of bound changes
+
+  BonNodeSolver problem.nl -batch recordsFile resultsFile [numberThreads]
+
+The records file is read by BoundsReader::readRecords: either bounds files
+in text (lines "LO index bound" and "UP index bound") separated by lines
+"END", or binary bounds data files (see DataFile) one after the other.
+Each record is solved from the original bounds of the problem,
+warm started from the previous solve of the same thread.
+The results file is binary: "BNS1", the number of columns and the number
+of records (ints), then for each record in the order of the file its
+status (int: 0 optimal, 1 infeasible, 2 not solved, 3 error), number of
+iterations (int), objective value and solve time (doubles) and the primal
+solution (one double per column).
  
 ************************************************************************/
 
+/** Result of the solve of one record of a batch.*/
+struct NodeResult
+{
+  int status;
+  int iterations;
+  double objective;
+  double time;
+  std::vector<double> solution;
+};
+
+/** Shared state of the threads solving a batch.*/
+struct NodeBatch
+{
+  const std::vector<Bonmin::BoundsReader::Record> * records;
+  std::vector<NodeResult> results;
+  const double * colLower;
+  const double * colUpper;
+  std::atomic<int> next;
+};
+
+/** Solve records of the batch with solver until there are none left.*/
+static void
+solveRecords(Bonmin::OsiTMINLPInterface * solver, NodeBatch & batch)
+{
+  int numberColumns = solver->getNumCols();
+  bool warm = false;
+  for(int k = batch.next++ ; k < static_cast<int>(batch.records->size()) ;
+      k = batch.next++) {
+    const Bonmin::BoundsReader::Record & record = (*batch.records)[k];
+    NodeResult & result = batch.results[k];
+    // Wallclock time, CPU time is the one of the process.
+    double start = CoinWallclockTime();
+    try {
+      for(unsigned int i = 0 ; i < record.indexLowers.size() ; i++)
+        if(record.indexLowers[i] < 0 || record.indexLowers[i] >= numberColumns)
+          throw CoinError("Column index out of range in record", "solveRecords", "BonNodeSolver");
+      for(unsigned int i = 0 ; i < record.indexUppers.size() ; i++)
+        if(record.indexUppers[i] < 0 || record.indexUppers[i] >= numberColumns)
+          throw CoinError("Column index out of range in record", "solveRecords", "BonNodeSolver");
+      solver->setColLower(batch.colLower);
+      solver->setColUpper(batch.colUpper);
+      for(unsigned int i = 0 ; i < record.indexLowers.size() ; i++)
+        solver->setColLower(record.indexLowers[i], record.lowerBounds[i]);
+      for(unsigned int i = 0 ; i < record.indexUppers.size() ; i++)
+        solver->setColUpper(record.indexUppers[i], record.upperBounds[i]);
+      if(warm)
+        solver->resolve();
+      else
+        solver->initialSolve();
+      warm = true;
+      if(solver->isProvenOptimal())
+        result.status = 0;
+      else if(solver->isProvenPrimalInfeasible())
+        result.status = 1;
+      else
+        result.status = 2;
+      result.iterations = solver->getIterationCount();
+      result.objective = solver->getObjValue();
+      result.solution.assign(solver->getColSolution(),
+          solver->getColSolution() + numberColumns);
+    }
+    catch(Bonmin::OsiTMINLPInterface::SimpleError &) {
+      result.status = 3;
+      warm = false;
+    }
+    catch(CoinError &) {
+      result.status = 3;
+      warm = false;
+    }
+    catch(Bonmin::TNLPSolver::UnsolvedError * E) {
+      delete E;
+      result.status = 3;
+      warm = false;
+    }
+    catch(...) {
+      // An exception must not leave a worker thread.
+      result.status = 3;
+      warm = false;
+    }
+    if(result.status == 3) {
+      result.iterations = 0;
+      result.objective = COIN_DBL_MAX;
+      result.solution.assign(numberColumns, 0.);
+    }
+    result.time = CoinWallclockTime() - start;
+  }
+}
+
+/** Write the results of a batch to fileName.*/
+static void
+writeResults(const std::string & fileName, int numberColumns,
+    const std::vector<NodeResult> & results)
+{
+  std::ofstream fout(fileName.c_str(), std::ios::out | std::ios::binary);
+  if(!fout.good())
+    throw CoinError("Can not open results file " + fileName, "writeResults", "BonNodeSolver");
+  int numberRecords = static_cast<int>(results.size());
+  fout.write("BNS1", 4);
+  fout.write(reinterpret_cast<const char *>(&numberColumns), sizeof(int));
+  fout.write(reinterpret_cast<const char *>(&numberRecords), sizeof(int));
+  for(int k = 0 ; k < numberRecords ; k++) {
+    const NodeResult & result = results[k];
+    fout.write(reinterpret_cast<const char *>(&result.status), sizeof(int));
+    fout.write(reinterpret_cast<const char *>(&result.iterations), sizeof(int));
+    fout.write(reinterpret_cast<const char *>(&result.objective), sizeof(double));
+    fout.write(reinterpret_cast<const char *>(&result.time), sizeof(double));
+    fout.write(reinterpret_cast<const char *>(&result.solution[0]),
+        numberColumns * sizeof(double));
+  }
+  if(!fout.good())
+    throw CoinError("Error writing results file " + fileName, "writeResults", "BonNodeSolver");
+}
+
+/** Solve every record of recordsFile with nlpSolver (and copies of it
+    solving in numberThreads - 1 other threads).*/
+static void
+solveBatch(Bonmin::OsiTMINLPInterface & nlpSolver, const std::string & recordsFile,
+    const std::string & resultsFile, int numberThreads)
+{
+  std::vector<Bonmin::BoundsReader::Record> records;
+  Bonmin::BoundsReader::readRecords(recordsFile, records);
+  int numberColumns = nlpSolver.getNumCols();
+  std::vector<double> colLower(nlpSolver.getColLower(),
+      nlpSolver.getColLower() + numberColumns);
+  std::vector<double> colUpper(nlpSolver.getColUpper(),
+      nlpSolver.getColUpper() + numberColumns);
+
+  NodeBatch batch;
+  batch.records = &records;
+  batch.results.resize(records.size());
+  batch.colLower = &colLower[0];
+  batch.colUpper = &colUpper[0];
+  batch.next = 0;
+
+  double start = CoinWallclockTime();
+  // Evaluations of the model are serialized, the NLP solves run in parallel.
+  std::mutex eval_mutex;
+  std::vector<Bonmin::OsiTMINLPInterface *> solvers;
+  for(int i = 1 ; i < numberThreads ; i++)
+    solvers.push_back(nlpSolver.cloneForThread(&eval_mutex));
+  if(!solvers.empty())
+    nlpSolver.problem()->setEvalMutex(&eval_mutex);
+  std::vector<std::thread> threads;
+  for(unsigned int i = 0 ; i < solvers.size() ; i++)
+    threads.push_back(std::thread(solveRecords, solvers[i], std::ref(batch)));
+  solveRecords(&nlpSolver, batch);
+  for(unsigned int i = 0 ; i < threads.size() ; i++)
+    threads[i].join();
+  nlpSolver.problem()->setEvalMutex(NULL);
+  for(unsigned int i = 0 ; i < solvers.size() ; i++)
+    delete solvers[i];
+
+  writeResults(resultsFile, numberColumns, batch.results);
+  int numberSolved = 0;
+  for(unsigned int k = 0 ; k < batch.results.size() ; k++)
+    if(batch.results[k].status < 2) numberSolved++;
+  std::cout<<"Solved "<<numberSolved<<" of "<<records.size()<<" records in "
+           <<CoinWallclockTime() - start<<" seconds with "<<numberThreads
+           <<" thread(s)"<<std::endl;
+}
+
 int main (int argc, char *argv[])
 {
 
   using namespace Ipopt;
   using namespace Bonmin;
 
+  if(argc < 2) {
+    std::cerr<<"Usage: "<<argv[0]<<" problem.nl [boundsFile [startingPointFile]]"<<std::endl
+             <<"       "<<argv[0]<<" problem.nl -batch recordsFile resultsFile [numberThreads]"
+             <<std::endl;
+    return 1;
+  }
+  bool batchMode = argc > 2 && strcmp(argv[2], "-batch") == 0;
+  if(batchMode && argc < 5) {
+    std::cerr<<"Usage: "<<argv[0]<<" problem.nl -batch recordsFile resultsFile [numberThreads]"
+             <<std::endl;
+    return 1;
+  }
+
   // Read in model using argv[1]
   char * pbName = new char[strlen(argv[1])+1];
   strcpy(pbName, argv[1]);
@@ -66,25 +266,32 @@ int main (int argc, char *argv[])
 
   try
     {
-      std::cout<<nodeFileName<<std::endl;
-      // Read the bounds and change them in Ipopt
-      if(argc>2) {
-	Bonmin::BoundsReader bounds(nodeFileName);
-	bounds.readAndApply(&nlpSolver);
-      }
-      if(argc>3) {
-	Bonmin::StartPointReader init(startingPointFile);
-	init.readAndApply(&nlpSolver);
+      if(batchMode) {
+        int numberThreads = argc > 5 ? atoi(argv[5]) : 1;
+        nlpSolver.messageHandler()->setLogLevel(0);
+        solveBatch(nlpSolver, argv[3], argv[4], std::max(numberThreads, 1));
       }
+      else {
+        std::cout<<nodeFileName<<std::endl;
+        // Read the bounds and change them in Ipopt
+        if(argc>2) {
+          Bonmin::BoundsReader bounds(nodeFileName);
+          bounds.readAndApply(&nlpSolver);
+        }
+        if(argc>3) {
+          Bonmin::StartPointReader init(startingPointFile);
+          init.readAndApply(&nlpSolver);
+        }
       
-      nlpSolver.solver()->forceSolverOutput(4);
-      nlpSolver.initialSolve();
+        nlpSolver.solver()->forceSolverOutput(4);
+        nlpSolver.initialSolve();
       
-      //Print out integer variable values
-      for(int i = 0 ; i <nlpSolver.getNumCols() ; i++) {
-	if (nlpSolver.isInteger(i)) {
-	  std::cout<<"x[ "<<i<<"] = "<<nlpSolver.getColSolution()[i]<<std::endl;
-	}
+        //Print out integer variable values
+        for(int i = 0 ; i <nlpSolver.getNumCols() ; i++) {
+          if (nlpSolver.isInteger(i)) {
+            std::cout<<"x[ "<<i<<"] = "<<nlpSolver.getColSolution()[i]<<std::endl;
+          }
+        }
       }
     }
   catch(Bonmin::OsiTMINLPInterface::SimpleError &E) {
@@ -0,0 +1,599 @@
+// (C) Copyright Bonmin contributors 2026
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+//
+// Date : 10/19/2026
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+
+#include "BonBabCheckpoint.hpp"
+#include "BonChooseVariable.hpp"
+#include "BonCbcNode.hpp"
+#include "BonDiver.hpp"
+#include "BonIpoptWarmStart.hpp"
+
+#include "CbcModel.hpp"
+#include "CbcNode.hpp"
+#include "CbcTree.hpp"
+#include "CbcCountRowCut.hpp"
+#include "CoinFinite.hpp"
+#include "CoinTime.hpp"
+#include "OsiBranchingObject.hpp"
+
+namespace Bonmin
+{
+
+  /** Identifies (and versions) checkpoint files.*/
+  static const char checkpointMagic[8] = {'B', 'O', 'N', 'C', 'K', 'P', 0, 2};
+
+  BabCheckpoint::Snapshot::Snapshot():
+      numberColumns(0),
+      numberNodes(0),
+      bestObjective(COIN_DBL_MAX),
+      bestPossible(-COIN_DBL_MAX),
+      bestSolution(),
+      rootLower(),
+      rootUpper(),
+      cutStarts(1, 0),
+      cutIndices(),
+      cutElements(),
+      cutLower(),
+      cutUpper(),
+      nodes(),
+      pseudoCosts(),
+      objectNames()
+  {}
+
+  BabCheckpoint::BabCheckpoint(const std::string & fileName, double interval):
+      fileName_(fileName),
+      interval_(interval),
+      lastTime_(CoinGetTimeOfDay()),
+      pending_(NULL),
+      pendingRecords_(NULL),
+      writing_(false),
+      stop_(false),
+      numberWritten_(0),
+      base_(NULL),
+      firstPending_(0),
+      numberNodesBefore_(0),
+      mutex_(),
+      changed_(),
+      writer_()
+  {
+    writer_ = std::thread(&BabCheckpoint::writerLoop, this);
+  }
+
+  BabCheckpoint::~BabCheckpoint()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    changed_.notify_all();
+    writer_.join();
+    delete pending_;
+    delete pendingRecords_;
+  }
+
+  void
+  BabCheckpoint::nodeProcessed(CbcModel & model)
+  {
+    double now = CoinGetTimeOfDay();
+    if (now - lastTime_ < interval_)
+      return;
+    lastTime_ = now;
+    checkpoint(model);
+  }
+
+  void
+  BabCheckpoint::checkpoint(CbcModel & model)
+  {
+    Snapshot * snapshot = new Snapshot;
+    NodeRecords * records = new NodeRecords;
+    takeSnapshot(model, *snapshot, *records);
+    if (base_ != NULL) {
+      // The search of model is the one of an open node of base_: what is
+      // global is in base_ and the nodes not searched yet are still open.
+      snapshot->numberNodes += numberNodesBefore_;
+      snapshot->rootLower = base_->rootLower;
+      snapshot->rootUpper = base_->rootUpper;
+      snapshot->cutStarts = base_->cutStarts;
+      snapshot->cutIndices = base_->cutIndices;
+      snapshot->cutElements = base_->cutElements;
+      snapshot->cutLower = base_->cutLower;
+      snapshot->cutUpper = base_->cutUpper;
+      double cutoff = model.getCutoff();
+      for (unsigned int i = firstPending_ ; i < base_->nodes.size() ; i++)
+        if (base_->nodes[i].objectiveValue < cutoff)
+          snapshot->nodes.push_back(base_->nodes[i]);
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      // A snapshot not yet written is superseded by the new one.
+      delete pending_;
+      delete pendingRecords_;
+      pending_ = snapshot;
+      pendingRecords_ = records;
+    }
+    changed_.notify_all();
+  }
+
+  void
+  BabCheckpoint::setResumeState(const Snapshot * base, int firstPending, int numberNodes)
+  {
+    base_ = base;
+    firstPending_ = firstPending;
+    numberNodesBefore_ = numberNodes;
+  }
+
+  void
+  BabCheckpoint::flush()
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (pending_ != NULL || writing_)
+      changed_.wait(lock);
+  }
+
+  int
+  BabCheckpoint::numberWritten() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return numberWritten_;
+  }
+
+  void
+  BabCheckpoint::writerLoop()
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      while (pending_ == NULL && !stop_)
+        changed_.wait(lock);
+      if (pending_ == NULL)
+        break;
+      Snapshot * snapshot = pending_;
+      NodeRecords * records = pendingRecords_;
+      pending_ = NULL;
+      pendingRecords_ = NULL;
+      writing_ = true;
+      lock.unlock();
+
+      buildNodes(*records, *snapshot);
+      delete records;
+
+      // Write next to the file and rename, the previous checkpoint stays
+      // valid until the new one is complete.
+      std::string tmpName = fileName_ + ".tmp";
+      bool written = write(tmpName, *snapshot);
+      if (written && std::rename(tmpName.c_str(), fileName_.c_str()) != 0) {
+        std::remove(fileName_.c_str());
+        written = std::rename(tmpName.c_str(), fileName_.c_str()) == 0;
+      }
+      delete snapshot;
+
+      lock.lock();
+      writing_ = false;
+      if (written)
+        numberWritten_++;
+      changed_.notify_all();
+    }
+  }
+
+  void
+  BabCheckpoint::openNodes(CbcTree * tree, std::vector<CbcNode *> & nodes)
+  {
+    if (tree == NULL)
+      return;
+    if (CbcDfsDiver * dfs = dynamic_cast<CbcDfsDiver *>(tree))
+      dfs->openNodes(nodes);
+    else if (CbcProbedDiver * probed = dynamic_cast<CbcProbedDiver *>(tree))
+      probed->openNodes(nodes);
+    else if (CbcDiver * diver = dynamic_cast<CbcDiver *>(tree))
+      diver->openNodes(nodes);
+    else {
+      int size = tree->size();
+      for (int i = 0 ; i < size ; i++) {
+        CbcNode * node = tree->nodePointer(i);
+        if (node != NULL)
+          nodes.push_back(node);
+      }
+    }
+  }
+
+  /** Compute the bounds of the subproblem of node by applying the bound
+      changes recorded along the path from the last full description of the
+      bounds. Returns false if there is no such description.*/
+  static bool
+  nodeBounds(const BabCheckpoint::NodeRecords & records,
+      const BabCheckpoint::NodeRecords::Node & node, int numberColumns,
+      std::vector<double> & lower, std::vector<double> & upper)
+  {
+    typedef BabCheckpoint::NodeRecords NodeRecords;
+    std::vector<int> path;
+    int k = node.info;
+    for ( ; k >= 0 && records.infos[k].type == NodeRecords::Partial ;
+        k = records.infos[k].parent)
+      path.push_back(k);
+    if (k < 0 || records.infos[k].type != NodeRecords::Full)
+      return false;
+    const std::vector<double> & full = records.infos[k].bounds;
+    lower.assign(full.begin(), full.begin() + numberColumns);
+    upper.assign(full.begin() + numberColumns, full.end());
+    for (int i = static_cast<int>(path.size()) - 1 ; i >= 0 ; i--) {
+      const NodeRecords::Info & partial = records.infos[path[i]];
+      for (unsigned int j = 0 ; j < partial.variables.size() ; j++) {
+        // Same encoding as in CbcPartialNodeInfo::applyToModel.
+        int iColumn = partial.variables[j] & 0x3fffffff;
+        if (iColumn >= numberColumns)
+          continue;
+        if (partial.variables[j] & 0x80000000)
+          upper[iColumn] = partial.bounds[j];
+        else
+          lower[iColumn] = partial.bounds[j];
+      }
+    }
+    if (node.column >= 0 && node.column < numberColumns) {
+      lower[node.column] = std::max(lower[node.column], node.lower);
+      upper[node.column] = std::min(upper[node.column], node.upper);
+    }
+    return true;
+  }
+
+  /** Compute the warm start of node by applying the entries of the infos
+      along the path from the root, the entries of an info replace those of
+      its ancestors.*/
+  static void
+  nodeWarmStart(const BabCheckpoint::NodeRecords & records,
+      const BabCheckpoint::NodeRecords::Node & node,
+      std::vector<int> & indices, std::vector<double> & values)
+  {
+    typedef BabCheckpoint::NodeRecords NodeRecords;
+    std::vector<int> path;
+    for (int k = node.info ; k >= 0 ; k = records.infos[k].parent)
+      path.push_back(k);
+    std::map<int, double> entries;
+    for (int i = static_cast<int>(path.size()) - 1 ; i >= 0 ; i--) {
+      const NodeRecords::Info & info = records.infos[path[i]];
+      for (unsigned int j = 0 ; j < info.warmStartIndices.size() ; j++)
+        entries[info.warmStartIndices[j]] = info.warmStartValues[j];
+    }
+    indices.clear();
+    values.clear();
+    for (std::map<int, double>::iterator i = entries.begin() ; i != entries.end() ; i++) {
+      indices.push_back(i->first);
+      values.push_back(i->second);
+    }
+  }
+
+  /** Copy node infos from info up to the first one already in records
+      (indices gives the index in records of the infos copied). Returns the
+      index of info.*/
+  static int
+  recordInfos(CbcNodeInfo * info, int numberColumns, int numberRows,
+      std::map<const CbcNodeInfo *, int> & indices,
+      BabCheckpoint::NodeRecords & records)
+  {
+    typedef BabCheckpoint::NodeRecords NodeRecords;
+    std::vector<CbcNodeInfo *> path;
+    std::map<const CbcNodeInfo *, int>::iterator found = indices.end();
+    for ( ; info != NULL ; info = info->parent()) {
+      found = indices.find(info);
+      if (found != indices.end())
+        break;
+      path.push_back(info);
+    }
+    int parent = info == NULL ? -1 : found->second;
+    for (int k = static_cast<int>(path.size()) - 1 ; k >= 0 ; k--) {
+      records.infos.push_back(NodeRecords::Info());
+      NodeRecords::Info & copy = records.infos.back();
+      copy.parent = parent;
+      if (CbcFullNodeInfo * full = dynamic_cast<CbcFullNodeInfo *>(path[k])) {
+        copy.type = NodeRecords::Full;
+        copy.bounds.assign(full->lower(), full->lower() + numberColumns);
+        copy.bounds.insert(copy.bounds.end(), full->upper(), full->upper() + numberColumns);
+        // The point of the root, unless it was flushed (allBranchesGone).
+        BonCbcFullNodeInfo * bonFull = dynamic_cast<BonCbcFullNodeInfo *>(full);
+        IpoptWarmStart * warm = bonFull ? bonFull->ipoptWarmStart() : NULL;
+        if (warm != NULL && !warm->empty() && warm->primalSize() == numberColumns) {
+          copy.warmStartValues.assign(warm->primal(), warm->primal() + warm->primalSize());
+          copy.warmStartValues.insert(copy.warmStartValues.end(), warm->dual(),
+              warm->dual() + warm->dualSize());
+          for (unsigned int j = 0 ; j < copy.warmStartValues.size() ; j++)
+            copy.warmStartIndices.push_back(j);
+        }
+      }
+      else if (CbcPartialNodeInfo * partial = dynamic_cast<CbcPartialNodeInfo *>(path[k])) {
+        copy.type = NodeRecords::Partial;
+        int n = partial->numberChangedBounds();
+        copy.variables.assign(partial->variables(), partial->variables() + n);
+        copy.bounds.assign(partial->newBounds(), partial->newBounds() + n);
+        // The entries of the point of the node which differ from its parent.
+        BonCbcPartialNodeInfo * bonPartial = dynamic_cast<BonCbcPartialNodeInfo *>(partial);
+        IpoptWarmStartDiff * diff = bonPartial ? bonPartial->ipoptWarmStartDiff() : NULL;
+        if (diff != NULL)
+          diff->getEntries(numberColumns, 2 * numberColumns + numberRows,
+              copy.warmStartIndices, copy.warmStartValues);
+      }
+      else
+        copy.type = NodeRecords::Unknown;
+      parent = static_cast<int>(records.infos.size()) - 1;
+      indices[path[k]] = parent;
+    }
+    return parent;
+  }
+
+  void
+  BabCheckpoint::buildNodes(const NodeRecords & records, Snapshot & snapshot)
+  {
+    int numberColumns = snapshot.numberColumns;
+    // All the nodes are below the same root.
+    int root = -1;
+    for (unsigned int i = 0 ; i < records.infos.size() && root < 0 ; i++)
+      if (records.infos[i].parent < 0)
+        root = i;
+    if (root < 0 || records.infos[root].type != NodeRecords::Full)
+      return;
+    if (snapshot.rootLower.empty()) {
+      const std::vector<double> & rootBounds = records.infos[root].bounds;
+      snapshot.rootLower.assign(rootBounds.begin(), rootBounds.begin() + numberColumns);
+      snapshot.rootUpper.assign(rootBounds.begin() + numberColumns, rootBounds.end());
+    }
+
+    // Open nodes, as bound changes with respect to the root.
+    std::vector<double> lower;
+    std::vector<double> upper;
+    for (unsigned int i = 0 ; i < records.nodes.size() ; i++) {
+      const NodeRecords::Node & node = records.nodes[i];
+      if (!nodeBounds(records, node, numberColumns, lower, upper))
+        continue;
+      snapshot.nodes.push_back(OpenNode());
+      OpenNode & open = snapshot.nodes.back();
+      open.objectiveValue = node.objectiveValue;
+      open.depth = node.depth;
+      for (int j = 0 ; j < numberColumns ; j++) {
+        if (lower[j] != snapshot.rootLower[j] || upper[j] != snapshot.rootUpper[j]) {
+          open.columns.push_back(j);
+          open.lower.push_back(lower[j]);
+          open.upper.push_back(upper[j]);
+        }
+      }
+      nodeWarmStart(records, node, open.warmStartIndices, open.warmStartValues);
+    }
+  }
+
+  void
+  BabCheckpoint::takeSnapshot(CbcModel & model, Snapshot & snapshot,
+      NodeRecords & records)
+  {
+    OsiSolverInterface * solver = model.solver();
+    int numberColumns = solver->getNumCols();
+    int numberRows = solver->getNumRows();
+    snapshot.numberColumns = numberColumns;
+    snapshot.numberNodes = model.getNodeCount();
+    snapshot.bestPossible = model.getBestPossibleObjValue();
+    if (model.bestSolution() != NULL) {
+      snapshot.bestObjective = model.getObjValue();
+      snapshot.bestSolution.assign(model.bestSolution(), model.bestSolution() + numberColumns);
+    }
+
+    // Globally valid cuts.
+    CbcRowCuts * cuts = model.globalCuts();
+    for (int i = 0 ; cuts != NULL && i < cuts->sizeRowCuts() ; i++) {
+      const OsiRowCut * cut = cuts->rowCutPtr(i);
+      const CoinPackedVector & row = cut->row();
+      snapshot.cutIndices.insert(snapshot.cutIndices.end(), row.getIndices(),
+          row.getIndices() + row.getNumElements());
+      snapshot.cutElements.insert(snapshot.cutElements.end(), row.getElements(),
+          row.getElements() + row.getNumElements());
+      snapshot.cutStarts.push_back(static_cast<int>(snapshot.cutIndices.size()));
+      snapshot.cutLower.push_back(cut->lb());
+      snapshot.cutUpper.push_back(cut->ub());
+    }
+
+    // Open nodes, only what is needed to compute their bounds later.
+    std::vector<CbcNode *> nodes;
+    openNodes(model.tree(), nodes);
+    std::map<const CbcNodeInfo *, int> indices;
+    records.nodes.resize(nodes.size());
+    for (unsigned int i = 0 ; i < nodes.size() ; i++) {
+      CbcNode * node = nodes[i];
+      NodeRecords::Node & copy = records.nodes[i];
+      copy.objectiveValue = node->objectiveValue();
+      copy.depth = node->depth();
+      copy.info = recordInfos(node->nodeInfo(), numberColumns, numberRows, indices, records);
+      copy.column = -1;
+      copy.lower = -COIN_DBL_MAX;
+      copy.upper = COIN_DBL_MAX;
+      // If one branch of the node has already been explored, only the
+      // other one is left open (way() is the direction of the next branch).
+      const OsiTwoWayBranchingObject * branch =
+        dynamic_cast<const OsiTwoWayBranchingObject *>(node->branchingObject());
+      if (branch != NULL && branch->numberBranchesLeft() < branch->numberBranches()) {
+        const OsiSimpleInteger * integer =
+          dynamic_cast<const OsiSimpleInteger *>(branch->originalObject());
+        if (integer != NULL) {
+          copy.column = integer->columnNumber();
+          if (branch->way() < 0)
+            copy.upper = floor(branch->value());
+          else
+            copy.lower = ceil(branch->value());
+        }
+      }
+    }
+
+    // Pseudo costs.
+    BonChooseVariable * chooser = NULL;
+    if (model.branchingMethod() != NULL)
+      chooser = dynamic_cast<BonChooseVariable *>(model.branchingMethod()->chooseMethod());
+    if (chooser != NULL && chooser->solver() != NULL) {
+      snapshot.pseudoCosts = chooser->pseudoCosts();
+      snapshot.objectNames = PseudoCosts::objectNames(*chooser->solver(),
+          snapshot.pseudoCosts.numberObjects());
+    }
+  }
+
+  /** Write n values of type T.*/
+  template <class T>
+  static void
+  writeArray(std::ostream & out, const T * values, int n)
+  {
+    if (n > 0)
+      out.write(reinterpret_cast<const char *>(values), n * sizeof(T));
+  }
+
+  /** Write a vector preceded by its size.*/
+  template <class T>
+  static void
+  writeVector(std::ostream & out, const std::vector<T> & values)
+  {
+    int n = static_cast<int>(values.size());
+    writeArray(out, &n, 1);
+    writeArray(out, n > 0 ? &values[0] : NULL, n);
+  }
+
+  /** Read n values of type T.*/
+  template <class T>
+  static bool
+  readArray(std::istream & in, T * values, int n)
+  {
+    if (n > 0)
+      in.read(reinterpret_cast<char *>(values), n * sizeof(T));
+    return !in.fail();
+  }
+
+  /** Read a vector written by writeVector.*/
+  template <class T>
+  static bool
+  readVector(std::istream & in, std::vector<T> & values)
+  {
+    int n;
+    if (!readArray(in, &n, 1) || n < 0)
+      return false;
+    values.resize(n);
+    return readArray(in, n > 0 ? &values[0] : NULL, n);
+  }
+
+  bool
+  BabCheckpoint::write(const std::string & fileName, const Snapshot & snapshot)
+  {
+    std::ofstream out(fileName.c_str(), std::ios::binary | std::ios::trunc);
+    if (!out)
+      return false;
+    out.write(checkpointMagic, sizeof(checkpointMagic));
+    writeArray(out, &snapshot.numberColumns, 1);
+    writeArray(out, &snapshot.numberNodes, 1);
+    writeArray(out, &snapshot.bestObjective, 1);
+    writeArray(out, &snapshot.bestPossible, 1);
+    writeVector(out, snapshot.bestSolution);
+    writeVector(out, snapshot.rootLower);
+    writeVector(out, snapshot.rootUpper);
+
+    writeVector(out, snapshot.cutStarts);
+    writeVector(out, snapshot.cutIndices);
+    writeVector(out, snapshot.cutElements);
+    writeVector(out, snapshot.cutLower);
+    writeVector(out, snapshot.cutUpper);
+
+    int numberNodes = static_cast<int>(snapshot.nodes.size());
+    writeArray(out, &numberNodes, 1);
+    for (int i = 0 ; i < numberNodes ; i++) {
+      const OpenNode & node = snapshot.nodes[i];
+      writeArray(out, &node.objectiveValue, 1);
+      writeArray(out, &node.depth, 1);
+      writeVector(out, node.columns);
+      writeVector(out, node.lower);
+      writeVector(out, node.upper);
+      writeVector(out, node.warmStartIndices);
+      writeVector(out, node.warmStartValues);
+    }
+
+    int numberObjects = static_cast<int>(snapshot.objectNames.size());
+    writeArray(out, &numberObjects, 1);
+    for (int i = 0 ; i < numberObjects ; i++) {
+      int length = static_cast<int>(snapshot.objectNames[i].size());
+      writeArray(out, &length, 1);
+      writeArray(out, snapshot.objectNames[i].c_str(), length);
+    }
+    if (numberObjects > 0 &&
+        snapshot.pseudoCosts.write(out, snapshot.objectNames) < 0)
+      return false;
+    out.close();
+    return !out.fail();
+  }
+
+  bool
+  BabCheckpoint::read(const std::string & fileName, Snapshot & snapshot)
+  {
+    std::ifstream in(fileName.c_str(), std::ios::binary);
+    if (!in)
+      return false;
+    char magic[sizeof(checkpointMagic)];
+    in.read(magic, sizeof(magic));
+    if (!in || memcmp(magic, checkpointMagic, sizeof(magic)) != 0)
+      return false;
+    if (!readArray(in, &snapshot.numberColumns, 1) ||
+        !readArray(in, &snapshot.numberNodes, 1) ||
+        !readArray(in, &snapshot.bestObjective, 1) ||
+        !readArray(in, &snapshot.bestPossible, 1) ||
+        !readVector(in, snapshot.bestSolution) ||
+        !readVector(in, snapshot.rootLower) ||
+        !readVector(in, snapshot.rootUpper))
+      return false;
+
+    if (!readVector(in, snapshot.cutStarts) ||
+        !readVector(in, snapshot.cutIndices) ||
+        !readVector(in, snapshot.cutElements) ||
+        !readVector(in, snapshot.cutLower) ||
+        !readVector(in, snapshot.cutUpper))
+      return false;
+    int numberCuts = static_cast<int>(snapshot.cutLower.size());
+    if (snapshot.cutStarts.size() != snapshot.cutLower.size() + 1 ||
+        snapshot.cutUpper.size() != snapshot.cutLower.size() ||
+        snapshot.cutElements.size() != snapshot.cutIndices.size() ||
+        snapshot.cutStarts[numberCuts] != static_cast<int>(snapshot.cutIndices.size()))
+      return false;
+
+    int numberNodes;
+    if (!readArray(in, &numberNodes, 1) || numberNodes < 0)
+      return false;
+    snapshot.nodes.resize(numberNodes);
+    for (int i = 0 ; i < numberNodes ; i++) {
+      OpenNode & node = snapshot.nodes[i];
+      if (!readArray(in, &node.objectiveValue, 1) ||
+          !readArray(in, &node.depth, 1) ||
+          !readVector(in, node.columns) ||
+          !readVector(in, node.lower) ||
+          !readVector(in, node.upper) ||
+          !readVector(in, node.warmStartIndices) ||
+          !readVector(in, node.warmStartValues) ||
+          node.lower.size() != node.columns.size() ||
+          node.upper.size() != node.columns.size() ||
+          node.warmStartValues.size() != node.warmStartIndices.size())
+        return false;
+    }
+
+    int numberObjects;
+    if (!readArray(in, &numberObjects, 1) || numberObjects < 0)
+      return false;
+    snapshot.objectNames.resize(numberObjects);
+    for (int i = 0 ; i < numberObjects ; i++) {
+      int length;
+      if (!readArray(in, &length, 1) || length < 0 || length > (1 << 20))
+        return false;
+      snapshot.objectNames[i].resize(length);
+      if (length > 0 && !readArray(in, &snapshot.objectNames[i][0], length))
+        return false;
+    }
+    if (numberObjects > 0) {
+      snapshot.pseudoCosts.initialize(numberObjects);
+      if (snapshot.pseudoCosts.read(in, snapshot.objectNames) < 0)
+        return false;
+    }
+    return true;
+  }
+
+}/* End Bonmin namespace.*/
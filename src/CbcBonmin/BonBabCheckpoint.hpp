@@ -0,0 +1,242 @@
+// (C) Copyright Bonmin contributors 2026
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+//
+// Date : 10/19/2026
+
+#ifndef BonBabCheckpoint_H
+#define BonBabCheckpoint_H
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BonminConfig.h"
+#include "BonPseudoCosts.hpp"
+
+class CbcModel;
+class CbcNode;
+class CbcTree;
+
+namespace Bonmin
+{
+  /** Checkpoint of a branch-and-bound run.
+      A snapshot of the search (incumbent, open nodes, pseudo costs and
+      globally valid cuts) is taken on the thread doing the search every
+      interval seconds and handed over to a writer thread which writes it
+      to a file (through a temporary file, so that a crash while writing
+      leaves the previous checkpoint untouched).
+      Of the open nodes, the search thread only copies the node infos of
+      the tree (each once, see NodeRecords), the bounds and the warm starts
+      of the nodes are computed by the writer thread.
+      The snapshot read back from the file is used by Bab to resume a
+      search: each open node is searched in turn, starting from its bounds
+      and its warm start (see Bab::resumeSearch). While it does so, the
+      nodes not searched yet are part of the checkpoints (see
+      setResumeState).
+  */
+  class BONMINLIB_EXPORT BabCheckpoint
+  {
+  public:
+    /** An open node of the tree. Only the bounds which differ from the
+        bounds of the root are kept. The warm start is the entries of the
+        primal-dual point of the NLP solver known for the node (the dual
+        values come after the primal ones), the other values are those of
+        the root relaxation.*/
+    struct OpenNode
+    {
+      /** Lower bound on the objective in the node.*/
+      double objectiveValue;
+      /** Depth of the node.*/
+      int depth;
+      /** Columns whose bounds differ from the root.*/
+      std::vector<int> columns;
+      /** Lower bounds of columns.*/
+      std::vector<double> lower;
+      /** Upper bounds of columns.*/
+      std::vector<double> upper;
+      /** Positions of the entries of the warm start.*/
+      std::vector<int> warmStartIndices;
+      /** Values of the entries of the warm start.*/
+      std::vector<double> warmStartValues;
+    };
+
+    /** Everything which is saved of a search.*/
+    struct Snapshot
+    {
+      /** Default constructor.*/
+      Snapshot();
+      /** Number of columns of the problem.*/
+      int numberColumns;
+      /** Number of nodes processed.*/
+      int numberNodes;
+      /** Value of the incumbent (COIN_DBL_MAX if none).*/
+      double bestObjective;
+      /** Best known bound.*/
+      double bestPossible;
+      /** Incumbent (empty if none).*/
+      std::vector<double> bestSolution;
+      /** Bounds of the columns at the root.*/
+      std::vector<double> rootLower;
+      /** Bounds of the columns at the root.*/
+      std::vector<double> rootUpper;
+      /** Globally valid cuts, row i has its nonzeroes in
+          [cutStarts[i], cutStarts[i+1]).*/
+      std::vector<int> cutStarts;
+      /** Columns of the cut coefficients.*/
+      std::vector<int> cutIndices;
+      /** Cut coefficients.*/
+      std::vector<double> cutElements;
+      /** Lower bounds of the cuts.*/
+      std::vector<double> cutLower;
+      /** Upper bounds of the cuts.*/
+      std::vector<double> cutUpper;
+      /** Open nodes.*/
+      std::vector<OpenNode> nodes;
+      /** Pseudo costs (numberObjects() is 0 if not saved).*/
+      PseudoCosts pseudoCosts;
+      /** Name of the column of each object of pseudoCosts.*/
+      std::vector<std::string> objectNames;
+    };
+
+    /** Copy of the part of the tree needed to compute the bounds of the
+        open nodes. A node info shared by several open nodes is copied
+        once.*/
+    struct NodeRecords
+    {
+      /** Kinds of node infos.*/
+      enum InfoType {
+        Full /** Bounds of all the columns (CbcFullNodeInfo).*/,
+        Partial /** Bound changes (CbcPartialNodeInfo).*/,
+        Unknown /** Anything else, the bounds of the nodes below are not known.*/
+      };
+      /** A node info.*/
+      struct Info
+      {
+        /** Index of the parent info (-1 for the root).*/
+        int parent;
+        /** Kind of info.*/
+        InfoType type;
+        /** Changed columns, encoded as in CbcPartialNodeInfo (Partial).*/
+        std::vector<int> variables;
+        /** New bounds of the changed columns (Partial), or the lower
+            bounds followed by the upper bounds of all the columns (Full).*/
+        std::vector<double> bounds;
+        /** Positions of the entries of the Ipopt warm start of the info.*/
+        std::vector<int> warmStartIndices;
+        /** Values of the entries of the Ipopt warm start of the info.*/
+        std::vector<double> warmStartValues;
+      };
+      /** An open node.*/
+      struct Node
+      {
+        /** Lower bound on the objective in the node.*/
+        double objectiveValue;
+        /** Depth of the node.*/
+        int depth;
+        /** Index of the info of the node (-1 if none).*/
+        int info;
+        /** Column branched on in the node if one branch has been explored
+            already (-1 otherwise).*/
+        int column;
+        /** Bounds of column in the branch left.*/
+        double lower;
+        /** Bounds of column in the branch left.*/
+        double upper;
+      };
+      /** Node infos, a parent comes before its children.*/
+      std::vector<Info> infos;
+      /** Open nodes.*/
+      std::vector<Node> nodes;
+    };
+
+    /** Constructor, checkpoints of a search are written to fileName every
+        interval seconds (wallclock).*/
+    BabCheckpoint(const std::string & fileName, double interval);
+
+    /** Destructor (waits for the last snapshot to be written).*/
+    ~BabCheckpoint();
+
+    /** Called at each node by the search, takes a snapshot of model if
+        interval seconds have passed since the last one.*/
+    void nodeProcessed(CbcModel & model);
+
+    /** Take a snapshot of model and pass it to the writer thread.*/
+    void checkpoint(CbcModel & model);
+
+    /** Declare that the search of model is the one of an open node of base
+        (not owned, NULL when the search is not a resumed one): the root
+        bounds and the cuts of base are used in place of those of model, the
+        nodes of base from firstPending on whose bound is below the cutoff
+        of model are added to its open nodes and numberNodes (the nodes
+        processed before the search of model started) is added to its
+        count.*/
+    void setResumeState(const Snapshot * base, int firstPending, int numberNodes);
+
+    /** Wait for the writer thread to be idle.*/
+    void flush();
+
+    /** Number of checkpoints written.*/
+    int numberWritten() const;
+
+    /** Fill snapshot with the state of the search of model, except for the
+        open nodes which are copied to records.*/
+    static void takeSnapshot(CbcModel & model, Snapshot & snapshot,
+        NodeRecords & records);
+
+    /** Add the open nodes of records to snapshot (and take the root bounds
+        of snapshot from records if it has none).*/
+    static void buildNodes(const NodeRecords & records, Snapshot & snapshot);
+
+    /** Write snapshot to fileName. Returns false on error.*/
+    static bool write(const std::string & fileName, const Snapshot & snapshot);
+
+    /** Read snapshot from fileName. Returns false if the file can not be
+        read or is not a checkpoint.*/
+    static bool read(const std::string & fileName, Snapshot & snapshot);
+
+    /** Append the open nodes of tree to nodes.*/
+    static void openNodes(CbcTree * tree, std::vector<CbcNode *> & nodes);
+
+  private:
+    /** Copy constructor (not implemented).*/
+    BabCheckpoint(const BabCheckpoint &);
+    /** Assignment operator (not implemented).*/
+    BabCheckpoint & operator=(const BabCheckpoint &);
+
+    /** Loop of the writer thread.*/
+    void writerLoop();
+
+    /** File to which checkpoints are written.*/
+    std::string fileName_;
+    /** Seconds between two checkpoints.*/
+    double interval_;
+    /** Time of the last checkpoint.*/
+    double lastTime_;
+    /** Snapshot waiting to be written (owned, NULL if none).*/
+    Snapshot * pending_;
+    /** Open nodes of pending_ (owned).*/
+    NodeRecords * pendingRecords_;
+    /** Is the writer writing a snapshot?*/
+    bool writing_;
+    /** Set to stop the writer.*/
+    bool stop_;
+    /** Number of checkpoints written.*/
+    int numberWritten_;
+    /** Checkpoint of which the search is resumed (not owned, may be NULL).*/
+    const Snapshot * base_;
+    /** First node of base_ not searched yet.*/
+    int firstPending_;
+    /** Number of nodes processed before the search of the model.*/
+    int numberNodesBefore_;
+    /** Protects pending_, pendingRecords_, writing_, stop_ and numberWritten_.*/
+    mutable std::mutex mutex_;
+    /** Signals changes of pending_, writing_ and stop_.*/
+    std::condition_variable changed_;
+    /** Writer thread.*/
+    std::thread writer_;
+  };
+}
+#endif
@@ -14,25 +14,35 @@ namespace Bonmin
   /** Default constructor.*/
   BabInfo::BabInfo(int type):
       AuxInfo(type),
-      babPtr_(NULL)
+      babPtr_(NULL),
+      solutionPool_(new SolutionPool)
   {}
 
   /** Constructor from OsiBabSolver.*/
   BabInfo::BabInfo(const OsiBabSolver &other):
       AuxInfo(other),
-      babPtr_(NULL)
+      babPtr_(NULL),
+      solutionPool_(new SolutionPool)
   {}
 
   /** Copy constructor.*/
   BabInfo::BabInfo(const BabInfo &other):
       AuxInfo(other),
-      babPtr_(other.babPtr_)
+      babPtr_(other.babPtr_),
+      solutionPool_(other.solutionPool_)
   {}
 
   /** Destructor.*/
   BabInfo::~BabInfo()
   {}
 
+  /** Give this object (and its future copies) a new empty pool.*/
+  void
+  BabInfo::resetSolutionPool(int capacity)
+  {
+    solutionPool_ = new SolutionPool(capacity);
+  }
+
   /** Virtual copy constructor.*/
   OsiAuxInfo *
   BabInfo::clone() const
@@ -12,6 +12,7 @@
 #include <stdlib.h>
 #include "BonminConfig.h"
 #include "BonAuxInfos.hpp"
+#include "BonSolutionPool.hpp"
 
 namespace Bonmin
 {
@@ -49,9 +50,20 @@ namespace Bonmin
 
     bool hasSolution() const{
       return bestSolution_ != NULL;}
+
+    /** Pool of the best solutions found (shared by all copies).*/
+    SolutionPool & solutionPool()
+    {
+      return *solutionPool_;
+    }
+
+    /** Give this object (and its future copies) a new empty pool.*/
+    void resetSolutionPool(int capacity);
   protected:
     /** Pointer to branch-and-bound algorithm.*/
     Bab * babPtr_;
+    /** Pool of the best solutions found.*/
+    Coin::SmartPtr<SolutionPool> solutionPool_;
   };
 }/* End namespace.*/
 
@@ -0,0 +1,149 @@
+// (C) Copyright Bonmin contributors 2026
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+//
+// Date : 10/19/2026
+
+#include <algorithm>
+#include <memory>
+#include <sstream>
+#include <thread>
+
+#include "BonBatchSolver.hpp"
+#include "BonSolverContext.hpp"
+#include "BonProfiler.hpp"
+#include "CoinError.hpp"
+#include "CoinTime.hpp"
+
+extern std::atomic<bool> BonminAbortAll;
+
+namespace Bonmin
+{
+
+  BatchSolver::BatchSolver(int numberThreads, const std::string & options,
+      double memoryLimit):
+      numberThreads_(std::max(numberThreads, 1)),
+      options_("bonmin.bb_log_level 0\n"
+          "bonmin.nlp_log_level 0\n"
+          "bonmin.oa_log_level 0\n"
+          "bonmin.fp_log_level 0\n"
+          "bonmin.milp_log_level 0\n"
+          "bonmin.lp_log_level 0\n"
+          "print_level 0\n" + options + "\n"),
+      memoryLimit_(memoryLimit),
+      spillFile_(),
+      profileFile_()
+  {
+    // Read the options once here, to find the NLP solver and the files
+    // the workers would share.
+    BonminSetup setup;
+    setup.readOptionsString(options_);
+    int nlpSolver;
+    setup.options()->GetEnumValue("nlp_solver", nlpSolver, "bonmin.");
+    if (nlpSolver != 0)
+      numberThreads_ = 1;
+
+    std::string checkpointFile;
+    setup.options()->GetStringValue("checkpoint_file", checkpointFile, "bonmin.");
+    if (!checkpointFile.empty())
+      throw CoinError("checkpoint_file can not be used to solve a batch",
+          "BatchSolver", "BatchSolver");
+    setup.options()->GetStringValue("tree_spill_file", spillFile_, "bonmin.");
+    int profileFormat;
+    setup.options()->GetEnumValue("profile_format", profileFormat, "bonmin.");
+    if (profileFormat > 0) {
+      setup.options()->GetStringValue("profile_file", profileFile_, "bonmin.");
+      if (profileFile_.empty())
+        throw CoinError("profile_format needs a profile_file to solve a batch",
+            "BatchSolver", "BatchSolver");
+    }
+  }
+
+  BatchSolver::~BatchSolver()
+  {}
+
+  std::vector<BatchSolver::Result>
+  BatchSolver::solve(const std::vector<Ipopt::SmartPtr<TMINLP> > & models)
+  {
+    // An interruption of a previous batch or search does not stop this one.
+    Bab::SearchScope scope;
+    std::vector<Result> results(models.size());
+    std::atomic<size_t> next(0);
+    bool profile = Profiler::enabled();
+    int numberWorkers = static_cast<int>(std::min<size_t>(numberThreads_, models.size()));
+    std::vector<std::thread> workers;
+    for (int k = 0 ; k < numberWorkers ; k++)
+      workers.push_back(std::thread(&BatchSolver::work, this, k, std::cref(models),
+          std::ref(results), std::ref(next), profile));
+    for (int k = 0 ; k < numberWorkers ; k++)
+      workers[k].join();
+    return results;
+  }
+
+  void
+  BatchSolver::work(int worker, const std::vector<Ipopt::SmartPtr<TMINLP> > & models,
+      std::vector<Result> & results, std::atomic<size_t> & next,
+      bool profile) const
+  {
+    Profiler::setEnabled(profile);
+    std::ostringstream options;
+    options << options_
+            << "bonmin.tree_spill_file " << spillFile_ << "." << worker << "\n";
+    if (memoryLimit_ > 0.)
+      options << "bonmin.tree_memory_limit " << memoryLimit_ << "\n";
+
+    // The context (and so the registered options) is built by the thread
+    // that uses it.
+    std::unique_ptr<SolverContext> context;
+    for (size_t i = next++ ; i < models.size() && !BonminAbortAll ; i = next++) {
+      Result & result = results[i];
+      double start = CoinGetTimeOfDay();
+      Profiler::reset();
+      try {
+        if (context.get() == NULL)
+          context.reset(new SolverContext(options.str()));
+        if (!profileFile_.empty()) {
+          std::ostringstream profileFile;
+          profileFile << profileFile_ << "." << i;
+          context->setup().options()->SetStringValue("bonmin.profile_file",
+              profileFile.str(), true, true);
+        }
+        result.status = context->solve(models[i]);
+        result.bestObj = context->bestObj();
+        result.bestBound = context->bestBound();
+        result.numNodes = context->numNodes();
+        if (context->bestSolution() != NULL) {
+          int n = context->setup().nonlinearSolver()->getNumCols();
+          result.solution.assign(context->bestSolution(), context->bestSolution() + n);
+        }
+        result.error.clear();
+      }
+      catch (TNLPSolver::UnsolvedError * E) {
+        std::ostringstream os;
+        E->printError(os);
+        result.error = os.str();
+        delete E;
+      }
+      catch (OsiTMINLPInterface::SimpleError & E) {
+        result.error = E.className() + "::" + E.methodName() + " " + E.message();
+      }
+      catch (CoinError & E) {
+        result.error = E.className() + "::" + E.methodName() + " " + E.message();
+      }
+      catch (Ipopt::IpoptException & E) {
+        result.error = "Ipopt exception : " + E.Message();
+      }
+      catch (...) {
+        // An exception must not leave the thread.
+        result.error = "unrecognized exception";
+      }
+      if (!result.error.empty()) {
+        // The context may be left in any state by the failure, start again.
+        context.reset();
+      }
+      result.time = CoinGetTimeOfDay() - start;
+      result.nlpSolves = Profiler::count(Profiler::NlpSolve) +
+          Profiler::count(Profiler::FeasibilityNlpSolve);
+    }
+  }
+}
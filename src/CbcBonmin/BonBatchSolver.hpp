@@ -0,0 +1,127 @@
+// (C) Copyright Bonmin contributors 2026
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+//
+// Date : 10/19/2026
+
+#ifndef BonBatchSolver_H
+#define BonBatchSolver_H
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include "BonminConfig.h"
+#include "BonCbc.hpp"
+#include "BonTMINLP.hpp"
+
+namespace Bonmin
+{
+  /** Solves a batch of independent MINLPs on several threads.
+      Each worker thread has its own SolverContext (options, registered
+      options, NLP solver) and solves the models handed to it one after the
+      other; a model is given to the first idle worker. The memory of a
+      worker is the one of the branch-and-bound it is running (only the
+      results are kept), memoryLimit further bounds the tree of each
+      branch-and-bound (see option tree_memory_limit).
+      The files of the options are made per worker or per model: worker k
+      spills warm starts to tree_spill_file.k and the profile of model i is
+      written to profile_file.i. Checkpoints (checkpoint_file) are of one
+      search and can not be used with a batch.
+      The models must be distinct objects that can be evaluated at the same
+      time by different threads; AMPL models can not (the ASL library is not
+      re-entrant). FilterSQP is not re-entrant either: with nlp_solver
+      filterSQP the batch is solved by one worker.
+      When BonminAbortAll is raised (Ctrl-C), the running solves stop and no
+      new one is started; it is cleared when the next batch or search starts
+      (see Bab::SearchScope).
+      The NLP solves of the workers run at the same time: with Ipopt this is
+      safe only if its linear solver is thread safe. MUMPS is not; the MUMPS
+      interface of Ipopt 3.14 and later serializes the calls to it, older
+      ones do not, and a batch with several threads must then use a thread
+      safe linear solver (option linear_solver) or one thread.
+      The Profiler is per thread: if it is on in the thread calling solve(),
+      it is turned on in the workers too and the counts of each solve are
+      in its Result.*/
+  class BONMINLIB_EXPORT BatchSolver
+  {
+  public:
+    /** Result of the solve of one model.*/
+    struct Result
+    {
+      /** Status of the branch-and-bound.*/
+      Bab::MipStatuses status;
+      /** Objective value of the best solution.*/
+      double bestObj;
+      /** Best bound.*/
+      double bestBound;
+      /** Number of nodes.*/
+      int numNodes;
+      /** Number of NLP solves (only counted if profiling is on in the
+          thread calling solve(), see Profiler).*/
+      long long nlpSolves;
+      /** Wallclock time of the solve (in seconds).*/
+      double time;
+      /** Best solution (empty if none).*/
+      std::vector<double> solution;
+      /** Why the solve failed (empty if it did not, the model was not
+          solved when it is "not solved").*/
+      std::string error;
+
+      /** Constructor.*/
+      Result():
+          status(Bab::NoSolutionKnown),
+          bestObj(COIN_DBL_MAX),
+          bestBound(-COIN_DBL_MAX),
+          numNodes(0),
+          nlpSolves(0),
+          time(0.),
+          solution(),
+          error("not solved")
+      {}
+    };
+
+    /** Constructor, options are given in the syntax of bonmin.opt (the log
+        levels are 0 unless options set them), memoryLimit is in MB (0 for
+        no limit). Throws a CoinError if options set checkpoint_file, or
+        profile_format without profile_file.*/
+    BatchSolver(int numberThreads, const std::string & options = "",
+        double memoryLimit = 0.);
+
+    /** Destructor.*/
+    ~BatchSolver();
+
+    /** Solve models, the results are in the order of the models.*/
+    std::vector<Result> solve(const std::vector<Ipopt::SmartPtr<TMINLP> > & models);
+
+    /** Number of worker threads.*/
+    int numberThreads() const
+    {
+      return numberThreads_;
+    }
+
+  private:
+    /** Copy constructor (not implemented).*/
+    BatchSolver(const BatchSolver &);
+    /** Assignment operator (not implemented).*/
+    BatchSolver & operator=(const BatchSolver &);
+
+    /** Body of worker: solve the models from next on until there are no
+        more.*/
+    void work(int worker, const std::vector<Ipopt::SmartPtr<TMINLP> > & models,
+        std::vector<Result> & results, std::atomic<size_t> & next,
+        bool profile) const;
+
+    /** Number of worker threads.*/
+    int numberThreads_;
+    /** Options of the workers.*/
+    std::string options_;
+    /** Bound on the memory of the tree of each branch-and-bound (in MB).*/
+    double memoryLimit_;
+    /** Spill file of the options (made per worker).*/
+    std::string spillFile_;
+    /** Profile file of the options (made per model, empty if none).*/
+    std::string profileFile_;
+  };
+}
+#endif
@@ -8,16 +8,29 @@
 // Date : 04/19/2007
 
 
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iostream>
+#include <memory>
+
 #include "BonCbc.hpp"
+#include "BonBabCheckpoint.hpp"
+#include "BonTreeMemoryLimit.hpp"
+#include "BonProfiler.hpp"
 #include "BonOACutGenerator2.hpp"
+#include "BonOuterDescriptionCuts.hpp"
 #include "BonCbcNlpStrategy.hpp"
 #include "BonBabInfos.hpp"
+#include "BonIpoptWarmStart.hpp"
 #include "CbcModel.hpp"
 #include "CbcBranchActual.hpp"
 #include "CbcCutGenerator.hpp"
 #include "CbcCompareActual.hpp"
 #include "CbcCompareObjective.hpp"
 #include "CbcCompareEstimate.hpp"
+#include "CbcEventHandler.hpp"
+#include "CoinTime.hpp"
 
 #include "BonExitCodes.hpp"
 
@@ -30,11 +43,13 @@
 // sets cutoff a bit above real one, to avoid single-point feasible sets
 #define CUTOFF_TOL 1e-6
 
-// Code to enable user interuption
-static CbcModel * currentBranchModel = NULL; //pointer to the main b&b
-BONMINLIB_EXPORT Bonmin::OACutGenerator2 * currentOA = NULL; //pointer to the OA generator
-BONMINLIB_EXPORT CbcModel * OAModel; // pointer to the submip if using Cbc
-bool BonminAbortAll;
+// Code to enable user interuption: the signal handler only raises this flag,
+// the running branch-and-bounds (of all threads) stop at their next node and
+// the NLP solvers at their next iteration.
+std::atomic<bool> BonminAbortAll(false);
+
+/** Number of searches running (see Bab::SearchScope).*/
+static std::atomic<int> BonminNumberSearches(0);
 
 #define SIGNAL
 #ifdef SIGNAL
@@ -43,19 +58,12 @@ bool BonminAbortAll;
 extern "C"
 {
 
-  static bool BonminInteruptedOnce =false;
+  static std::atomic<bool> BonminInteruptedOnce(false);
   static void signal_handler(int whichSignal) {
     if (BonminInteruptedOnce) {
       std::cerr<<"User forced interuption"<<std::endl;
       exit(0);
     }
-    if (currentBranchModel!=NULL)
-      currentBranchModel->sayEventHappened(); // stop at next node
-    if (OAModel!=NULL)
-      OAModel->sayEventHappened(); // stop at next node
-    if (currentOA!=NULL)
-      currentOA->parameter().maxLocalSearchTime_ = 0.; // stop OA
-     
     BonminAbortAll = true;
     BonminInteruptedOnce = true;
     return;
@@ -66,6 +74,114 @@ extern "C"
 namespace Bonmin
 {
 
+  /** Reports of the Profiler during a branch-and-bound: every interval
+      seconds (if interval is positive) and when destroyed. Profiling is on
+      for the thread running the search during the life of the object.*/
+  class BabProfileReport
+  {
+  public:
+    BabProfileReport(Profiler::Format format, const std::string & fileName,
+        double interval):
+        format_(format),
+        file_(),
+        interval_(interval),
+        start_(CoinGetTimeOfDay()),
+        last_(start_)
+    {
+      if (!fileName.empty())
+        file_.open(fileName.c_str());
+      Profiler::reset();
+      Profiler::setEnabled(true);
+    }
+
+    ~BabProfileReport()
+    {
+      report();
+      Profiler::setEnabled(false);
+    }
+
+    /** Called at each node by the search.*/
+    void nodeProcessed()
+    {
+      if (interval_ <= 0.)
+        return;
+      double now = CoinGetTimeOfDay();
+      if (now - last_ < interval_)
+        return;
+      last_ = now;
+      report();
+    }
+
+    /** Write a report (to std::cout if the file could not be opened).*/
+    void report()
+    {
+      std::ostream & os = file_.is_open() ? static_cast<std::ostream &>(file_) : std::cout;
+      Profiler::report(os, format_, CoinGetTimeOfDay() - start_);
+    }
+
+  private:
+    /** Format of the reports.*/
+    Profiler::Format format_;
+    /** File of the reports.*/
+    std::ofstream file_;
+    /** Seconds between two reports (0 for a report at the end only).*/
+    double interval_;
+    /** Start of profiling.*/
+    double start_;
+    /** Time of the last report.*/
+    double last_;
+  };
+
+  /** Calls the checkpoint, the memory limit of the tree and the profile
+      report of a Bab at each node (CbcModel has only one event handler),
+      stops the search when BonminAbortAll is raised.*/
+  class BabEventHandler : public CbcEventHandler
+  {
+  public:
+    BabEventHandler(BabCheckpoint * checkpoint, TreeMemoryLimit * memoryLimit,
+        BabProfileReport * profileReport):
+        CbcEventHandler(),
+        checkpoint_(checkpoint),
+        memoryLimit_(memoryLimit),
+        profileReport_(profileReport)
+    {}
+
+    BabEventHandler(const BabEventHandler & other):
+        CbcEventHandler(other),
+        checkpoint_(other.checkpoint_),
+        memoryLimit_(other.memoryLimit_),
+        profileReport_(other.profileReport_)
+    {}
+
+    virtual CbcEventHandler * clone() const
+    {
+      return new BabEventHandler(*this);
+    }
+
+    virtual CbcAction event(CbcEvent whichEvent)
+    {
+      if (whichEvent == treeStatus && model_ != NULL) {
+        if (memoryLimit_ != NULL)
+          memoryLimit_->nodeProcessed(*model_);
+        if (checkpoint_ != NULL)
+          checkpoint_->nodeProcessed(*model_);
+        if (profileReport_ != NULL)
+          profileReport_->nodeProcessed();
+        if (BonminAbortAll)
+          return stop;
+      }
+      return noAction;
+    }
+
+  private:
+    /** Checkpoint to trigger (not owned, may be NULL).*/
+    BabCheckpoint * checkpoint_;
+    /** Memory limit of the tree (not owned, may be NULL).*/
+    TreeMemoryLimit * memoryLimit_;
+    /** Profile report (not owned, may be NULL).*/
+    BabProfileReport * profileReport_;
+  };
+
   /** Constructor.*/
   Bab::Bab():
       bestSolution_(NULL),
@@ -100,12 +216,43 @@ namespace Bonmin
     branchAndBound(s);
   }
 
+  Bab::SearchScope::SearchScope()
+  {
+    if (BonminNumberSearches++ == 0) {
+      BonminAbortAll = false;
+#ifdef SIGNAL
+      BonminInteruptedOnce = false;
+#endif
+    }
+  }
+
+  Bab::SearchScope::~SearchScope()
+  {
+    BonminNumberSearches--;
+  }
+
   /** Perform a branch-and-bound on given setup.*/
   void
   Bab::branchAndBound(BabSetupBase & s)
   {
+    SearchScope scope;
 
     double remaining_time = s.getDoubleParameter(BabSetupBase::MaxTime) + CoinCpuTime();
+
+    // Profile of the hot paths (an enclosing search may already profile).
+    std::unique_ptr<BabProfileReport> profileReport;
+    {
+      int format;
+      s.options()->GetEnumValue("profile_format", format, s.prefix());
+      if (format > 0 && !Profiler::enabled()) {
+        std::string fileName;
+        double interval;
+        s.options()->GetStringValue("profile_file", fileName, s.prefix());
+        s.options()->GetNumericValue("profile_interval", interval, s.prefix());
+        profileReport.reset(new BabProfileReport(static_cast<Profiler::Format>(format - 1),
+                                                 fileName, interval));
+      }
+    }
     /* Put a link to this into solver.*/
     OsiBabSolver *  babInfo = dynamic_cast<OsiBabSolver *>(s.continuousSolver()->getAuxiliaryInfo());
     assert(babInfo);
@@ -117,6 +264,12 @@ namespace Bonmin
       bonBabInfoPtr = dynamic_cast<Bonmin::BabInfo*>(s.continuousSolver()->getAuxiliaryInfo());
     }
     bonBabInfoPtr->setBabPtr(this);
+    {
+      // A new pool, copies of babInfo made by an enclosing search keep theirs.
+      int poolSize;
+      s.options()->GetIntegerValue("solution_pool_size", poolSize, s.prefix());
+      bonBabInfoPtr->resetSolutionPool(poolSize);
+    }
 
     s.nonlinearSolver()->solver()->setup_global_time_limit(s.getDoubleParameter(BabSetupBase::MaxTime));
     OsiSolverInterface * solver = s.continuousSolver()->clone();
@@ -142,6 +295,17 @@ namespace Bonmin
       }
     }
 
+    // Bound on the memory of the tree and checkpoints, the warm starts can
+    // only be spilled and saved from Bonmin's node informations.
+    double treeMemoryLimit;
+    s.options()->GetNumericValue("tree_memory_limit", treeMemoryLimit, s.prefix());
+    std::string checkpointFile;
+    s.options()->GetStringValue("checkpoint_file", checkpointFile, s.prefix());
+    if ((treeMemoryLimit > 0. || !checkpointFile.empty()) && model_.strategy() == NULL) {
+      CbcNodeInfoStrategy strat;
+      model_.setStrategy(strat);
+    }
+
     model_.setMaximumCutPasses(s.getIntParameter(BabSetupBase::NumCutPasses));
     model_.setMaximumCutPassesAtRoot(s.getIntParameter(BabSetupBase::NumCutPassesAtRoot));
 
@@ -432,14 +596,22 @@ namespace Bonmin
       }
     }
 
+    // Checkpoints of the search and restart from a previous one.
+    BabCheckpoint::Snapshot restart;
+    bool restarting = false;
+    if (!checkpointFile.empty()) {
+      s.options()->GetBoolValue("checkpoint_restart", restarting, s.prefix());
+      if (restarting)
+        restarting = restoreCheckpoint(checkpointFile, restart);
+    }
+
 #ifdef SIGNAL
     //CoinSighandler_t saveSignal=SIG_DFL;
     // register signal handler  FIXME restore original signal handler when finished
     /*saveSignal =*/ signal(SIGINT,signal_handler);
 #endif
 
-    currentBranchModel = &model_;
-
+    bool resumed = false;
 
     try {
     //Get the time and start.
@@ -517,12 +689,74 @@ namespace Bonmin
 #endif 
     }
 
+    if (restarting && !restart.bestSolution.empty())
+      model_.setBestSolution(&restart.bestSolution[0], restart.numberColumns,
+                             restart.bestObjective);
+    if (restarting && restart.pseudoCosts.numberObjects() > 0 &&
+        model_.branchingMethod() != NULL) {
+      BonChooseVariable * chooser =
+        dynamic_cast<BonChooseVariable *>(model_.branchingMethod()->chooseMethod());
+      if (chooser)
+        chooser->setInitialPseudoCosts(restart.pseudoCosts, restart.objectNames);
+    }
+    std::unique_ptr<BabCheckpoint> checkpoint;
+    if (!checkpointFile.empty()) {
+      double interval;
+      s.options()->GetNumericValue("checkpoint_interval", interval, s.prefix());
+      checkpoint.reset(new BabCheckpoint(checkpointFile, interval));
+    }
+    std::unique_ptr<TreeMemoryLimit> memoryLimit;
+    if (treeMemoryLimit > 0.) {
+      std::string spillFile;
+      s.options()->GetStringValue("tree_spill_file", spillFile, s.prefix());
+      memoryLimit.reset(new TreeMemoryLimit(treeMemoryLimit * 1048576., spillFile));
+    }
+    {
+      BabEventHandler handler(checkpoint.get(), memoryLimit.get(), profileReport.get());
+      model_.passInEventHandler(&handler);
+    }
+
     // to get node parent info in Cbc, pass parameter 3.
     //model_.branchAndBound(3);
     remaining_time -= CoinCpuTime();
     model_.setDblParam(CbcModel::CbcMaximumSeconds, remaining_time);
-    if(remaining_time > 0.)
-      model_.branchAndBound();
+    if(remaining_time > 0.) {
+      if (restarting && !restart.nodes.empty()) {
+        resumeSearch(restart, checkpoint.get(), remaining_time);
+        resumed = true;
+      }
+      else
+        model_.branchAndBound();
+    }
+    if (checkpoint.get() != NULL) {
+      checkpoint->flush();
+      if(modelHandler_->logLevel() >= 1)
+        *modelHandler_ << "Wrote" << checkpoint->numberWritten() << "checkpoints to"
+                       << checkpointFile << CoinMessageEol;
+    }
+    if (memoryLimit.get() != NULL && modelHandler_->logLevel() >= 1) {
+      *modelHandler_ << "Spilled" << memoryLimit->numberSpilled()
+                     << "warm starts, at most" << static_cast<double>(memoryLimit->maxBytesSpilled())
+                     << "bytes on disk" << CoinMessageEol;
+      if (memoryLimit->switchedToDepthFirst())
+        *modelHandler_ << "Switched to depth first search to stay under tree_memory_limit"
+                       << CoinMessageEol;
+    }
+    // Quality of the outer description of the nonlinear constraints.
+    for (int j = 0 ; j < model_.numberCutGenerators() && modelHandler_->logLevel() >= 1 ; j++) {
+      OuterDescriptionCuts * outer =
+        dynamic_cast<OuterDescriptionCuts *>(model_.cutGenerator(j)->generator());
+      if (outer == NULL)
+        continue;
+      *modelHandler_ << "Outer description cuts:" << outer->numCuts()
+                     << "tangents, largest error bound" << outer->maxErrorBound()
+                     << CoinMessageEol;
+      const std::vector<int> & rows = outer->nonLinearRows();
+      for (unsigned int k = 0 ; k < rows.size() && modelHandler_->logLevel() >= 2 ; k++)
+        *modelHandler_ << "Constraint" << rows[k] << ":" << outer->numBreakpoints(rows[k])
+                       << "breakpoints, error bound" << outer->errorBound(rows[k])
+                       << CoinMessageEol;
+    }
     }
     }
     catch(TNLPSolver::UnsolvedError *E){
@@ -533,10 +767,20 @@ namespace Bonmin
       throw E;
    
     }
-    numNodes_ = model_.getNodeCount();
+    // Keep what branching has learned for the next runs on the same model.
+    if (model_.branchingMethod() != NULL) {
+      BonChooseVariable * chooser =
+        dynamic_cast<BonChooseVariable *>(model_.branchingMethod()->chooseMethod());
+      if (chooser)
+        chooser->writePseudoCosts();
+    }
+
     bestObj_ = model_.getObjValue();
-    bestBound_ = model_.getBestPossibleObjValue();
-    mipIterationCount_ = model_.getIterationCount();
+    if (!resumed) {
+      numNodes_ = model_.getNodeCount();
+      bestBound_ = model_.getBestPossibleObjValue();
+      mipIterationCount_ = model_.getIterationCount();
+    }
 
     bool hasFailed = false;
     if (specOpt==16)//Did we continue branching on a failure
@@ -690,6 +934,148 @@ namespace Bonmin
 }
 
 
+  bool
+  Bab::restoreCheckpoint(const std::string & fileName, BabCheckpoint::Snapshot & snapshot)
+  {
+    OsiSolverInterface * solver = model_.solver();
+    if (!BabCheckpoint::read(fileName, snapshot) ||
+        snapshot.numberColumns != solver->getNumCols()) {
+      *modelHandler_ << "Could not restart from checkpoint" << fileName
+                     << CoinMessageEol;
+      return false;
+    }
+
+    // Cuts were globally valid, put them in the root problem.
+    int numberCuts = static_cast<int>(snapshot.cutLower.size());
+    if (numberCuts > 0) {
+      OsiCuts cuts;
+      for (int i = 0 ; i < numberCuts ; i++) {
+        OsiRowCut cut;
+        int start = snapshot.cutStarts[i];
+        cut.setRow(snapshot.cutStarts[i + 1] - start, &snapshot.cutIndices[start],
+                   &snapshot.cutElements[start]);
+        cut.setLb(snapshot.cutLower[i]);
+        cut.setUb(snapshot.cutUpper[i]);
+        cuts.insert(cut);
+      }
+      std::vector<const OsiRowCut *> mycuts(numberCuts);
+      for (int i = 0 ; i < numberCuts ; i++)
+        mycuts[i] = cuts.rowCutPtr(i);
+      solver->applyRowCuts(numberCuts, &mycuts[0]);
+    }
+
+    *modelHandler_ << "Restarting from checkpoint" << fileName << "after"
+                   << snapshot.numberNodes << "nodes with"
+                   << static_cast<int>(snapshot.nodes.size())
+                   << "open nodes and" << numberCuts << "cuts" << CoinMessageEol;
+    return true;
+  }
+
+  /** Orders open nodes by increasing bound.*/
+  static bool
+  smallerBound(const BabCheckpoint::OpenNode & a, const BabCheckpoint::OpenNode & b)
+  {
+    return a.objectiveValue < b.objectiveValue;
+  }
+
+  void
+  Bab::resumeSearch(BabCheckpoint::Snapshot & snapshot, BabCheckpoint * checkpoint,
+      double maxTime)
+  {
+    // Cbc can not be given back its tree: each open node is the root of a
+    // branch-and-bound of model_, which keeps the incumbent (and so the
+    // cutoff) from one to the next.
+    OsiSolverInterface * solver = model_.solver();
+    int numberColumns = solver->getNumCols();
+    std::vector<double> rootLower(solver->getColLower(), solver->getColLower() + numberColumns);
+    std::vector<double> rootUpper(solver->getColUpper(), solver->getColUpper() + numberColumns);
+    // The warm start of a node is the point of the root relaxation with the
+    // entries saved for the node.
+    std::unique_ptr<CoinWarmStart> rootWarmStart(solver->getWarmStart());
+    IpoptWarmStart * rootPoint = dynamic_cast<IpoptWarmStart *>(rootWarmStart.get());
+    if (rootPoint != NULL && (rootPoint->empty() || rootPoint->primalSize() != numberColumns))
+      rootPoint = NULL;
+
+    std::stable_sort(snapshot.nodes.begin(), snapshot.nodes.end(), smallerBound);
+    int maximumNodes = model_.getMaximumNodes();
+    double start = CoinCpuTime();
+    int numberNodes = 0;
+    int numberIterations = 0;
+    bool searched = false;
+    bool stopped = false;
+    double bound = COIN_DBL_MAX;
+    unsigned int i = 0;
+    for ( ; i < snapshot.nodes.size() ; i++) {
+      const BabCheckpoint::OpenNode & node = snapshot.nodes[i];
+      if (node.objectiveValue >= model_.getCutoff())
+        continue;
+      double timeLeft = maxTime - (CoinCpuTime() - start);
+      if (timeLeft <= 0. || numberNodes >= maximumNodes || BonminAbortAll) {
+        stopped = true;
+        break;
+      }
+
+      solver->setColLower(&rootLower[0]);
+      solver->setColUpper(&rootUpper[0]);
+      for (unsigned int k = 0 ; k < node.columns.size() ; k++) {
+        int iColumn = node.columns[k];
+        if (iColumn < 0 || iColumn >= numberColumns)
+          continue;
+        solver->setColLower(iColumn, std::max(rootLower[iColumn], node.lower[k]));
+        solver->setColUpper(iColumn, std::min(rootUpper[iColumn], node.upper[k]));
+      }
+      if (rootPoint != NULL && !node.warmStartIndices.empty()) {
+        int primalSize = rootPoint->primalSize();
+        int dualSize = rootPoint->dualSize();
+        std::vector<double> point(rootPoint->primal(), rootPoint->primal() + primalSize);
+        point.insert(point.end(), rootPoint->dual(), rootPoint->dual() + dualSize);
+        for (unsigned int k = 0 ; k < node.warmStartIndices.size() ; k++) {
+          int index = node.warmStartIndices[k];
+          if (index >= 0 && index < primalSize + dualSize)
+            point[index] = node.warmStartValues[k];
+        }
+        IpoptWarmStart warmStart(primalSize, dualSize, &point[0], &point[0] + primalSize);
+        solver->setWarmStart(&warmStart);
+      }
+
+      if (checkpoint != NULL)
+        checkpoint->setResumeState(&snapshot, i + 1, snapshot.numberNodes + numberNodes);
+      model_.setMaximumNodes(maximumNodes - numberNodes);
+      model_.setDblParam(CbcModel::CbcMaximumSeconds, timeLeft);
+      model_.branchAndBound();
+      searched = true;
+      numberNodes += model_.getNodeCount();
+      numberIterations += model_.getIterationCount();
+      if (model_.status() != 0) {
+        // Stopped on a limit, what is left of the node is in the bound.
+        bound = model_.getBestPossibleObjValue();
+        i++;
+        break;
+      }
+    }
+    if (checkpoint != NULL)
+      checkpoint->setResumeState(NULL, 0, 0);
+    if (stopped)
+      model_.setProblemStatus(BonminAbortAll ? 5 : 1);
+    else if (!searched)
+      model_.setProblemStatus(0);
+
+    // The nodes not searched are still open.
+    double cutoff = model_.getCutoff();
+    for ( ; i < snapshot.nodes.size() ; i++)
+      if (snapshot.nodes[i].objectiveValue < cutoff)
+        bound = std::min(bound, snapshot.nodes[i].objectiveValue);
+    solver->setColLower(&rootLower[0]);
+    solver->setColUpper(&rootUpper[0]);
+    model_.setMaximumNodes(maximumNodes);
+
+    numNodes_ = numberNodes;
+    mipIterationCount_ = numberIterations;
+    bestBound_ = std::min(bound, model_.getObjValue());
+    *modelHandler_ << "Searched" << numberNodes << "nodes from the open nodes of the checkpoint"
+                   << CoinMessageEol;
+  }
+
   /** return the best known lower bound on the objective value*/
   double
   Bab::bestBound()
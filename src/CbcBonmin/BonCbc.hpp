@@ -13,6 +13,7 @@
 //#include "BonBabSetupBase.hpp"
 #include "BonminConfig.h"
 #include "CbcModel.hpp"
+#include "BonBabCheckpoint.hpp"
 
 namespace Bonmin
 {
@@ -29,6 +30,25 @@ namespace Bonmin
         NumMipStats};
 
 
+    /** Marks a search as running for its lifetime. The first one started
+        when no other runs clears BonminAbortAll (the interruption of a
+        previous search); the others leave it so that an interruption
+        reaches all the running searches. branchAndBound opens one, so
+        does BatchSolver::solve for the whole batch.*/
+    class BONMINLIB_EXPORT SearchScope
+    {
+    public:
+      /** Constructor.*/
+      SearchScope();
+      /** Destructor.*/
+      ~SearchScope();
+    private:
+      /** Copy constructor (not implemented).*/
+      SearchScope(const SearchScope &);
+      /** Assignment operator (not implemented).*/
+      SearchScope & operator=(const SearchScope &);
+    };
+
     /** Constructor.*/
     Bab();
     /** destructor.*/
@@ -98,6 +118,20 @@ namespace Bonmin
     }
 
   protected:
+    /** Read the checkpoint in fileName into snapshot and add its cuts to
+        the problem of model_.
+        Returns false if the checkpoint can not be used.*/
+    bool restoreCheckpoint(const std::string & fileName, BabCheckpoint::Snapshot & snapshot);
+
+    /** Search the open nodes of snapshot, best bound first, each with a
+        branch-and-bound of model_ from its bounds and warm start which
+        shares the incumbent and cutoff of the previous ones. The node
+        limit of model_ and maxTime seconds bound the whole search, the
+        checkpoints taken meanwhile still hold the nodes left.
+        Sets numNodes_, bestBound_ and mipIterationCount_.*/
+    void resumeSearch(BabCheckpoint::Snapshot & snapshot, BabCheckpoint * checkpoint,
+                      double maxTime);
+
     /** Stores the solution of MIP. */
     double * bestSolution_;
 
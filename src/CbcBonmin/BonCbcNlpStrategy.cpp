@@ -169,4 +169,59 @@ namespace Bonmin
   void
   CbcNlpStrategy::setupOther(CbcModel &model)
   {}
+
+  /****************************************************************************************************/
+
+  CbcNodeInfoStrategy::CbcNodeInfoStrategy()
+      :
+      CbcStrategy()
+  {
+    setPreProcessState(0);
+  }
+
+  CbcNodeInfoStrategy::CbcNodeInfoStrategy(const CbcNodeInfoStrategy & rhs)
+      :
+      CbcStrategy(rhs)
+  {}
+
+  CbcNodeInfoStrategy::~CbcNodeInfoStrategy ()
+  {}
+
+  CbcStrategy *
+  CbcNodeInfoStrategy::clone() const
+  {
+    return new CbcNodeInfoStrategy(*this);
+  }
+
+  CbcNodeInfo *
+  CbcNodeInfoStrategy::fullNodeInfo(CbcModel * model,int numberRowsAtContinuous) const
+  {
+    return new BonCbcFullNodeInfo(model,numberRowsAtContinuous);
+  }
+
+  CbcNodeInfo *
+  CbcNodeInfoStrategy::partialNodeInfo(CbcModel * model, CbcNodeInfo * parent, CbcNode * owner,
+      int numberChangedBounds,const int * variables,
+      const double * boundChanges,
+      const CoinWarmStartDiff *basisDiff) const
+  {
+    return new BonCbcPartialNodeInfo(model,parent, owner, numberChangedBounds, variables,
+        boundChanges,basisDiff);
+  }
+
+  void
+  CbcNodeInfoStrategy::setupCutGenerators(CbcModel &model)
+  {}
+
+  void
+  CbcNodeInfoStrategy::setupHeuristics(CbcModel &model)
+  {}
+
+  void
+  CbcNodeInfoStrategy::setupPrinting(CbcModel &model, int toto)
+  {}
+
+  void
+  CbcNodeInfoStrategy::setupOther(CbcModel &model)
+  {}
 }
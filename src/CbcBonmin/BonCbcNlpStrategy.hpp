@@ -94,6 +94,46 @@ namespace Bonmin
     CbcNlpStrategy & operator=(const CbcNlpStrategy& rhs);
 
   };
+
+  /** Strategy which only makes Cbc use Bonmin's node information classes
+      (BonCbcFullNodeInfo and BonCbcPartialNodeInfo), everything else is left
+      to Cbc.*/
+  class BONMINLIB_EXPORT CbcNodeInfoStrategy : public CbcStrategy
+  {
+  public:
+    // Default Constructor
+    CbcNodeInfoStrategy ();
+
+    // Copy constructor
+    CbcNodeInfoStrategy ( const CbcNodeInfoStrategy &);
+
+    // Destructor
+    virtual ~CbcNodeInfoStrategy ();
+
+    /// Clone
+    virtual CbcStrategy * clone() const;
+
+    /// Return a new Full node information pointer (descendant of CbcFullNodeInfo)
+    virtual CbcNodeInfo * fullNodeInfo(CbcModel * model,int numberRowsAtContinuous) const;
+    /// Return a new Partial node information pointer (descendant of CbcPartialNodeInfo)
+    virtual CbcNodeInfo * partialNodeInfo(CbcModel * model, CbcNodeInfo * parent, CbcNode * owner,
+        int numberChangedBounds,const int * variables,
+        const double * boundChanges,
+        const CoinWarmStartDiff *basisDiff) const;
+
+    /// Setup cut generators
+    virtual void setupCutGenerators(CbcModel & model);
+    /// Setup heuristics
+    virtual void setupHeuristics(CbcModel & model);
+    /// Do printing stuff
+    virtual void setupPrinting(CbcModel & model,int modelLogLevel);
+    /// Other stuff e.g. strong branching and preprocessing
+    virtual void setupOther(CbcModel & model);
+
+  private:
+    /// Illegal Assignment operator
+    CbcNodeInfoStrategy & operator=(const CbcNodeInfoStrategy& rhs);
+  };
 }
 
 #endif
@@ -26,6 +26,9 @@ using namespace std;
 
 namespace Bonmin
 {
+  /** Bytes taken by the BonCbcPartialNodeInfo of this thread.*/
+  static thread_local size_t partialInfoBytes = 0;
+
 //Default constructor
   BonCbcFullNodeInfo::BonCbcFullNodeInfo()
       :
@@ -58,6 +61,12 @@ namespace Bonmin
       ipws->flushPoint();
   }
 
+  IpoptWarmStart *
+  BonCbcFullNodeInfo::ipoptWarmStart() const
+  {
+    return dynamic_cast<IpoptWarmStart *>(basis_);
+  }
+
   BonCbcFullNodeInfo::~BonCbcFullNodeInfo()
 {}
 
@@ -100,8 +109,11 @@ namespace Bonmin
   BonCbcPartialNodeInfo::BonCbcPartialNodeInfo ()
       : CbcPartialNodeInfo(),
       sequenceOfInfeasiblesSize_(0),
-      sequenceOfUnsolvedSize_(0)
-  {}
+      sequenceOfUnsolvedSize_(0),
+      bytes_(sizeof(BonCbcPartialNodeInfo))
+  {
+    partialInfoBytes += bytes_;
+  }
 // Constructor from current state
   BonCbcPartialNodeInfo::BonCbcPartialNodeInfo (CbcModel * model,CbcNodeInfo *parent, CbcNode *owner,
       int numberChangedBounds,
@@ -111,8 +123,11 @@ namespace Bonmin
       : CbcPartialNodeInfo(parent,owner,numberChangedBounds,variables,
           boundChanges,basisDiff),
       sequenceOfInfeasiblesSize_(0),
-      sequenceOfUnsolvedSize_(0)
+      sequenceOfUnsolvedSize_(0),
+      bytes_(sizeof(BonCbcPartialNodeInfo) +
+          numberChangedBounds * (sizeof(int) + sizeof(double)))
   {
+    partialInfoBytes += bytes_;
     BonCbcPartialNodeInfo * nlpParent = dynamic_cast<BonCbcPartialNodeInfo *> (parent);
     int numberInfeasible = 0;
     int numberUnsolved = 0;
@@ -144,9 +159,12 @@ namespace Bonmin
 
       : CbcPartialNodeInfo(rhs),
       sequenceOfInfeasiblesSize_(rhs.sequenceOfInfeasiblesSize_),
-      sequenceOfUnsolvedSize_(rhs.sequenceOfUnsolvedSize_)
+      sequenceOfUnsolvedSize_(rhs.sequenceOfUnsolvedSize_),
+      bytes_(rhs.bytes_)
 
-{}
+{
+    partialInfoBytes += bytes_;
+}
 
   CbcNodeInfo *
   BonCbcPartialNodeInfo::clone() const
@@ -162,6 +180,20 @@ namespace Bonmin
       ipws->flushPoint();
   }
 
+  IpoptWarmStartDiff *
+  BonCbcPartialNodeInfo::ipoptWarmStartDiff() const
+  {
+    return dynamic_cast<IpoptWarmStartDiff *>(basisDiff_);
+  }
+
+  size_t
+  BonCbcPartialNodeInfo::bytesInMemory()
+  {
+    return partialInfoBytes;
+  }
+
   BonCbcPartialNodeInfo::~BonCbcPartialNodeInfo ()
-{}
+{
+    partialInfoBytes -= bytes_;
+}
 }
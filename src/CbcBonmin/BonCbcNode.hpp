@@ -17,6 +17,9 @@
 
 namespace Bonmin
 {
+  class IpoptWarmStart;
+  class IpoptWarmStartDiff;
+
   /** \brief Holds information for recreating a subproblem by incremental change
   	   from the parent for Bonmin
 
@@ -49,6 +52,10 @@ namespace Bonmin
        useless warm start information.*/
     virtual void allBranchesGone();
 
+    /** Warm start information of the node if it is an IpoptWarmStart
+        (NULL otherwise).*/
+    IpoptWarmStart * ipoptWarmStart() const;
+
     /** Number of consecutive infeasible parents only recorded if node is infeasible*/
     inline int getSequenceOfInfeasiblesSize()
     {
@@ -108,6 +115,14 @@ namespace Bonmin
        useless warm start information.*/
     virtual void allBranchesGone();
 
+    /** Warm start information of the node if it is an IpoptWarmStartDiff
+        (NULL otherwise).*/
+    IpoptWarmStartDiff * ipoptWarmStartDiff() const;
+
+    /** Approximate number of bytes taken by the BonCbcPartialNodeInfo of
+        this thread (without their warm starts).*/
+    static size_t bytesInMemory();
+
     /** Number of consecutive infeasible parents only recorded if node is infeasible*/
     inline int getSequenceOfInfeasiblesSize()
     {
@@ -124,6 +139,8 @@ namespace Bonmin
     int sequenceOfInfeasiblesSize_;
     /** Number of consecutive unsolved parents only recorded if node is infeasible*/
     int sequenceOfUnsolvedSize_;
+    /** Bytes counted for this object in bytesInMemory().*/
+    size_t bytes_;
   private:
 
     /// Illegal Assignment operator
@@ -7,15 +7,102 @@
 //
 // Date : 09/01/2007
 
+#include <algorithm>
+
 #include "BonDiver.hpp"
 #include "CoinFinite.hpp"
 #include "CbcModel.hpp"
+#include "CbcNode.hpp"
 #include "CbcConfig.h"
 #include "BonBabSetupBase.hpp"
 //#define DIVE_DEBUG
 namespace Bonmin
 {
 
+  /************************************************************************/
+  /*                DiveStack methods                                      */
+  /************************************************************************/
+
+  DiveStack::DiveStack():
+      nodes_(),
+      objective_(),
+      depth_(),
+      estimate_(),
+      begin_(0)
+  {}
+
+  void
+  DiveStack::push(CbcNode * node)
+  {
+    if (node == NULL)
+      push(node, COIN_DBL_MAX, 0, COIN_DBL_MAX);
+    else
+      push(node, node->objectiveValue(), node->depth(),
+          node->guessedObjectiveValue());
+  }
+
+  void
+  DiveStack::push(CbcNode * node, double objective, int depth, double estimate)
+  {
+    nodes_.push_back(node);
+    objective_.push_back(objective);
+    depth_.push_back(depth);
+    estimate_.push_back(estimate);
+  }
+
+  void
+  DiveStack::pop()
+  {
+    assert(!empty());
+    nodes_.pop_back();
+    objective_.pop_back();
+    depth_.pop_back();
+    estimate_.pop_back();
+    if (empty())
+      clear();
+  }
+
+  void
+  DiveStack::popBottom()
+  {
+    assert(!empty());
+    begin_++;
+    if (empty())
+      clear();
+    else if (2 * begin_ >= static_cast<int>(nodes_.size()))
+      compact();
+  }
+
+  void
+  DiveStack::clear()
+  {
+    nodes_.clear();
+    objective_.clear();
+    depth_.clear();
+    estimate_.clear();
+    begin_ = 0;
+  }
+
+  double
+  DiveStack::bestObjective() const
+  {
+    double best = COIN_DBL_MAX;
+    const int n = static_cast<int>(objective_.size());
+    for (int i = begin_ ; i < n ; i++)
+      best = std::min(best, objective_[i]);
+    return best;
+  }
+
+  void
+  DiveStack::compact()
+  {
+    nodes_.erase(nodes_.begin(), nodes_.begin() + begin_);
+    objective_.erase(objective_.begin(), objective_.begin() + begin_);
+    depth_.erase(depth_.begin(), depth_.begin() + begin_);
+    estimate_.erase(estimate_.begin(), estimate_.begin() + begin_);
+    begin_ = 0;
+  }
+
   /************************************************************************/
   /*                CbcDiver methods                                       */
   /************************************************************************/
@@ -165,6 +252,17 @@ namespace Bonmin
     return bestPossibleObjective;
   }
 
+  void
+  CbcDiver::openNodes(std::vector<CbcNode *> & nodes) const
+  {
+    if (nextOnBranch_ != NULL)
+      nodes.push_back(nextOnBranch_);
+    for (unsigned int i = 0 ; i < nodes_.size() ; i++) {
+      if (nodes_[i] != NULL)
+        nodes.push_back(nodes_[i]);
+    }
+  }
+
   void
   CbcDiver::registerOptions(Ipopt::SmartPtr<Bonmin::RegisteredOptions> roptions)
   {
@@ -435,6 +533,19 @@ namespace Bonmin
     return bestPossibleObjective;
   }
 
+  void
+  CbcProbedDiver::openNodes(std::vector<CbcNode *> & nodes) const
+  {
+    if (nextOnBranch_ != NULL)
+      nodes.push_back(nextOnBranch_);
+    if (candidateChild_ != NULL)
+      nodes.push_back(candidateChild_);
+    for (unsigned int i = 0 ; i < nodes_.size() ; i++) {
+      if (nodes_[i] != NULL)
+        nodes.push_back(nodes_[i]);
+    }
+  }
+
   /// Initialize the method (get options)
   void
   CbcProbedDiver::initialize(BabSetupBase &b)
@@ -487,7 +598,7 @@ namespace Bonmin
       nBacktracks_ = rhs.nBacktracks_;
       maxDepthBFS_ = rhs.maxDepthBFS_;
       maxDiveBacktracks_ = rhs.maxDiveBacktracks_;
-      maxDiveDepth_ = maxDiveDepth_;
+      maxDiveDepth_ = rhs.maxDiveDepth_;
       mode_ = rhs.mode_;
     }
     return *this;
@@ -517,7 +628,7 @@ namespace Bonmin
       CbcTree::top();
     }
     if (diveListSize_) {
-      return dive_.front();
+      return dive_.top();
     }
     else return CbcTree::top();
   }
@@ -536,10 +647,10 @@ namespace Bonmin
       return;
     }
     //Always push on dive;
-    dive_.push_front(x);
+    dive_.push(x);
     diveListSize_++;
 #ifdef DIVE_DEBUG
-    printf("diveListSize_ = %i == %u = dive_.size()\n",diveListSize_, dive_.size());
+    printf("diveListSize_ = %i == %i = dive_.size()\n",diveListSize_, dive_.size());
     assert(diveListSize_ == dive_.size());
 #endif
   }
@@ -556,7 +667,7 @@ namespace Bonmin
       assert(dive_.empty());
     }
     if (!dive_.empty()) {
-      dive_.pop_front();
+      dive_.pop();
       diveListSize_--;
     }
     else
@@ -583,15 +694,15 @@ namespace Bonmin
       if (diveListSize_ == 0)
         mode_ = CbcDfsDiver::FindSolutions;
       else {
-        CbcNode * node = dive_.back();
+        CbcNode * node = dive_.bottom();
         assert(node != NULL);
-        if (node->depth() > maxDepthBFS_) {
+        if (dive_.depth(0) > maxDepthBFS_) {
           //Switch mode to Diving
           setComparisonMode(FindSolutions);
         }
         else {
           //pop and return node;
-          dive_.pop_back();
+          dive_.popBottom();
           diveListSize_ --;
           return node;
         }
@@ -609,12 +720,18 @@ namespace Bonmin
       <<", examining node"<<std::endl;
 #endif
       assert(!dive_.empty());
-      node = dive_.front();
-      dive_.pop_front();
+      // Objective and depth are read from the stack, only nodes which are
+      // kept in the dive are dereferenced.
+      const int last = dive_.size() - 1;
+      const double objective = dive_.objective(last);
+      const int depth = dive_.depth(last);
+      const double estimate = dive_.estimate(last);
+      node = dive_.top();
+      dive_.pop();
       diveListSize_ --;
       assert(node);
-      assert((node->depth() - divingBoardDepth_) <= maxDiveDepth_);
-      if (node->objectiveValue() > cutoff) {//throw away node for now just put it on the heap as deleting a node is
+      assert((depth - divingBoardDepth_) <= maxDiveDepth_);
+      if (objective > cutoff) {//throw away node for now just put it on the heap as deleting a node is
         //more complicated than that (has to delete nodeInfo, cuts...)
 #ifdef DIVE_DEBUG
         std::cout<<"CbcDfsDiver::bestNode"
@@ -624,17 +741,17 @@ namespace Bonmin
         node = NULL;
         nBacktracks_++;
       }
-      else if (0 && node->guessedObjectiveValue() > cutoff) {//Put it on the real heap
+      else if (0 && estimate > cutoff) {//Put it on the real heap
 #ifdef DIVE_DEBUG
         std::cout<<"CbcDfsDiver::bestNode"
-        <<", node estimates "<<node->guessedObjectiveValue()<<"above cutoff"
+        <<", node estimates "<<estimate<<"above cutoff"
         <<cutoff<<std::endl;
 #endif
         CbcTree::push(node);
         nBacktracks_++;
         node = NULL;
       }
-      else if ((node->depth() - divingBoardDepth_) > maxDiveDepth_) {//Put it on the real heap
+      else if ((depth - divingBoardDepth_) > maxDiveDepth_) {//Put it on the real heap
 #ifdef DIVE_DEBUG
         std::cout<<"CbcDfsDiver::bestNode"
         <<", node too deep"<<std::endl;
@@ -674,15 +791,12 @@ namespace Bonmin
 
   void CbcDfsDiver::pushDiveOntoHeap(double cutoff)
   {
-    while (!dive_.empty() ){//&& dive_.front()->objectiveValue() >= cutoff) {
-      CbcTree::push(dive_.front());
-      dive_.pop_front();
+    while (!dive_.empty() ){//&& dive_.objective(dive_.size() - 1) >= cutoff) {
+      assert(dive_.top() != NULL);
+      CbcTree::push(dive_.top());
+      dive_.pop();
       diveListSize_--;
     }
-    for (std::list<CbcNode *>::iterator i = dive_.begin() ; i != dive_.end();
-        i++) {
-      assert(*i != NULL);
-    }
   }
   /** Test if empty. */
   bool CbcDfsDiver::empty()
@@ -714,14 +828,20 @@ namespace Bonmin
     std::cout<<"CbcDfsDiver::getBestPossibleObjective"<<std::endl;
 #endif
     double bestPossibleObjective = CbcTree::empty() ? COIN_DBL_MAX : CbcTree::getBestPossibleObjective();
-    for (std::list<CbcNode *>::iterator i = dive_.begin() ; i != dive_.end() ; i++) {
-      if (*i == NULL) continue;
-      const double & obj = (*i)->objectiveValue();
-      if (obj < bestPossibleObjective) {
-        bestPossibleObjective = obj;
-      }
+    return std::min(bestPossibleObjective, dive_.bestObjective());
+  }
+
+  void
+  CbcDfsDiver::openNodes(std::vector<CbcNode *> & nodes) const
+  {
+    for (int i = dive_.size() - 1 ; i >= 0 ; i--) {
+      if (dive_.node(i) != NULL)
+        nodes.push_back(dive_.node(i));
+    }
+    for (unsigned int i = 0 ; i < nodes_.size() ; i++) {
+      if (nodes_[i] != NULL)
+        nodes.push_back(nodes_[i]);
     }
-    return bestPossibleObjective;
   }
 
   ///Register the options of the method.
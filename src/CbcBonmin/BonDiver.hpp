@@ -17,10 +17,95 @@
 #include "IpOptionsList.hpp"
 #include "CbcCompareActual.hpp"
 #include "BonRegisteredOptions.hpp"
-#include <list>
+#include <vector>
 namespace Bonmin
 {
   class BabSetupBase;
+
+  /** Nodes of a dive, stored as a structure of arrays (node, objective value,
+      depth and estimate in contiguous vectors) so that scans of the dive do
+      not dereference the nodes.
+      Nodes are pushed and popped on the top (most recent node); the bottom
+      (oldest node) can also be popped in constant time (the space it frees
+      is reclaimed when it amounts to half of the arrays).
+      The values are copied when a node is pushed, they should not change
+      while the node is in the stack.*/
+  class BONMINLIB_EXPORT DiveStack
+  {
+  public:
+    /// Default constructor.
+    DiveStack();
+
+    /// Push node (with the values it holds) on the top.
+    void push(CbcNode * node);
+    /// Push node with the given values on the top.
+    void push(CbcNode * node, double objective, int depth, double estimate);
+    /// Node on the top.
+    CbcNode * top() const
+    {
+      return nodes_.back();
+    }
+    /// Remove the node on the top.
+    void pop();
+    /// Node at the bottom.
+    CbcNode * bottom() const
+    {
+      return nodes_[begin_];
+    }
+    /// Remove the node at the bottom.
+    void popBottom();
+    /// Number of nodes.
+    int size() const
+    {
+      return static_cast<int>(nodes_.size()) - begin_;
+    }
+    /// Test if empty.
+    bool empty() const
+    {
+      return size() == 0;
+    }
+    /// Remove all nodes.
+    void clear();
+
+    /// i-th node from the bottom.
+    CbcNode * node(int i) const
+    {
+      return nodes_[begin_ + i];
+    }
+    /// Objective value of the i-th node from the bottom.
+    double objective(int i) const
+    {
+      return objective_[begin_ + i];
+    }
+    /// Depth of the i-th node from the bottom.
+    int depth(int i) const
+    {
+      return depth_[begin_ + i];
+    }
+    /// Estimate of the i-th node from the bottom.
+    double estimate(int i) const
+    {
+      return estimate_[begin_ + i];
+    }
+    /// Smallest objective value (COIN_DBL_MAX if empty).
+    double bestObjective() const;
+
+  private:
+    /// Drop the free space at the beginning of the arrays.
+    void compact();
+
+    /// Nodes.
+    std::vector<CbcNode *> nodes_;
+    /// Objective values of the nodes.
+    std::vector<double> objective_;
+    /// Depths of the nodes.
+    std::vector<int> depth_;
+    /// Estimates (guessed objective values) of the nodes.
+    std::vector<double> estimate_;
+    /// Position of the bottom in the arrays.
+    int begin_;
+  };
+
   /** Class to do diving in the tree. Principle is that branch-and-bound follows current branch of the tree untill it
       hits the bottom at which point it goes to the best candidate (according to CbcCompare) on the heap.*/
   class BONMINLIB_EXPORT CbcDiver : public CbcTree
@@ -77,6 +162,9 @@ namespace Bonmin
     /// Get best possible objective function in the tree
     virtual double getBestPossibleObjective();
 
+    /// Append all the open nodes (heap and branch) to nodes.
+    void openNodes(std::vector<CbcNode *> & nodes) const;
+
 
     ///Don't know what this is yet?
     virtual void endSearch()
@@ -159,6 +247,9 @@ namespace Bonmin
     /// Get best possible objective function in the tree
     virtual double getBestPossibleObjective();
 
+    /// Append all the open nodes (heap and branch) to nodes.
+    void openNodes(std::vector<CbcNode *> & nodes) const;
+
 
     ///Don't know what this is yet?
     virtual void endSearch()
@@ -256,6 +347,9 @@ namespace Bonmin
     /// Get best possible objective function in the tree
     virtual double getBestPossibleObjective();
 
+    /// Append all the open nodes (heap and branch) to nodes.
+    void openNodes(std::vector<CbcNode *> & nodes) const;
+
     ///Register the options of the method.
     static void registerOptions(Ipopt::SmartPtr<Bonmin::RegisteredOptions> roptions);
 
@@ -278,8 +372,8 @@ namespace Bonmin
     /**Flag to say that we are currently cleaning the tree and should work only
        on the heap.*/
     int treeCleaning_;
-    /** List of the nodes in the current dive.*/
-    std::list<CbcNode *> dive_;
+    /** Nodes in the current dive (top is the last node pushed).*/
+    DiveStack dive_;
     /** Record dive list size for constant time access.*/
     int diveListSize_;
     /** Depth of the node from which diving was started (we call this node the diving board).*/
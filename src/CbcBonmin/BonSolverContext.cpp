@@ -0,0 +1,66 @@
+// (C) Copyright Bonmin contributors 2026
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+//
+// Date : 10/19/2026
+
+#include "BonSolverContext.hpp"
+#include "CoinError.hpp"
+#include "CoinTime.hpp"
+
+namespace Bonmin
+{
+
+  SolverContext::SolverContext(const std::string & options,
+      const CoinMessageHandler * handler):
+      setup_(handler),
+      bestSolution_(),
+      bestObj_(COIN_DBL_MAX),
+      bestBound_(-COIN_DBL_MAX),
+      numNodes_(0),
+      mipStatus_(Bab::NoSolutionKnown),
+      setupTime_(0.),
+      solveTime_(0.),
+      numberSolves_(0),
+      nlpSolver_(-1)
+  {
+    // Even an empty string marks the options as read, bonmin.opt is never
+    // looked at.
+    setup_.readOptionsString(options);
+  }
+
+  SolverContext::~SolverContext()
+  {}
+
+  Bab::MipStatuses
+  SolverContext::solve(Ipopt::SmartPtr<TMINLP> tminlp)
+  {
+    int nlpSolver;
+    setup_.options()->GetEnumValue("nlp_solver", nlpSolver, setup_.prefix());
+    if (numberSolves_ > 0 && nlpSolver != nlpSolver_)
+      throw CoinError("nlp_solver can not change between solves", "solve", "SolverContext");
+    nlpSolver_ = nlpSolver;
+
+    // From the second solve on, initialize resets the NLP solver on tminlp
+    // instead of building a new one (see BabSetupBase::use).
+    double start = CoinCpuTime();
+    setup_.initialize(tminlp);
+    setupTime_ = CoinCpuTime() - start;
+    start = CoinCpuTime();
+    Bab bb;
+    bb(setup_);
+    solveTime_ = CoinCpuTime() - start;
+    mipStatus_ = bb.mipStatus();
+    bestObj_ = bb.bestObj();
+    bestBound_ = bb.bestBound();
+    numNodes_ = bb.numNodes();
+    if (bb.bestSolution() != NULL) {
+      int n = setup_.nonlinearSolver()->getNumCols();
+      bestSolution_.assign(bb.bestSolution(), bb.bestSolution() + n);
+    }
+    else
+      bestSolution_.clear();
+    numberSolves_++;
+    return mipStatus_;
+  }
+}
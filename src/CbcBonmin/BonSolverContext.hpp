@@ -0,0 +1,129 @@
+// (C) Copyright Bonmin contributors 2026
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+//
+// Date : 10/19/2026
+
+#ifndef BonSolverContext_H
+#define BonSolverContext_H
+
+#include <string>
+#include <vector>
+
+#include "BonminConfig.h"
+#include "BonBonminSetup.hpp"
+#include "BonCbc.hpp"
+
+namespace Bonmin
+{
+  /** Solves a sequence of (typically small) MINLPs in one process, reusing
+      what does not depend on the problem from one solve to the next.
+      The options are read when the context is built (bonmin.opt is not
+      read); the registered options, the journalist, the message handler and
+      the NLP solver (OsiTMINLPInterface with its TNLPSolver, so Ipopt is
+      initialized and ipopt.opt read only once) are kept between the solves.
+      The branch-and-bound, the heuristics, the cut generators and the
+      branching method depend on the problem and are rebuilt at each solve
+      (setupTime() and solveTime() tell what this costs).
+      Options changed through setup() between two solves apply to the next
+      one, except nlp_solver: the NLP solver is kept, solve throws a
+      CoinError if it changed.
+      A context is not thread safe, use one per thread.*/
+  class BONMINLIB_EXPORT SolverContext
+  {
+  public:
+    /** Constructor, options are given in the syntax of bonmin.opt.*/
+    SolverContext(const std::string & options = "",
+        const CoinMessageHandler * handler = NULL);
+
+    /** Destructor.*/
+    ~SolverContext();
+
+    /** Solve tminlp, returns the status of the branch-and-bound.*/
+    Bab::MipStatuses solve(Ipopt::SmartPtr<TMINLP> tminlp);
+
+    /** Best solution found by the last solve (NULL if none).*/
+    const double * bestSolution() const
+    {
+      return bestSolution_.empty() ? NULL : &bestSolution_[0];
+    }
+
+    /** Objective value of the best solution of the last solve.*/
+    double bestObj() const
+    {
+      return bestObj_;
+    }
+
+    /** Best bound of the last solve.*/
+    double bestBound() const
+    {
+      return bestBound_;
+    }
+
+    /** Number of nodes of the last solve.*/
+    int numNodes() const
+    {
+      return numNodes_;
+    }
+
+    /** Status of the last solve.*/
+    Bab::MipStatuses mipStatus() const
+    {
+      return mipStatus_;
+    }
+
+    /** Time (CPU seconds) spent by the last solve in building the setup
+        (NLP solver, heuristics, cut generators and branching method).*/
+    double setupTime() const
+    {
+      return setupTime_;
+    }
+
+    /** Time (CPU seconds) of the branch-and-bound of the last solve,
+        including the building of the CbcModel.*/
+    double solveTime() const
+    {
+      return solveTime_;
+    }
+
+    /** Number of problems solved with this context.*/
+    int numberSolves() const
+    {
+      return numberSolves_;
+    }
+
+    /** Access to the setup (to change options between solves).*/
+    BonminSetup & setup()
+    {
+      return setup_;
+    }
+
+  private:
+    /** Copy constructor (not implemented).*/
+    SolverContext(const SolverContext &);
+    /** Assignment operator (not implemented).*/
+    SolverContext & operator=(const SolverContext &);
+
+    /** Setup kept between the solves.*/
+    BonminSetup setup_;
+    /** Best solution of the last solve.*/
+    std::vector<double> bestSolution_;
+    /** Objective value of the best solution of the last solve.*/
+    double bestObj_;
+    /** Best bound of the last solve.*/
+    double bestBound_;
+    /** Number of nodes of the last solve.*/
+    int numNodes_;
+    /** Status of the last solve.*/
+    Bab::MipStatuses mipStatus_;
+    /** Time spent building the setup in the last solve.*/
+    double setupTime_;
+    /** Time of the branch-and-bound of the last solve.*/
+    double solveTime_;
+    /** Number of problems solved.*/
+    int numberSolves_;
+    /** NLP solver chosen at the first solve.*/
+    int nlpSolver_;
+  };
+}
+#endif
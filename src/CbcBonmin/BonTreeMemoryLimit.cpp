@@ -0,0 +1,140 @@
+// (C) Copyright Bonmin contributors 2026
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+//
+// Date : 10/19/2026
+
+#include <algorithm>
+#include <set>
+#include <vector>
+
+#include "BonTreeMemoryLimit.hpp"
+#include "BonBabCheckpoint.hpp"
+#include "BonCbcNode.hpp"
+#include "BonDiver.hpp"
+#include "BonIpoptWarmStart.hpp"
+
+#include "CbcModel.hpp"
+#include "CbcNode.hpp"
+#include "CbcTree.hpp"
+#include "CbcCompareActual.hpp"
+#include "OsiBranchingObject.hpp"
+
+namespace Bonmin
+{
+
+  /** Orders nodes by increasing bound.*/
+  static bool
+  betterBound(CbcNode * a, CbcNode * b)
+  {
+    return a->objectiveValue() < b->objectiveValue();
+  }
+
+  TreeMemoryLimit::TreeMemoryLimit(double limit, const std::string & spillFileName):
+      limit_(limit),
+      spill_(spillFileName),
+      nextSpill_(limit),
+      countedEntries_(IpoptWarmStartDiff::countEntries()),
+      lastEstimate_(0.),
+      numberSpilled_(0),
+      maxBytesSpilled_(0),
+      savedComparison_(NULL),
+      switchedToDepthFirst_(false)
+  {
+    IpoptWarmStartDiff::setCountEntries(true);
+  }
+
+  TreeMemoryLimit::~TreeMemoryLimit()
+  {
+    IpoptWarmStartDiff::setCountEntries(countedEntries_);
+    delete savedComparison_;
+  }
+
+  double
+  TreeMemoryLimit::estimate(CbcModel & model) const
+  {
+    double numberNodes = (model.tree() != NULL) ? model.tree()->size() : 0;
+    return numberNodes * (sizeof(CbcNode) + sizeof(OsiIntegerBranchingObject)) +
+        static_cast<double>(BonCbcPartialNodeInfo::bytesInMemory()) +
+        static_cast<double>(IpoptWarmStartDiff::bytesInMemory());
+  }
+
+  void
+  TreeMemoryLimit::nodeProcessed(CbcModel & model)
+  {
+    lastEstimate_ = estimate(model);
+    if (lastEstimate_ > nextSpill_) {
+      spill(model);
+      lastEstimate_ = estimate(model);
+      // If the warm starts left are not enough to go back under the limit,
+      // wait for the tree to grow by a tenth of the limit before walking it
+      // again.
+      nextSpill_ = std::max(limit_, lastEstimate_ + 0.1 * limit_);
+    }
+    else if (lastEstimate_ < limit_)
+      nextSpill_ = limit_;
+    switchComparison(model, lastEstimate_);
+  }
+
+  void
+  TreeMemoryLimit::spill(CbcModel & model)
+  {
+    std::vector<CbcNode *> nodes;
+    BabCheckpoint::openNodes(model.tree(), nodes);
+    std::sort(nodes.begin(), nodes.end(), betterBound);
+
+    // Collect the warm starts in memory, each with the best node below it
+    // (nodes are visited by increasing bound so the first one to reach a
+    // node information is the best).
+    std::vector<IpoptWarmStartDiff *> warmStarts;
+    std::set<CbcNodeInfo *> visited;
+    for (unsigned int i = 0 ; i < nodes.size() ; i++) {
+      for (CbcNodeInfo * info = nodes[i]->nodeInfo() ;
+          info != NULL && visited.insert(info).second ; info = info->parent()) {
+        BonCbcPartialNodeInfo * bonInfo = dynamic_cast<BonCbcPartialNodeInfo *>(info);
+        IpoptWarmStartDiff * diff = bonInfo ? bonInfo->ipoptWarmStartDiff() : NULL;
+        if (diff != NULL && !diff->spilled() && diff->memoryUsage() > 0)
+          warmStarts.push_back(diff);
+      }
+    }
+
+    // Spill the warm starts of the least promising nodes first.
+    double current = estimate(model);
+    double target = 0.8 * limit_;
+    for (int k = static_cast<int>(warmStarts.size()) - 1 ;
+        k >= 0 && current > target ; k--) {
+      size_t released = warmStarts[k]->spill(spill_);
+      if (released > 0) {
+        current -= released;
+        numberSpilled_++;
+      }
+    }
+    maxBytesSpilled_ = std::max(maxBytesSpilled_, spill_.bytesStored());
+  }
+
+  void
+  TreeMemoryLimit::switchComparison(CbcModel & model, double estimate)
+  {
+    // The divers of Bonmin already limit the size of the tree, only a
+    // plain tree is switched to depth first.
+    CbcTree * tree = model.tree();
+    if (tree == NULL || dynamic_cast<CbcDfsDiver *>(tree) != NULL ||
+        dynamic_cast<CbcProbedDiver *>(tree) != NULL ||
+        dynamic_cast<CbcDiver *>(tree) != NULL)
+      return;
+    if (estimate > limit_ && savedComparison_ == NULL &&
+        model.nodeComparison() != NULL) {
+      savedComparison_ = model.nodeComparison()->clone();
+      CbcCompareDepth depth;
+      model.setNodeComparison(depth);
+      tree->setComparison(*model.nodeComparison());
+      switchedToDepthFirst_ = true;
+    }
+    else if (estimate < 0.5 * limit_ && savedComparison_ != NULL) {
+      model.setNodeComparison(*savedComparison_);
+      tree->setComparison(*model.nodeComparison());
+      delete savedComparison_;
+      savedComparison_ = NULL;
+    }
+  }
+}
@@ -0,0 +1,115 @@
+// (C) Copyright Bonmin contributors 2026
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+//
+// Date : 10/19/2026
+
+#ifndef BonTreeMemoryLimit_H
+#define BonTreeMemoryLimit_H
+
+#include <string>
+
+#include "BonminConfig.h"
+#include "BonSpillFile.hpp"
+
+class CbcModel;
+class CbcCompareBase;
+
+namespace Bonmin
+{
+  /** Keeps the memory taken by the open nodes of a branch-and-bound under a
+      limit.
+      Most of the memory of an open node of Bonmin is the warm start of the
+      NLP solver (primal and dual values) kept in its node information.
+      The memory of the tree is estimated at each node from the bytes taken
+      by the node informations and warm starts alive on the thread (counted
+      when they are made and deleted, see
+      BonCbcPartialNodeInfo::bytesInMemory and
+      IpoptWarmStartDiff::bytesInMemory). Only when the estimate exceeds the
+      limit is the tree walked: the warm starts of the open nodes with the
+      worst bounds are moved to a spill file until the estimate is back
+      under 80% of the limit. A warm start is read back when Cbc rebuilds it
+      to solve one of the nodes below it.
+      If the limit can not be met this way, the search switches to depth
+      first (which keeps the tree small) until the tree is back under half
+      the limit.
+      The warm starts can only be spilled if the node informations are
+      Bonmin's (BonCbcPartialNodeInfo).
+  */
+  class BONMINLIB_EXPORT TreeMemoryLimit
+  {
+  public:
+    /** Constructor, limit is in bytes, warm starts are spilled to
+        spillFileName. Turns on the counting of the values of the warm
+        starts of the thread (IpoptWarmStartDiff::setCountEntries).*/
+    TreeMemoryLimit(double limit, const std::string & spillFileName);
+
+    /** Destructor.*/
+    ~TreeMemoryLimit();
+
+    /** Called at each node by the search.*/
+    void nodeProcessed(CbcModel & model);
+
+    /** Spill the warm starts of the open nodes of model with the worst
+        bounds until the estimate is under 80% of the limit.*/
+    void spill(CbcModel & model);
+
+    /** Estimate of the memory taken by the tree of model (in bytes).*/
+    double estimate(CbcModel & model) const;
+
+    /** Estimated memory of the tree at the last node (in bytes).*/
+    double lastEstimate() const
+    {
+      return lastEstimate_;
+    }
+
+    /** Number of warm starts spilled.*/
+    int numberSpilled() const
+    {
+      return numberSpilled_;
+    }
+
+    /** Largest number of bytes held by the spill file.*/
+    size_t maxBytesSpilled() const
+    {
+      return maxBytesSpilled_;
+    }
+
+    /** Did the search have to switch to depth first?*/
+    bool switchedToDepthFirst() const
+    {
+      return switchedToDepthFirst_;
+    }
+
+  private:
+    /** Copy constructor (not implemented).*/
+    TreeMemoryLimit(const TreeMemoryLimit &);
+    /** Assignment operator (not implemented).*/
+    TreeMemoryLimit & operator=(const TreeMemoryLimit &);
+
+    /** Switch the search of model to depth first if estimate is over the
+        limit, back to its comparison when it is under half the limit.*/
+    void switchComparison(CbcModel & model, double estimate);
+
+    /** Limit on the memory of the tree (in bytes).*/
+    double limit_;
+    /** File to which warm starts are spilled.*/
+    SpillFile spill_;
+    /** Estimate above which the tree is walked again (raised when the
+        last walk could not bring the estimate under the limit).*/
+    double nextSpill_;
+    /** Was counting the values of the warm starts on before?*/
+    bool countedEntries_;
+    /** Estimated memory of the tree at the last node.*/
+    double lastEstimate_;
+    /** Number of warm starts spilled.*/
+    int numberSpilled_;
+    /** Largest number of bytes held by the spill file.*/
+    size_t maxBytesSpilled_;
+    /** Node comparison replaced by depth first (owned, NULL if none).*/
+    CbcCompareBase * savedComparison_;
+    /** Did the search have to switch to depth first?*/
+    bool switchedToDepthFirst_;
+  };
+}
+#endif
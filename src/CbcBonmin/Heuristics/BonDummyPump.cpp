@@ -9,6 +9,7 @@
 #include "BonDummyPump.hpp"
 #include "CbcModel.hpp"
 #include "OsiBranchingObject.hpp"
+#include "BonProfiler.hpp"
 
 namespace Bonmin {
 
@@ -34,6 +35,7 @@ namespace Bonmin {
   int
   DummyPump::solution(double & objectiveValue,
                                  double * newSolution){
+    ProfileTimer timer(Profiler::Heuristic);
     if(model_->getNodeCount() || model_->getCurrentPassNumber() > 1) return 0;
     //int numberObjects = model_->numberObjects();
     //OsiObject ** objects = model_->objects();
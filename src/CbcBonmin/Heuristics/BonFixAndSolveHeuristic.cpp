@@ -9,6 +9,7 @@
 #include "BonFixAndSolveHeuristic.hpp"
 #include "CbcModel.hpp"
 #include "OsiBranchingObject.hpp"
+#include "BonProfiler.hpp"
 
 namespace Bonmin {
 
@@ -36,6 +37,7 @@ namespace Bonmin {
   int
   FixAndSolveHeuristic::solution(double & objectiveValue,
                                  double * newSolution){
+    ProfileTimer timer(Profiler::Heuristic);
     //if(model_->getNodeCount() || model_->getCurrentPassNumber() > 1) return 0;
     if(model_->getSolutionCount() > 0) return 0;
     if(model_->getNodeCount() > 1000) return 0;
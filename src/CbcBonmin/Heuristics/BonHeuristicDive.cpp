@@ -14,6 +14,7 @@
 #include "OsiAuxInfo.hpp"
 
 #include "CoinTime.hpp"
+#include "BonProfiler.hpp"
 
 #include <fstream>
 
@@ -66,6 +67,7 @@ namespace Bonmin
   int
   HeuristicDive::solution(double &solutionValue, double *betterSolution)
   {
+    ProfileTimer timer(Profiler::Heuristic);
     //    if(model_->getNodeCount() || model_->getCurrentPassNumber() > 1) return 0;
     if ((model_->getNodeCount()%howOften_)!=0||model_->getCurrentPassNumber()>1)
       return 0;
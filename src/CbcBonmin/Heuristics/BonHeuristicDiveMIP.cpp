@@ -30,6 +30,7 @@
 #include <iomanip>
 
 #include "CoinHelperFunctions.hpp"
+#include "BonProfiler.hpp"
 
 //#define DEBUG_BON_HEURISTIC_DIVE_MIP
 
@@ -94,6 +95,7 @@ namespace Bonmin
   int
   HeuristicDiveMIP::solution(double &solutionValue, double *betterSolution)
   {
+    ProfileTimer timer(Profiler::Heuristic);
     if(model_->getNodeCount() || model_->getCurrentPassNumber() > 1) return 0;
     if ((model_->getNodeCount()%howOften_)!=0||model_->getCurrentPassNumber()>1)
       return 0;
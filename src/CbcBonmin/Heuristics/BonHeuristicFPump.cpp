@@ -12,8 +12,10 @@
 #include "CbcModel.hpp"
 
 #include "OsiAuxInfo.hpp"
+#include "BonBabInfos.hpp"
 
 #include "CoinTime.hpp"
+#include "BonProfiler.hpp"
 
 #include <fstream>
 
@@ -81,6 +83,7 @@ namespace Bonmin
   int
   HeuristicFPump::solution(double &solutionValue, double *betterSolution)
   {
+    ProfileTimer timer(Profiler::Heuristic);
     if(model_->getNodeCount() || model_->getCurrentPassNumber() > 1) return 0;
 
     bool integerSolutionAlreadyExists = false;
@@ -184,6 +187,16 @@ namespace Bonmin
 
     RoundingFPump roundObj(minlp);
 
+    // When the pump cycles, restart it from integer feasible points of
+    // the OA master problems (if any) before perturbing randomly.
+    SolutionPool * pool = NULL;
+    BabInfo * babInfo = dynamic_cast<BabInfo *>(model_->solver()->getAuxiliaryInfo());
+    if(babInfo != NULL)
+      pool = &babInfo->solutionPool();
+    int nextElite = 0;
+    vector<double> elite;
+    double eliteObj;
+
     //bool stopDueToAlmostZeroObjective = false;
     double* x_bar = new double[numberIntegerColumns];
     int* indexes_x_bar = new int[numberIntegerColumns];
@@ -281,7 +294,19 @@ namespace Bonmin
 	cout<<"matched= "<<matched<<endl;
 #endif
 
-	if (matched) {
+	if (matched && pool != NULL &&
+	    pool->get(nextElite, SolutionPool::MilpFeasible, elite, eliteObj)) {
+	  // restart from an elite point
+	  nextElite++;
+	  for(int iIntCol=0; iIntCol<numberIntegerColumns; iIntCol++) {
+	    int iColumn = integerColumns[iIntCol];
+	    double value = floor(elite[iColumn]+0.5);
+	    value = max(ceil(x_l[iColumn]-primalTolerance), value);
+	    value = min(floor(x_u[iColumn]+primalTolerance), value);
+	    x_bar[iIntCol]=value;
+	  }
+	}
+	else if (matched) {
 	  // perturbation
 	  for(int iIntCol=0; iIntCol<numberIntegerColumns; iIntCol++) {
 	    int iColumn = integerColumns[iIntCol];
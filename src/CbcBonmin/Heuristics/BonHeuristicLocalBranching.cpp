@@ -11,6 +11,7 @@
 #include "BonHeuristicLocalBranching.hpp"
 #include "CbcModel.hpp"
 #include "OsiBranchingObject.hpp"
+#include "BonProfiler.hpp"
 
 namespace Bonmin {
 
@@ -78,15 +79,18 @@ namespace Bonmin {
   HeuristicLocalBranching::solution(double & objectiveValue,
 			  double * newSolution)
   {
+    ProfileTimer timer(Profiler::Heuristic);
     //    if(!when() || model_->getNodeCount() || model_->getCurrentPassNumber() > 1) return 0;
     if (numberSolutions_>=model_->getSolutionCount())
       return 0;
     else
       numberSolutions_=model_->getSolutionCount();
 
-    const double * bestSolution = model_->bestSolution();
-    if (!bestSolution)
+    // Neighborhoods are centered in turn at the elite solutions.
+    std::vector<double> elite;
+    if (!nextElitePoint(elite))
       return 0; // No solution found yet
+    const double * bestSolution = &elite[0];
 
     OsiTMINLPInterface * nlp = dynamic_cast<OsiTMINLPInterface *>
                                (setup_->nonlinearSolver()->clone());
@@ -11,6 +11,7 @@
 #include "BonHeuristicRINS.hpp"
 #include "CbcModel.hpp"
 #include "OsiBranchingObject.hpp"
+#include "BonProfiler.hpp"
 
 //#define DEBUG_BON_HEURISTIC_RINS
 
@@ -45,16 +46,19 @@ namespace Bonmin {
   HeuristicRINS::solution(double & objectiveValue,
 			  double * newSolution)
   {
+    ProfileTimer timer(Profiler::Heuristic);
     if(!howOften_ || model_->getNodeCount() % howOften_ != 0) return 0;
     numberSolutions_=model_->getSolutionCount();
 
-    const double * bestSolution = model_->bestSolution();
-    if (!bestSolution){
+    // Neighborhoods are centered in turn at the elite solutions.
+    std::vector<double> elite;
+    if (!nextElitePoint(elite)){
 #ifdef DEBUG_BON_HEURISTIC_RINS
     std::cout<<"exited RINS b"<<std::endl;
 #endif
       return 0; // No solution found yet
     }
+    const double * bestSolution = &elite[0];
     OsiTMINLPInterface * nlp = dynamic_cast<OsiTMINLPInterface *>
                                (model_->solver());
     if(nlp == NULL){
@@ -8,11 +8,14 @@
 
 #include "BonLocalSolverBasedHeuristic.hpp"
 #include "BonCbc.hpp"
+#include "BonBabInfos.hpp"
+#include "CbcModel.hpp"
 
 namespace Bonmin {
   LocalSolverBasedHeuristic::LocalSolverBasedHeuristic():
      CbcHeuristic(),
      setup_(NULL),
+     eliteIndex_(0),
      time_limit_(60),
      max_number_nodes_(1000),
      max_number_solutions_(10){
@@ -20,6 +23,7 @@ namespace Bonmin {
   LocalSolverBasedHeuristic::LocalSolverBasedHeuristic(BonminSetup * setup):
      CbcHeuristic(),
      setup_(setup),
+     eliteIndex_(0),
      time_limit_(60),
      max_number_nodes_(1000),
      max_number_solutions_(10){
@@ -29,6 +33,7 @@ namespace Bonmin {
   LocalSolverBasedHeuristic::LocalSolverBasedHeuristic(const LocalSolverBasedHeuristic & other):
     CbcHeuristic(other),
     setup_(other.setup_),
+    eliteIndex_(other.eliteIndex_),
     time_limit_(other.time_limit_),
     max_number_nodes_(other.max_number_nodes_),
     max_number_solutions_(other.max_number_solutions_) {
@@ -42,6 +47,7 @@ namespace Bonmin {
      if(this != &rhs){
         CbcHeuristic::operator=(rhs);
         setup_ = rhs.setup_;
+        eliteIndex_ = rhs.eliteIndex_;
      }
      return *this;
    }
@@ -102,11 +108,46 @@ namespace Bonmin {
         CoinCopyN(bb.bestSolution(), solver->getNumCols(), solution);
         solValue = bb.bestObj();
         r_val = 1;
+        SolutionPool * pool = solutionPool();
+        if(pool != NULL)
+          pool->add(solution, solver->getNumCols(), solValue, SolutionPool::MinlpFeasible);
       }
       delete mysetup;
       return r_val;
     }
 
+   SolutionPool *
+   LocalSolverBasedHeuristic::solutionPool() const{
+     if(model_ == NULL)
+       return NULL;
+     BabInfo * babInfo = dynamic_cast<BabInfo *>(model_->solver()->getAuxiliaryInfo());
+     if(babInfo == NULL)
+       return NULL;
+     return &babInfo->solutionPool();
+   }
+
+   bool
+   LocalSolverBasedHeuristic::nextElitePoint(std::vector<double> & x){
+     const double * bestSolution = model_->bestSolution();
+     SolutionPool * pool = solutionPool();
+     if(pool == NULL || pool->capacity() == 0){
+       if(bestSolution == NULL)
+         return false;
+       x.assign(bestSolution, bestSolution + model_->getNumCols());
+       return true;
+     }
+     if(bestSolution != NULL)
+       pool->add(bestSolution, model_->getNumCols(), model_->getObjValue(),
+                 SolutionPool::MinlpFeasible);
+     int size = pool->size(SolutionPool::MinlpFeasible);
+     if(size == 0)
+       return false;
+     double obj;
+     pool->get(eliteIndex_ % size, SolutionPool::MinlpFeasible, x, obj);
+     eliteIndex_++;
+     return true;
+   }
+
    /** Register the options common to all local search based heuristics.*/
    void
    LocalSolverBasedHeuristic::registerOptions(Ipopt::SmartPtr<Bonmin::RegisteredOptions> roptions){
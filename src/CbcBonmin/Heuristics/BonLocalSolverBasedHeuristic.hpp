@@ -9,6 +9,7 @@
 #ifndef BonLocalSolverBasedHeuristic_H
 #define BonLocalSolverBasedHeuristic_H
 #include "BonBonminSetup.hpp"
+#include "BonSolutionPool.hpp"
 #include "CbcHeuristic.hpp"
 
 namespace Bonmin {
@@ -74,6 +75,17 @@ namespace Bonmin {
    /** Setup to use for local searches (will make copies).*/
    BonminSetup * setup_; 
 
+   /** Pool of solutions of the branch-and-bound (NULL if there is none).*/
+   SolutionPool * solutionPool() const;
+
+   /** Get the next point of the pool of MINLP feasible solutions to center
+       a neighborhood at (points are taken in turn, the incumbent is
+       always in the pool). Returns false if there is no solution yet.*/
+   bool nextElitePoint(std::vector<double> & x);
+
+   /** Index of the next point of the pool to use.*/
+   int eliteIndex_;
+
    static void changeIfNotSet(Ipopt::SmartPtr<Ipopt::OptionsList> options, 
                        std::string prefix,
                        const std::string &option,
@@ -20,6 +20,7 @@
 
 #include "CoinHelperFunctions.hpp"
 #include "OsiClpSolverInterface.hpp"
+#include "BonProfiler.hpp"
 
 //#define DEBUG_BON_HEURISTIC_DIVE_MIP
 
@@ -32,7 +33,11 @@ namespace Bonmin
     CbcHeuristic(),
     setup_(setup),
     howOften_(20),
-    mip_(NULL)
+    mip_(NULL),
+    noGoods(),
+    numberColumns_(-1),
+    idxIntegers_(),
+    numberNoGoodsApplied_(0)
   {
     Initialize(setup);
   }
@@ -41,7 +46,7 @@ namespace Bonmin
   MilpRounding::Initialize(BonminSetup * b){
     delete mip_;
     mip_ = new SubMipSolver (*b, b->prefix());
-   
+    numberColumns_ = -1;
   }
 
   MilpRounding::MilpRounding(const MilpRounding &copy)
@@ -49,7 +54,11 @@ namespace Bonmin
     CbcHeuristic(copy),
     setup_(copy.setup_),
     howOften_(copy.howOften_),
-    mip_(new SubMipSolver(*copy.mip_))
+    mip_(new SubMipSolver(*copy.mip_)),
+    noGoods(copy.noGoods),
+    numberColumns_(copy.numberColumns_),
+    idxIntegers_(copy.idxIntegers_),
+    numberNoGoodsApplied_(copy.numberNoGoodsApplied_)
   {
   }
 
@@ -61,8 +70,13 @@ namespace Bonmin
       setup_ = rhs.setup_;
       howOften_ = rhs.howOften_;
       delete mip_;
+      mip_ = NULL;
       if(rhs.mip_)
         mip_ = new SubMipSolver(*rhs.mip_);
+      noGoods = rhs.noGoods;
+      numberColumns_ = rhs.numberColumns_;
+      idxIntegers_ = rhs.idxIntegers_;
+      numberNoGoodsApplied_ = rhs.numberNoGoodsApplied_;
     }
     return *this;
   }
@@ -81,27 +95,10 @@ namespace Bonmin
   };
 
 
-  int
-  MilpRounding::solution(double &solutionValue, double *betterSolution)
+  void
+  MilpRounding::loadMilpTemplate(OsiTMINLPInterface * nlp, OsiSolverInterface * si)
   {
-    if(model_->getCurrentPassNumber() > 1) return 0;
-    if (model_->currentDepth() > 2 && (model_->getNodeCount()%howOften_)!=0)
-      return 0;
- 
-    int returnCode = 0; // 0 means it didn't find a feasible solution
-
-    OsiTMINLPInterface * nlp = NULL;
-    if(setup_->getAlgorithm() == B_BB)
-      nlp = dynamic_cast<OsiTMINLPInterface *>(model_->solver()->clone());
-    else
-      nlp = dynamic_cast<OsiTMINLPInterface *>(setup_->nonlinearSolver()->clone());
-
     TMINLP2TNLP* minlp = nlp->problem();
- 
-    // set tolerances
-    double integerTolerance = model_->getDblParam(CbcModel::CbcIntegerTolerance);
-    //double primalTolerance = 1.0e-6;
-
     int n;
     int m;
     int nnz_jac_g;
@@ -115,9 +112,6 @@ namespace Bonmin
     const double* g_l = minlp->g_l();
     const double* g_u = minlp->g_u();
 
-    const double * colsol = model_->solver()->getColSolution();
-
-
     // Get information about the linear and nonlinear part of the instance
     TMINLP* tminlp = nlp->model();
     vector<Ipopt::TNLP::LinearityType> c_lin(m);
@@ -184,23 +178,73 @@ namespace Bonmin
       newRowUpper[c_idx[i]] = g_u[i];
     }
 
+    // Define the constraint matrix for MILP
+    CoinPackedMatrix matrix(true,n_lin,n, nnz, value(), row(), columnStart(), columnLength());
+
+    idxIntegers_.clear();
+    for(int i = 0 ; i < n ; i++){
+      if(variableType[i] != Bonmin::TMINLP::CONTINUOUS)
+        idxIntegers_.push_back(i);
+    }
+
+    // Objective and column bounds are set at each call.
+    vector<double> zeros(n, 0.);
+    si->loadProblem(matrix, nlp->getColLower(), nlp->getColUpper(), zeros(),
+                    newRowLower(), newRowUpper());
+    if(!idxIntegers_.empty())
+      si->setInteger(&idxIntegers_[0], static_cast<int>(idxIntegers_.size()));
+    si->applyCuts(noGoods);
+    numberNoGoodsApplied_ = noGoods.sizeRowCuts();
+    numberColumns_ = n;
+  }
+
+  int
+  MilpRounding::solution(double &solutionValue, double *betterSolution)
+  {
+    ProfileTimer timer(Profiler::Heuristic);
+    if(model_->getCurrentPassNumber() > 1) return 0;
+    if (model_->currentDepth() > 2 && (model_->getNodeCount()%howOften_)!=0)
+      return 0;
+ 
+    int returnCode = 0; // 0 means it didn't find a feasible solution
+
+    OsiTMINLPInterface * nlp = NULL;
+    if(setup_->getAlgorithm() == B_BB)
+      nlp = dynamic_cast<OsiTMINLPInterface *>(model_->solver()->clone());
+    else
+      nlp = dynamic_cast<OsiTMINLPInterface *>(setup_->nonlinearSolver()->clone());
+
+    TMINLP2TNLP* minlp = nlp->problem();
+ 
+    // set tolerances
+    double integerTolerance = model_->getDblParam(CbcModel::CbcIntegerTolerance);
+    //double primalTolerance = 1.0e-6;
+
+    int n;
+    int m;
+    int nnz_jac_g;
+    int nnz_h_lag;
+    Ipopt::TNLP::IndexStyleEnum index_style;
+    minlp->get_nlp_info(n, m, nnz_jac_g,
+			nnz_h_lag, index_style);
+
+    const Bonmin::TMINLP::VariableType* variableType = minlp->var_types();
+    const double* x_sol = minlp->x_sol();
+
+    const double * colsol = model_->solver()->getColSolution();
+
+
     // Get solution array for heuristic solution
     vector<double> newSolution(n);
     std::copy(x_sol, x_sol + n, newSolution.begin());
 
-    // Define the constraint matrix for MILP
-    CoinPackedMatrix matrix(true,n_lin,n, nnz, value(), row(), columnStart(), columnLength());
-
       // create objective function and columns lower and upper bounds for MILP
       // and create columns for matrix in MILP
       //double alpha = 0;
       double beta = 1;
       vector<double> objective(n);
-      vector<int> idxIntegers;
-      idxIntegers.reserve(n);
       for(int i = 0 ; i < n ; i++){
          if(variableType[i] != Bonmin::TMINLP::CONTINUOUS){
-            idxIntegers.push_back(i);
             objective[i] = beta*(1 - 2*colsol[i]);
          }
       }
@@ -230,17 +274,27 @@ namespace Bonmin
       std::cout<<std::endl;
 #endif
 
-      // load the problem to OSI
+      // The linear constraints are loaded once, then only the objective,
+      // the bounds and the new no-good cuts change (so that the solver
+      // keeps its basis between calls).
       OsiSolverInterface *si = mip_->solver();
       assert(si != NULL);
       CoinMessageHandler * handler = model_->messageHandler()->clone();
       si->passInMessageHandler(handler);
       si->messageHandler()->setLogLevel(1);
 
-      si->loadProblem(matrix, model_->solver()->getColLower(), model_->solver()->getColUpper(), objective(), 
-                      newRowLower(), newRowUpper());
-      si->setInteger(idxIntegers(), static_cast<int>(idxIntegers.size()));
-      si->applyCuts(noGoods);
+      if(numberColumns_ != n || si->getNumCols() != n)
+        loadMilpTemplate(nlp, si);
+      si->setObjective(objective());
+      si->setColLower(model_->solver()->getColLower());
+      si->setColUpper(model_->solver()->getColUpper());
+      if(numberNoGoodsApplied_ < noGoods.sizeRowCuts()){
+        vector<const OsiRowCut *> newCuts;
+        for(int i = numberNoGoodsApplied_ ; i < noGoods.sizeRowCuts() ; i++)
+          newCuts.push_back(noGoods.rowCutPtr(i));
+        si->applyRowCuts(static_cast<int>(newCuts.size()), &newCuts[0]);
+        numberNoGoodsApplied_ = noGoods.sizeRowCuts();
+      }
 
       bool hasFractionnal = true;
       while(hasFractionnal){
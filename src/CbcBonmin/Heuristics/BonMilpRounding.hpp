@@ -50,6 +50,7 @@ namespace Bonmin
     /** Change setup used for heuristic.*/
     virtual void setSetup(BonminSetup * setup){
       setup_ = setup;
+      numberColumns_ = -1;
       //      Initialize(setup_->options());
     }
 
@@ -63,12 +64,22 @@ namespace Bonmin
     BonminSetup * setup_; 
 
   private:
+    /** Load in si the MILP made of the linear constraints of the problem of
+        nlp (the part which does not change between calls).*/
+    void loadMilpTemplate(OsiTMINLPInterface * nlp, OsiSolverInterface * si);
+
     /// How often to do (code can change)
     int howOften_;
     /// A subsolver for MIP
     SubMipSolver * mip_;
 
     OsiCuts noGoods;
+    /// Number of columns of the MILP loaded in mip_ (-1 if none is loaded)
+    int numberColumns_;
+    /// Integer columns of the MILP
+    std::vector<int> idxIntegers_;
+    /// Number of cuts of noGoods already added to the MILP
+    int numberNoGoodsApplied_;
   };
 }
 #endif
@@ -9,6 +9,7 @@
 #include "BonPumpForMinlp.hpp"
 #include "CbcModel.hpp"
 #include "OsiBranchingObject.hpp"
+#include "BonProfiler.hpp"
 
 namespace Bonmin {
 
@@ -35,6 +36,7 @@ namespace Bonmin {
   int
   PumpForMinlp::solution(double & objectiveValue,
                                  double * newSolution){
+    ProfileTimer timer(Profiler::Heuristic);
     if(model_->getNodeCount() || model_->getCurrentPassNumber() > 1) return 0;
     if(model_->getSolutionCount()) return 0;
     //int numberObjects = model_->numberObjects();
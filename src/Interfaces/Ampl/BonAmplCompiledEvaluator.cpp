@@ -0,0 +1,895 @@
+// (C) Copyright Bonmin contributors 2026
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+//
+// Date : 10/19/2026
+
+#include "BonAmplCompiledEvaluator.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <map>
+#include <sstream>
+
+#include "CoinFinite.hpp"
+#include "CoinHelperFunctions.hpp"
+
+#include "asl.h"
+#include "nlp.h"
+#include "opcode.hd"
+
+using namespace Ipopt;
+
+namespace Bonmin
+{
+
+  /** Replacement for ASL's evaluation functions table: reading the model
+      with it puts the operator numbers in the op fields of the expressions.*/
+  static efunc ** opcodeTable()
+  {
+    static efunc * table[N_OPS];
+    for (int i = 0 ; i < N_OPS ; i++) {
+      table[i] = reinterpret_cast<efunc *>(static_cast<size_t>(i));
+    }
+    return table;
+  }
+
+  static inline int opcode(const expr * e)
+  {
+    return static_cast<int>(reinterpret_cast<size_t>(e->op));
+  }
+
+  struct AmplCompiledEvaluator::Compiler
+  {
+    Compiler(AmplCompiledEvaluator & ev, ASL_fg * a):
+        ev_(ev), asl_(a), tape_(NULL), varRegs_(), definedRegs_()
+    {}
+
+    /** Compile the nonlinear expression e into t.*/
+    void compileTape(Tape & t, expr * e)
+    {
+      tape_ = &t;
+      varRegs_.clear();
+      definedRegs_.clear();
+      t.begin = static_cast<int>(ev_.instructions_.size());
+      t.out = compile(e);
+      t.end = static_cast<int>(ev_.instructions_.size());
+    }
+
+    int emit(int code, int a, int b, double c)
+    {
+      ev_.instructions_.push_back(Instruction(code, a, b, c));
+      return static_cast<int>(ev_.instructions_.size()) - 1;
+    }
+
+    int unsupported(int op)
+    {
+      if (ev_.compiled_) {
+        std::stringstream s;
+        s<<"operator "<<op<<" is not supported";
+        ev_.reason_ = s.str();
+      }
+      ev_.compiled_ = false;
+      return emit(opConst, -1, -1, 0.);
+    }
+
+    /** Index of a variable referenced by an expression or a linear term.*/
+    int varIndex(const void * p) const
+    {
+      ASL_fg * asl = asl_;
+      return static_cast<int>((reinterpret_cast<const char *>(p) - reinterpret_cast<const char *>(var_e))
+          / sizeof(expr_v));
+    }
+
+    /** Register holding variable (or defined variable) j.*/
+    int variable(int j)
+    {
+      ASL_fg * asl = asl_;
+      if (j < n_var) {
+        std::map<int, int>::iterator k = varRegs_.find(j);
+        if (k != varRegs_.end())
+          return k->second;
+        int r = emit(opVar, j, static_cast<int>(tape_->vars.size()), 0.);
+        tape_->vars.push_back(j);
+        tape_->varInstr.push_back(r);
+        varRegs_[j] = r;
+        return r;
+      }
+      std::map<int, int>::iterator k = definedRegs_.find(j);
+      if (k != definedRegs_.end())
+        return k->second;
+
+      // Defined variable: nonlinear expression plus linear terms.
+      int ncom0 = comb + comc + como;
+      int d = j - n_var;
+      expr * e = NULL;
+      int nlin = 0;
+      linpart * L = NULL;
+      if (d < ncom0) {
+        e = cexps[d].e;
+        nlin = cexps[d].nlin;
+        L = cexps[d].L;
+      }
+      else {
+        e = cexps1[d - ncom0].e;
+        nlin = cexps1[d - ncom0].nlin;
+        L = cexps1[d - ncom0].L;
+      }
+      int r = compile(e);
+      if (nlin > 0) {
+        std::vector<int> terms(1, r);
+        for (int i = 0 ; i < nlin ; i++) {
+          int v = variable(varIndex(L[i].v.rp));
+          terms.push_back(emit(opScale, v, -1, L[i].fac));
+        }
+        r = sum(terms);
+      }
+      definedRegs_[j] = r;
+      return r;
+    }
+
+    int sum(const std::vector<int> & terms)
+    {
+      int start = static_cast<int>(ev_.args_.size());
+      ev_.args_.insert(ev_.args_.end(), terms.begin(), terms.end());
+      return emit(opSum, start, static_cast<int>(terms.size()), 0.);
+    }
+
+    int unary(int code, expr * e)
+    {
+      int a = compile(e->L.e);
+      return emit(code, a, -1, 0.);
+    }
+
+    int binary(int code, expr * e)
+    {
+      int a = compile(e->L.e);
+      int b = compile(e->R.e);
+      return emit(code, a, b, 0.);
+    }
+
+    int compile(expr * e)
+    {
+      int op = opcode(e);
+      switch (op) {
+      case OPNUM:
+        return emit(opConst, -1, -1, reinterpret_cast<expr_n *>(e)->v);
+      case OPVARVAL:
+        return variable(varIndex(e));
+      case OPPLUS:
+        return binary(opPlus, e);
+      case OPMINUS:
+        return binary(opMinus, e);
+      case OPMULT:
+        return binary(opMult, e);
+      case OPDIV:
+        return binary(opDiv, e);
+      case OPPOW:
+        return binary(opPow, e);
+      case OP2POW:
+        return unary(opSqr, e);
+      case OP1POW: {
+          int a = compile(e->L.e);
+          return emit(opPowConst, a, -1, reinterpret_cast<expr_n *>(e->R.e)->v);
+        }
+      case OPCPOW: {
+          int a = compile(e->R.e);
+          return emit(opConstPow, a, -1, reinterpret_cast<expr_n *>(e->L.e)->v);
+        }
+      case OPSUMLIST: {
+          std::vector<int> terms;
+          for (expr ** ep = e->L.ep ; ep < e->R.ep ; ep++) {
+            terms.push_back(compile(*ep));
+          }
+          return sum(terms);
+        }
+      case OPUMINUS:
+        return unary(opNeg, e);
+      case ABS:
+        return unary(opAbs, e);
+      case OP_sqrt:
+        return unary(opSqrt, e);
+      case OP_exp:
+        return unary(opExp, e);
+      case OP_log:
+        return unary(opLog, e);
+      case OP_log10:
+        return unary(opLog10, e);
+      case OP_sin:
+        return unary(opSin, e);
+      case OP_cos:
+        return unary(opCos, e);
+      case OP_tan:
+        return unary(opTan, e);
+      case OP_sinh:
+        return unary(opSinh, e);
+      case OP_cosh:
+        return unary(opCosh, e);
+      case OP_tanh:
+        return unary(opTanh, e);
+      case OP_asin:
+        return unary(opAsin, e);
+      case OP_acos:
+        return unary(opAcos, e);
+      case OP_atan:
+        return unary(opAtan, e);
+      case OP_asinh:
+        return unary(opAsinh, e);
+      case OP_acosh:
+        return unary(opAcosh, e);
+      case OP_atanh:
+        return unary(opAtanh, e);
+      default:
+        return unsupported(op);
+      }
+    }
+
+    /** Local index of each variable of t in its list of linear terms.*/
+    void setVarSlots(Tape & t)
+    {
+      std::map<int, int> slot;
+      for (unsigned int i = 0 ; i < t.linVars.size() ; i++) {
+        slot[t.linVars[i]] = i;
+      }
+      t.varSlot.resize(t.vars.size());
+      for (unsigned int l = 0 ; l < t.vars.size() ; l++) {
+        std::map<int, int>::iterator k = slot.find(t.vars[l]);
+        if (k == slot.end()) {
+          // Should not happen, ASL lists all variables of a function.
+          t.linVars.push_back(t.vars[l]);
+          t.linCoefs.push_back(0.);
+          t.varSlot[l] = static_cast<int>(t.linVars.size()) - 1;
+        }
+        else {
+          t.varSlot[l] = k->second;
+        }
+      }
+    }
+
+    void compileModel(int obj_no)
+    {
+      ASL_fg * asl = asl_;
+      ev_.rows_.resize(n_con);
+      for (int i = 0 ; i < n_con ; i++) {
+        Tape & t = ev_.rows_[i];
+        compileTape(t, con_de[i].e);
+        for (cgrad * cg = Cgrad[i] ; cg ; cg = cg->next) {
+          t.linVars.push_back(cg->varno);
+          t.linCoefs.push_back(cg->coef);
+        }
+        setVarSlots(t);
+      }
+      ev_.hasObj_ = obj_no >= 0 && obj_no < n_obj;
+      if (ev_.hasObj_) {
+        Tape & t = ev_.obj_;
+        compileTape(t, obj_de[obj_no].e);
+        for (ograd * og = Ograd[obj_no] ; og ; og = og->next) {
+          t.linVars.push_back(og->varno);
+          t.linCoefs.push_back(og->coef);
+        }
+        setVarSlots(t);
+      }
+    }
+
+    AmplCompiledEvaluator & ev_;
+    ASL_fg * asl_;
+    Tape * tape_;
+    /** Registers of the variables already loaded in the current tape.*/
+    std::map<int, int> varRegs_;
+    /** Registers of the defined variables already computed in the current tape.*/
+    std::map<int, int> definedRegs_;
+  };
+
+  AmplCompiledEvaluator::AmplCompiledEvaluator(const ASL_pfgh * main):
+      compiled_(true),
+      reason_(),
+      n_(0),
+      objSign_(1.),
+      instructions_(),
+      args_(),
+      rows_(),
+      obj_(),
+      hasObj_(false),
+      v_(),
+      adj_(),
+      dot_(),
+      adjDot_(),
+      partials_(),
+      stamp_(0)
+  {
+    const ASL * m = reinterpret_cast<const ASL *>(main);
+    if (m->i.filename_ == NULL || m->i.stub_end_ == NULL) {
+      compiled_ = false;
+      reason_ = "model was not read from a .nl file";
+      return;
+    }
+    std::string stub(m->i.filename_, m->i.stub_end_ - m->i.filename_);
+    int obj_no = m->i.obj_no_;
+    if (obj_no >= 0 && obj_no < m->i.n_obj_ && m->i.objtype_[obj_no] != 0)
+      objSign_ = -1.;
+    n_ = m->i.n_var_;
+
+    // ASL_alloc changes the current ASL, restore it once done.
+    ASL * current = ::cur_ASL;
+    ASL_fg * asl = reinterpret_cast<ASL_fg *>(ASL_alloc(ASL_read_fg));
+    FILE * nl = jac0dim(const_cast<char *>(stub.c_str()), static_cast<fint>(stub.size()));
+    want_derivs = 0;
+    asl->I.r_ops_ = opcodeTable();
+    int retcode = fg_read(nl, ASL_return_read_err);
+    asl->I.r_ops_ = NULL;
+    if (retcode != ASL_readerr_none) {
+      compiled_ = false;
+      reason_ = "error reading " + stub + ".nl";
+    }
+    else {
+      Compiler compiler(*this, asl);
+      compiler.compileModel(obj_no);
+    }
+    ASL_free(reinterpret_cast<ASL **>(&asl));
+    ::cur_ASL = current;
+
+    size_t size = instructions_.size();
+    v_.resize(size);
+    adj_.resize(size);
+    dot_.resize(size);
+    adjDot_.resize(size);
+  }
+
+  AmplCompiledEvaluator::~AmplCompiledEvaluator()
+  {}
+
+  void
+  AmplCompiledEvaluator::setJacobianStructure(Index nele_jac, const Index* iRow,
+      const Index* jCol, TNLP::IndexStyleEnum index_style)
+  {
+    int offset = (index_style == TNLP::FORTRAN_STYLE);
+    std::map<std::pair<int, int>, int> positions;
+    for (int k = 0 ; k < nele_jac ; k++) {
+      positions[std::make_pair(iRow[k] - offset, jCol[k] - offset)] = k;
+    }
+    for (unsigned int i = 0 ; i < rows_.size() ; i++) {
+      Tape & t = rows_[i];
+      t.jacPos.resize(t.linVars.size());
+      for (unsigned int e = 0 ; e < t.linVars.size() ; e++) {
+        std::map<std::pair<int, int>, int>::iterator k =
+          positions.find(std::make_pair(static_cast<int>(i), t.linVars[e]));
+        t.jacPos[e] = (k == positions.end()) ? -1 : k->second;
+      }
+    }
+  }
+
+  /** Positions in the Hessian of the pairs of variables of t.*/
+  static void
+  setHessianPositions(std::vector<int> & hessPos, const std::vector<int> & vars,
+      const std::map<std::pair<int, int>, int> & positions)
+  {
+    int p = static_cast<int>(vars.size());
+    hessPos.resize(p * (p + 1) / 2);
+    for (int l = 0 ; l < p ; l++) {
+      for (int k = 0 ; k <= l ; k++) {
+        int i = std::min(vars[l], vars[k]);
+        int j = std::max(vars[l], vars[k]);
+        std::map<std::pair<int, int>, int>::const_iterator f =
+          positions.find(std::make_pair(i, j));
+        hessPos[l * (l + 1) / 2 + k] = (f == positions.end()) ? -1 : f->second;
+      }
+    }
+  }
+
+  void
+  AmplCompiledEvaluator::setHessianStructure(Index nele_hess, const Index* iRow,
+      const Index* jCol, TNLP::IndexStyleEnum index_style)
+  {
+    int offset = (index_style == TNLP::FORTRAN_STYLE);
+    std::map<std::pair<int, int>, int> positions;
+    for (int k = 0 ; k < nele_hess ; k++) {
+      int i = iRow[k] - offset;
+      int j = jCol[k] - offset;
+      positions[std::make_pair(std::min(i,j), std::max(i,j))] = k;
+    }
+    for (unsigned int i = 0 ; i < rows_.size() ; i++) {
+      setHessianPositions(rows_[i].hessPos, rows_[i].vars, positions);
+    }
+    if (hasObj_)
+      setHessianPositions(obj_.hessPos, obj_.vars, positions);
+  }
+
+  void
+  AmplCompiledEvaluator::newPoint(bool new_x)
+  {
+    if (new_x)
+      stamp_++;
+  }
+
+  bool
+  AmplCompiledEvaluator::forward(Tape & t, const Number* x)
+  {
+    if (t.stamp == stamp_)
+      return CoinFinite(v_[t.out]);
+    double * v = v_.empty() ? NULL : &v_[0];
+    for (int k = t.begin ; k < t.end ; k++) {
+      const Instruction & ins = instructions_[k];
+      switch (ins.code) {
+      case opConst:
+        v[k] = ins.c;
+        break;
+      case opVar:
+        v[k] = x[ins.a];
+        break;
+      case opPlus:
+        v[k] = v[ins.a] + v[ins.b];
+        break;
+      case opMinus:
+        v[k] = v[ins.a] - v[ins.b];
+        break;
+      case opMult:
+        v[k] = v[ins.a] * v[ins.b];
+        break;
+      case opDiv:
+        v[k] = v[ins.a] / v[ins.b];
+        break;
+      case opPow:
+        v[k] = pow(v[ins.a], v[ins.b]);
+        break;
+      case opSum: {
+          const int * arg = &args_[ins.a];
+          double s = 0.;
+          for (int i = 0 ; i < ins.b ; i++)
+            s += v[arg[i]];
+          v[k] = s;
+        }
+        break;
+      case opNeg:
+        v[k] = - v[ins.a];
+        break;
+      case opScale:
+        v[k] = ins.c * v[ins.a];
+        break;
+      case opSqr:
+        v[k] = v[ins.a] * v[ins.a];
+        break;
+      case opPowConst:
+        v[k] = pow(v[ins.a], ins.c);
+        break;
+      case opConstPow:
+        v[k] = pow(ins.c, v[ins.a]);
+        break;
+      case opAbs:
+        v[k] = fabs(v[ins.a]);
+        break;
+      case opSqrt:
+        v[k] = sqrt(v[ins.a]);
+        break;
+      case opExp:
+        v[k] = exp(v[ins.a]);
+        break;
+      case opLog:
+        v[k] = log(v[ins.a]);
+        break;
+      case opLog10:
+        v[k] = log10(v[ins.a]);
+        break;
+      case opSin:
+        v[k] = sin(v[ins.a]);
+        break;
+      case opCos:
+        v[k] = cos(v[ins.a]);
+        break;
+      case opTan:
+        v[k] = tan(v[ins.a]);
+        break;
+      case opSinh:
+        v[k] = sinh(v[ins.a]);
+        break;
+      case opCosh:
+        v[k] = cosh(v[ins.a]);
+        break;
+      case opTanh:
+        v[k] = tanh(v[ins.a]);
+        break;
+      case opAsin:
+        v[k] = asin(v[ins.a]);
+        break;
+      case opAcos:
+        v[k] = acos(v[ins.a]);
+        break;
+      case opAtan:
+        v[k] = atan(v[ins.a]);
+        break;
+      case opAsinh:
+        v[k] = asinh(v[ins.a]);
+        break;
+      case opAcosh:
+        v[k] = acosh(v[ins.a]);
+        break;
+      case opAtanh:
+        v[k] = atanh(v[ins.a]);
+        break;
+      }
+    }
+    t.stamp = stamp_;
+    return CoinFinite(v[t.out]);
+  }
+
+  double
+  AmplCompiledEvaluator::value(const Tape & t, const Number* x) const
+  {
+    double val = v_[t.out];
+    for (unsigned int e = 0 ; e < t.linVars.size() ; e++)
+      val += t.linCoefs[e] * x[t.linVars[e]];
+    return val;
+  }
+
+  void
+  AmplCompiledEvaluator::partials(int k, Partials & p) const
+  {
+    const Instruction & ins = instructions_[k];
+    p.da = p.db = p.daa = p.dab = p.dbb = 0.;
+    if (ins.code == opConst || ins.code == opVar || ins.code == opSum)
+      return;
+    const double * v = &v_[0];
+    double y = v[k];
+    double u = v[ins.a];
+    switch (ins.code) {
+    case opPlus:
+      p.da = 1.;
+      p.db = 1.;
+      break;
+    case opMinus:
+      p.da = 1.;
+      p.db = -1.;
+      break;
+    case opMult:
+      p.da = v[ins.b];
+      p.db = u;
+      p.dab = 1.;
+      break;
+    case opDiv: {
+        double w = v[ins.b];
+        p.da = 1. / w;
+        p.db = - u / (w * w);
+        p.dab = - 1. / (w * w);
+        p.dbb = 2. * u / (w * w * w);
+      }
+      break;
+    case opPow: {
+        double w = v[ins.b];
+        double lu = u > 0. ? log(u) : 0.;
+        double um1 = pow(u, w - 1.);
+        p.da = w * um1;
+        p.db = y * lu;
+        p.daa = w * (w - 1.) * pow(u, w - 2.);
+        p.dab = um1 * (1. + w * lu);
+        p.dbb = y * lu * lu;
+      }
+      break;
+    case opNeg:
+      p.da = -1.;
+      break;
+    case opScale:
+      p.da = ins.c;
+      break;
+    case opSqr:
+      p.da = 2. * u;
+      p.daa = 2.;
+      break;
+    case opPowConst:
+      p.da = ins.c * pow(u, ins.c - 1.);
+      p.daa = ins.c * (ins.c - 1.) * pow(u, ins.c - 2.);
+      break;
+    case opConstPow: {
+        double lc = log(ins.c);
+        p.da = y * lc;
+        p.daa = y * lc * lc;
+      }
+      break;
+    case opAbs:
+      p.da = u >= 0. ? 1. : -1.;
+      break;
+    case opSqrt:
+      p.da = 0.5 / y;
+      p.daa = -0.25 / (y * u);
+      break;
+    case opExp:
+      p.da = y;
+      p.daa = y;
+      break;
+    case opLog:
+      p.da = 1. / u;
+      p.daa = - 1. / (u * u);
+      break;
+    case opLog10:
+      p.da = 1. / (u * log(10.));
+      p.daa = - 1. / (u * u * log(10.));
+      break;
+    case opSin:
+      p.da = cos(u);
+      p.daa = - y;
+      break;
+    case opCos:
+      p.da = - sin(u);
+      p.daa = - y;
+      break;
+    case opTan:
+      p.da = 1. + y * y;
+      p.daa = 2. * y * (1. + y * y);
+      break;
+    case opSinh:
+      p.da = cosh(u);
+      p.daa = y;
+      break;
+    case opCosh:
+      p.da = sinh(u);
+      p.daa = y;
+      break;
+    case opTanh:
+      p.da = 1. - y * y;
+      p.daa = - 2. * y * (1. - y * y);
+      break;
+    case opAsin: {
+        double s = 1. - u * u;
+        p.da = 1. / sqrt(s);
+        p.daa = u / (s * sqrt(s));
+      }
+      break;
+    case opAcos: {
+        double s = 1. - u * u;
+        p.da = - 1. / sqrt(s);
+        p.daa = - u / (s * sqrt(s));
+      }
+      break;
+    case opAtan: {
+        double s = 1. + u * u;
+        p.da = 1. / s;
+        p.daa = - 2. * u / (s * s);
+      }
+      break;
+    case opAsinh: {
+        double s = 1. + u * u;
+        p.da = 1. / sqrt(s);
+        p.daa = - u / (s * sqrt(s));
+      }
+      break;
+    case opAcosh: {
+        double s = u * u - 1.;
+        p.da = 1. / sqrt(s);
+        p.daa = - u / (s * sqrt(s));
+      }
+      break;
+    case opAtanh: {
+        double s = 1. - u * u;
+        p.da = 1. / s;
+        p.daa = 2. * u / (s * s);
+      }
+      break;
+    default:
+      break;
+    }
+  }
+
+  void
+  AmplCompiledEvaluator::reverse(const Tape & t)
+  {
+    double * adj = &adj_[0];
+    for (int k = t.begin ; k < t.end ; k++)
+      adj[k] = 0.;
+    adj[t.out] = 1.;
+    Partials p;
+    for (int k = t.end - 1 ; k >= t.begin ; k--) {
+      double w = adj[k];
+      if (w == 0.)
+        continue;
+      const Instruction & ins = instructions_[k];
+      switch (ins.code) {
+      case opConst:
+      case opVar:
+        break;
+      case opSum: {
+          const int * arg = &args_[ins.a];
+          for (int i = 0 ; i < ins.b ; i++)
+            adj[arg[i]] += w;
+        }
+        break;
+      default:
+        partials(k, p);
+        adj[ins.a] += w * p.da;
+        if (isBinary(ins.code))
+          adj[ins.b] += w * p.db;
+        break;
+      }
+    }
+  }
+
+  void
+  AmplCompiledEvaluator::addHessian(const Tape & t, double weight, Number* values)
+  {
+    int p = static_cast<int>(t.vars.size());
+    if (p == 0)
+      return;
+    reverse(t);
+    partials_.resize(t.end - t.begin);
+    for (int k = t.begin ; k < t.end ; k++)
+      partials(k, partials_[k - t.begin]);
+
+    const double * adj = &adj_[0];
+    double * dot = &dot_[0];
+    double * adjDot = &adjDot_[0];
+    for (int s = 0 ; s < p ; s++) {
+      // Forward tangent sweep in direction of the s-th variable.
+      for (int k = t.begin ; k < t.end ; k++) {
+        const Instruction & ins = instructions_[k];
+        const Partials & pk = partials_[k - t.begin];
+        switch (ins.code) {
+        case opConst:
+          dot[k] = 0.;
+          break;
+        case opVar:
+          dot[k] = (ins.b == s) ? 1. : 0.;
+          break;
+        case opSum: {
+            const int * arg = &args_[ins.a];
+            double d = 0.;
+            for (int i = 0 ; i < ins.b ; i++)
+              d += dot[arg[i]];
+            dot[k] = d;
+          }
+          break;
+        default:
+          dot[k] = pk.da * dot[ins.a];
+          if (isBinary(ins.code))
+            dot[k] += pk.db * dot[ins.b];
+          break;
+        }
+        adjDot[k] = 0.;
+      }
+      // Reverse sweep of the second order adjoints.
+      for (int k = t.end - 1 ; k >= t.begin ; k--) {
+        double w = adj[k];
+        double wd = adjDot[k];
+        if (w == 0. && wd == 0.)
+          continue;
+        const Instruction & ins = instructions_[k];
+        const Partials & pk = partials_[k - t.begin];
+        switch (ins.code) {
+        case opConst:
+        case opVar:
+          break;
+        case opSum: {
+            const int * arg = &args_[ins.a];
+            for (int i = 0 ; i < ins.b ; i++)
+              adjDot[arg[i]] += wd;
+          }
+          break;
+        default:
+          if (isBinary(ins.code)) {
+            adjDot[ins.a] += wd * pk.da + w * (pk.daa * dot[ins.a] + pk.dab * dot[ins.b]);
+            adjDot[ins.b] += wd * pk.db + w * (pk.dab * dot[ins.a] + pk.dbb * dot[ins.b]);
+          }
+          else {
+            adjDot[ins.a] += wd * pk.da + w * pk.daa * dot[ins.a];
+          }
+          break;
+        }
+      }
+      // Column s of the Hessian (lower triangle only).
+      for (int l = s ; l < p ; l++) {
+        int pos = t.hessPos[l * (l + 1) / 2 + s];
+        if (pos >= 0)
+          values[pos] += weight * adjDot[t.varInstr[l]];
+      }
+    }
+  }
+
+  bool
+  AmplCompiledEvaluator::eval_f(Index n, const Number* x, bool new_x,
+      Number& obj_value)
+  {
+    newPoint(new_x);
+    obj_value = 0.;
+    if (!hasObj_)
+      return true;
+    if (!forward(obj_, x))
+      return false;
+    obj_value = objSign_ * value(obj_, x);
+    return true;
+  }
+
+  bool
+  AmplCompiledEvaluator::eval_grad_f(Index n, const Number* x, bool new_x,
+      Number* grad_f)
+  {
+    newPoint(new_x);
+    CoinZeroN(grad_f, n);
+    if (!hasObj_)
+      return true;
+    if (!forward(obj_, x))
+      return false;
+    reverse(obj_);
+    for (unsigned int e = 0 ; e < obj_.linVars.size() ; e++)
+      grad_f[obj_.linVars[e]] += objSign_ * obj_.linCoefs[e];
+    for (unsigned int l = 0 ; l < obj_.vars.size() ; l++)
+      grad_f[obj_.vars[l]] += objSign_ * adj_[obj_.varInstr[l]];
+    return true;
+  }
+
+  bool
+  AmplCompiledEvaluator::eval_g(Index n, const Number* x, bool new_x,
+      Index m, Number* g)
+  {
+    newPoint(new_x);
+    for (int i = 0 ; i < m ; i++) {
+      if (!forward(rows_[i], x))
+        return false;
+      g[i] = value(rows_[i], x);
+    }
+    return true;
+  }
+
+  bool
+  AmplCompiledEvaluator::eval_jac_g(Index n, const Number* x, bool new_x,
+      Index m, Index nele_jac, Number* values)
+  {
+    newPoint(new_x);
+    for (int i = 0 ; i < m ; i++) {
+      Tape & t = rows_[i];
+      for (unsigned int e = 0 ; e < t.linVars.size() ; e++) {
+        if (t.jacPos[e] >= 0)
+          values[t.jacPos[e]] = t.linCoefs[e];
+      }
+      if (t.vars.empty())
+        continue;
+      if (!forward(t, x))
+        return false;
+      reverse(t);
+      for (unsigned int l = 0 ; l < t.vars.size() ; l++) {
+        int pos = t.jacPos[t.varSlot[l]];
+        if (pos >= 0)
+          values[pos] += adj_[t.varInstr[l]];
+      }
+    }
+    return true;
+  }
+
+  bool
+  AmplCompiledEvaluator::eval_gi_and_grad_gi(Index n, const Number* x, bool new_x,
+      Index i, Number& gi, Number* values)
+  {
+    newPoint(new_x);
+    Tape & t = rows_[i];
+    if (!forward(t, x))
+      return false;
+    gi = value(t, x);
+    for (unsigned int e = 0 ; e < t.linVars.size() ; e++)
+      values[e] = t.linCoefs[e];
+    if (t.vars.empty())
+      return true;
+    reverse(t);
+    for (unsigned int l = 0 ; l < t.vars.size() ; l++)
+      values[t.varSlot[l]] += adj_[t.varInstr[l]];
+    return true;
+  }
+
+  bool
+  AmplCompiledEvaluator::eval_h(Index n, const Number* x, bool new_x,
+      Number obj_factor, Index m, const Number* lambda,
+      Index nele_hess, Number* values)
+  {
+    newPoint(new_x);
+    CoinZeroN(values, nele_hess);
+    if (hasObj_ && obj_factor != 0.) {
+      if (!forward(obj_, x))
+        return false;
+      addHessian(obj_, objSign_ * obj_factor, values);
+    }
+    for (int i = 0 ; i < m ; i++) {
+      if (lambda[i] == 0.)
+        continue;
+      if (!forward(rows_[i], x))
+        return false;
+      addHessian(rows_[i], lambda[i], values);
+    }
+    return true;
+  }
+
+} // namespace Bonmin
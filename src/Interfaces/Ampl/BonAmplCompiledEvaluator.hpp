@@ -0,0 +1,228 @@
+// (C) Copyright Bonmin contributors 2026
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+//
+// Date : 10/19/2026
+
+#ifndef BonAmplCompiledEvaluator_HPP
+#define BonAmplCompiledEvaluator_HPP
+
+#include <string>
+#include <vector>
+
+#include "IpTNLP.hpp"
+
+/* non Ipopt forward declaration */
+struct ASL_pfgh;
+
+namespace Bonmin
+{
+
+  /** Compiled evaluator for AMPL models.
+   *  Reads the expression graph of the .nl file of a model once and
+   *  compiles the nonlinear part of each constraint and of the objective
+   *  into a flat tape of instructions (each instruction writes its own
+   *  register, operands are earlier registers). Evaluations then run over
+   *  these tapes instead of walking ASL's expression trees:
+   *  - values are obtained by a forward sweep which is kept until new_x,
+   *  - gradients and Jacobian by a reverse sweep reusing the forward values,
+   *  - Hessian of the Lagrangian by forward-over-reverse sweeps on each tape,
+   *    the first and second order partials of each instruction being
+   *    computed once per tape and shared by all directions.
+   *
+   *  Only the operators which are smooth almost everywhere (arithmetic,
+   *  powers, elementary functions, sums and defined variables) are compiled.
+   *  If a model uses anything else isCompiled() is false and the
+   *  evaluations should go through ASL.
+   *
+   *  Values are given in the order of the Jacobian and Hessian structures
+   *  passed with setJacobianStructure and setHessianStructure.
+   *  An evaluator is not thread-safe.
+   */
+  class AmplCompiledEvaluator
+  {
+  public:
+    /** Constructor.
+     * \param main ASL of the main model (used to find the .nl file to
+     *  read, the active objective and its sense).*/
+    AmplCompiledEvaluator(const ASL_pfgh * main);
+
+    /** Destructor.*/
+    ~AmplCompiledEvaluator();
+
+    /** Could the whole model be compiled?*/
+    bool isCompiled() const
+    {
+      return compiled_;
+    }
+
+    /** Description of what prevented compilation.*/
+    const std::string & reason() const
+    {
+      return reason_;
+    }
+
+    /** Set the structure of the Jacobian.*/
+    void setJacobianStructure(Ipopt::Index nele_jac, const Ipopt::Index* iRow,
+        const Ipopt::Index* jCol, Ipopt::TNLP::IndexStyleEnum index_style);
+
+    /** Set the structure of the Hessian of the Lagrangian (one triangle).*/
+    void setHessianStructure(Ipopt::Index nele_hess, const Ipopt::Index* iRow,
+        const Ipopt::Index* jCol, Ipopt::TNLP::IndexStyleEnum index_style);
+
+    /** evaluates the objective value.*/
+    bool eval_f(Ipopt::Index n, const Ipopt::Number* x, bool new_x,
+        Ipopt::Number& obj_value);
+
+    /** evaluates the gradient of the objective.*/
+    bool eval_grad_f(Ipopt::Index n, const Ipopt::Number* x, bool new_x,
+        Ipopt::Number* grad_f);
+
+    /** evaluates the constraint residuals.*/
+    bool eval_g(Ipopt::Index n, const Ipopt::Number* x, bool new_x,
+        Ipopt::Index m, Ipopt::Number* g);
+
+    /** evaluates the values of the Jacobian.*/
+    bool eval_jac_g(Ipopt::Index n, const Ipopt::Number* x, bool new_x,
+        Ipopt::Index m, Ipopt::Index nele_jac, Ipopt::Number* values);
+
+    /** evaluates the value and the gradient of constraint i (the gradient
+        is given in the order of ASL's Cgrad list).*/
+    bool eval_gi_and_grad_gi(Ipopt::Index n, const Ipopt::Number* x, bool new_x,
+        Ipopt::Index i, Ipopt::Number& gi, Ipopt::Number* values);
+
+    /** evaluates the values of the Hessian of the Lagrangian.*/
+    bool eval_h(Ipopt::Index n, const Ipopt::Number* x, bool new_x,
+        Ipopt::Number obj_factor, Ipopt::Index m, const Ipopt::Number* lambda,
+        Ipopt::Index nele_hess, Ipopt::Number* values);
+
+  private:
+    /** Builds the tapes from ASL's expression graph.*/
+    struct Compiler;
+    friend struct Compiler;
+
+    /** Instruction codes.*/
+    enum Code {
+      opConst = 0, opVar, opPlus, opMinus, opMult, opDiv, opPow, opSum,
+      opNeg, opScale, opSqr, opPowConst, opConstPow,
+      opAbs, opSqrt, opExp, opLog, opLog10, opSin, opCos, opTan,
+      opSinh, opCosh, opTanh, opAsin, opAcos, opAtan, opAsinh, opAcosh, opAtanh
+    };
+
+    /** Has an instruction with this code two operand registers?*/
+    static bool isBinary(int code)
+    {
+      return code >= opPlus && code <= opPow;
+    }
+
+    /** One instruction of a tape, its result goes into the register with
+        the same index.*/
+    struct Instruction
+    {
+      Instruction(int code_, int a_, int b_, double c_):
+          code(code_), a(a_), b(b_), c(c_)
+      {}
+      /** Operation.*/
+      int code;
+      /** First operand register (variable index for opVar, start in args_ for opSum).*/
+      int a;
+      /** Second operand register (local index of the variable for opVar, number of arguments for opSum).*/
+      int b;
+      /** Constant operand.*/
+      double c;
+    };
+
+    /** First and second order partial derivatives of an instruction.*/
+    struct Partials
+    {
+      double da;
+      double db;
+      double daa;
+      double dab;
+      double dbb;
+    };
+
+    /** Compiled function (a constraint or the objective).*/
+    struct Tape
+    {
+      Tape():
+          begin(0), end(0), out(-1), vars(), varInstr(), varSlot(),
+          linVars(), linCoefs(), jacPos(), hessPos(), stamp(-1)
+      {}
+      /** First instruction.*/
+      int begin;
+      /** Past the last instruction.*/
+      int end;
+      /** Register holding the value of the nonlinear part.*/
+      int out;
+      /** Variables appearing in the nonlinear part.*/
+      std::vector<int> vars;
+      /** Instruction loading each of vars.*/
+      std::vector<int> varInstr;
+      /** Index in linVars of each of vars.*/
+      std::vector<int> varSlot;
+      /** Variables of the function (from ASL's Cgrad or Ograd).*/
+      std::vector<int> linVars;
+      /** Coefficients of the linear part for each of linVars.*/
+      std::vector<double> linCoefs;
+      /** Position in the Jacobian of each of linVars.*/
+      std::vector<int> jacPos;
+      /** Position in the Hessian of each pair of vars (l >= k stored at l*(l+1)/2 + k).*/
+      std::vector<int> hessPos;
+      /** Point for which the forward values are current.*/
+      int stamp;
+    };
+
+    /** Make sure the forward values of t are computed at x.*/
+    bool forward(Tape & t, const Ipopt::Number* x);
+    /** Value of t (nonlinear and linear parts).*/
+    double value(const Tape & t, const Ipopt::Number* x) const;
+    /** Reverse sweep computing the adjoints of the registers of t.*/
+    void reverse(const Tape & t);
+    /** Add weight times the Hessian of t to values.*/
+    void addHessian(const Tape & t, double weight, Ipopt::Number* values);
+    /** Compute first and second order partials of instruction k.*/
+    void partials(int k, Partials & p) const;
+    /** Account for a new point.*/
+    void newPoint(bool new_x);
+
+    /** Copy constructor (not implemented).*/
+    AmplCompiledEvaluator(const AmplCompiledEvaluator &);
+    /** Assignment operator (not implemented).*/
+    AmplCompiledEvaluator & operator=(const AmplCompiledEvaluator &);
+
+    /** Could the model be compiled?*/
+    bool compiled_;
+    /** What prevented compilation.*/
+    std::string reason_;
+    /** Number of variables.*/
+    int n_;
+    /** Sign of the objective (-1 if maximizing).*/
+    double objSign_;
+    /** All instructions.*/
+    std::vector<Instruction> instructions_;
+    /** Arguments of opSum instructions.*/
+    std::vector<int> args_;
+    /** Constraints tapes.*/
+    std::vector<Tape> rows_;
+    /** Objective tape.*/
+    Tape obj_;
+    /** Has the model an objective?*/
+    bool hasObj_;
+    /** Registers values.*/
+    std::vector<double> v_;
+    /** Registers adjoints.*/
+    std::vector<double> adj_;
+    /** Registers tangents (Hessian directions).*/
+    std::vector<double> dot_;
+    /** Registers second order adjoints.*/
+    std::vector<double> adjDot_;
+    /** Partials of the instructions of the current tape.*/
+    std::vector<Partials> partials_;
+    /** Current point.*/
+    int stamp_;
+  };
+
+} // namespace Bonmin
+
+#endif
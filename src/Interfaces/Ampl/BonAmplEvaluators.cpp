@@ -0,0 +1,149 @@
+// (C) Copyright Bonmin contributors 2026
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+//
+// Date : 10/19/2026
+
+#include "BonAmplEvaluators.hpp"
+#include "CoinError.hpp"
+
+#include "asl.h"
+#include "asl_pfgh.h"
+
+using namespace Ipopt;
+
+namespace Bonmin
+{
+
+  struct AmplEvaluatorPool::Evaluator
+  {
+    /** ASL object of this copy of the model.*/
+    ASL_pfgh * asl;
+    /** Mutex protecting this copy (several threads may share a copy).*/
+    std::mutex mutex;
+    /** Last thread which has set the current point.*/
+    std::thread::id lastUser;
+    /** Has a point been set?*/
+    bool hasPoint;
+  };
+
+  AmplEvaluatorPool::AmplEvaluatorPool(const ASL_pfgh * main, int size):
+      evaluators_(),
+      slots_(),
+      slotsMutex_()
+  {
+    ASL_pfgh * asl = const_cast<ASL_pfgh *>(main);
+    if (filename == NULL || stub_end == NULL) {
+      throw CoinError("Can not find the .nl file of the model.",
+                      "AmplEvaluatorPool","Bonmin::AmplEvaluatorPool");
+    }
+    std::string stub(filename, stub_end - filename);
+
+    // ASL_alloc changes the current ASL, restore it once done.
+    ASL * current = ::cur_ASL;
+    for (int k = 0 ; k < size ; k++) {
+      asl = reinterpret_cast<ASL_pfgh *>(ASL_alloc(ASL_read_pfgh));
+      FILE * nl = jac0dim(const_cast<char *>(stub.c_str()), static_cast<fint>(stub.size()));
+      int retcode = pfgh_read(nl, ASL_return_read_err | ASL_findgroups);
+      if (retcode != ASL_readerr_none) {
+        ASL_free(reinterpret_cast<ASL **>(&asl));
+        ::cur_ASL = current;
+        throw CoinError("Error reading .nl file " + stub + ".",
+                        "AmplEvaluatorPool","Bonmin::AmplEvaluatorPool");
+      }
+      // congrd only fills in the nonzeroes of the gradient.
+      asl->i.congrd_mode = 1;
+      Evaluator * e = new Evaluator;
+      e->asl = asl;
+      e->hasPoint = false;
+      evaluators_.push_back(e);
+    }
+    ::cur_ASL = current;
+  }
+
+  AmplEvaluatorPool::~AmplEvaluatorPool()
+  {
+    ASL * current = ::cur_ASL;
+    for (unsigned int k = 0 ; k < evaluators_.size() ; k++) {
+      ASL * asl = reinterpret_cast<ASL *>(evaluators_[k]->asl);
+      if (asl == current) current = NULL;
+      ASL_free(&asl);
+      delete evaluators_[k];
+    }
+    ::cur_ASL = current;
+  }
+
+  AmplEvaluatorPool::Evaluator &
+  AmplEvaluatorPool::evaluator()
+  {
+    std::thread::id me = std::this_thread::get_id();
+    std::lock_guard<std::mutex> lock(slotsMutex_);
+    std::map<std::thread::id, int>::iterator k = slots_.find(me);
+    if (k != slots_.end()) {
+      return *evaluators_[k->second];
+    }
+    int slot = static_cast<int>(slots_.size() % evaluators_.size());
+    slots_[me] = slot;
+    return *evaluators_[slot];
+  }
+
+  void
+  AmplEvaluatorPool::set_point(Evaluator & e, const Number* x, bool new_x)
+  {
+    std::thread::id me = std::this_thread::get_id();
+    // If another thread has used this copy since our last call its point
+    // can not be trusted whatever new_x says.
+    if (new_x || !e.hasPoint || e.lastUser != me) {
+      ASL_pfgh * asl = e.asl;
+      xknown(const_cast<real *>(x));
+      e.hasPoint = true;
+      e.lastUser = me;
+    }
+  }
+
+  bool
+  AmplEvaluatorPool::eval_gi(Index n, const Number* x, bool new_x,
+      Index i, Number& gi)
+  {
+    Evaluator & e = evaluator();
+    std::lock_guard<std::mutex> lock(e.mutex);
+    set_point(e, x, new_x);
+
+    ASL_pfgh * asl = e.asl;
+    fint nerror = 0;
+    gi = conival(i, const_cast<real*>(x), &nerror);
+    return nerror == 0;
+  }
+
+  bool
+  AmplEvaluatorPool::eval_grad_gi(Index n, const Number* x, bool new_x,
+      Index i, Number* values)
+  {
+    Evaluator & e = evaluator();
+    std::lock_guard<std::mutex> lock(e.mutex);
+    set_point(e, x, new_x);
+
+    ASL_pfgh * asl = e.asl;
+    fint nerror = 0;
+    congrd(i, const_cast<real*>(x), values, &nerror);
+    return nerror == 0;
+  }
+
+  bool
+  AmplEvaluatorPool::eval_gi_and_grad_gi(Index n, const Number* x, bool new_x,
+      Index i, Number& gi, Number* values)
+  {
+    Evaluator & e = evaluator();
+    std::lock_guard<std::mutex> lock(e.mutex);
+    set_point(e, x, new_x);
+
+    ASL_pfgh * asl = e.asl;
+    fint nerror = 0;
+    gi = conival(i, const_cast<real*>(x), &nerror);
+    if (nerror != 0)
+      return false;
+    congrd(i, const_cast<real*>(x), values, &nerror);
+    return nerror == 0;
+  }
+
+} // namespace Bonmin
@@ -0,0 +1,89 @@
+// (C) Copyright Bonmin contributors 2026
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+//
+// Date : 10/19/2026
+
+#ifndef BonAmplEvaluators_HPP
+#define BonAmplEvaluators_HPP
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "IpTypes.hpp"
+
+/* non Ipopt forward declaration */
+struct ASL_pfgh;
+
+namespace Bonmin
+{
+
+  /** Pool of independent ASL evaluators.
+   *  ASL stores intermediate results of the expression evaluation inside the
+   *  expression graph itself, so one ASL object can not be used by several
+   *  threads at the same time. This class loads the same .nl file several
+   *  times and hands out one copy per calling thread (threads are mapped
+   *  round-robin to the copies, each copy being protected by its own mutex).
+   *  Each copy keeps track of the last point it was evaluated at so that
+   *  new_x is honoured for consecutive calls of the same thread.
+   */
+  class AmplEvaluatorPool
+  {
+  public:
+    /** Constructor.
+     * \param main ASL of the main model (used to find the .nl file to read).
+     * \param size number of independent evaluators to load.*/
+    AmplEvaluatorPool(const ASL_pfgh * main, int size);
+
+    /** Destructor.*/
+    ~AmplEvaluatorPool();
+
+    /** Number of evaluators in the pool.*/
+    int size() const
+    {
+      return static_cast<int>(evaluators_.size());
+    }
+
+    /** compute the value of constraint i at x.*/
+    bool eval_gi(Ipopt::Index n, const Ipopt::Number* x, bool new_x,
+        Ipopt::Index i, Ipopt::Number& gi);
+
+    /** compute the values of the gradient of constraint i at x
+        (in the order given by Cgrad).*/
+    bool eval_grad_gi(Ipopt::Index n, const Ipopt::Number* x, bool new_x,
+        Ipopt::Index i, Ipopt::Number* values);
+
+    /** compute the value and the gradient of constraint i at x
+        (the gradient is computed from the same evaluation as the value).*/
+    bool eval_gi_and_grad_gi(Ipopt::Index n, const Ipopt::Number* x, bool new_x,
+        Ipopt::Index i, Ipopt::Number& gi, Ipopt::Number* values);
+
+  private:
+    /** One independent copy of the model.*/
+    struct Evaluator;
+
+    /** Get the evaluator attached to the calling thread.*/
+    Evaluator & evaluator();
+
+    /** Set x as the current point of e if needed.*/
+    void set_point(Evaluator & e, const Ipopt::Number* x, bool new_x);
+
+    /** Copy constructor (not implemented).*/
+    AmplEvaluatorPool(const AmplEvaluatorPool &);
+    /** Assignment operator (not implemented).*/
+    AmplEvaluatorPool & operator=(const AmplEvaluatorPool &);
+
+    /** The evaluators.*/
+    std::vector<Evaluator *> evaluators_;
+    /** Evaluator attributed to each thread which has called the pool.*/
+    std::map<std::thread::id, int> slots_;
+    /** Mutex protecting slots_.*/
+    std::mutex slotsMutex_;
+  };
+
+} // namespace Bonmin
+
+#endif
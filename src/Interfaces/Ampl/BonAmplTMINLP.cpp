@@ -16,6 +16,8 @@
 
 #include "AmplTNLP.hpp"
 #include "BonAmplTMINLP.hpp"
+#include "BonAmplEvaluators.hpp"
+#include "BonAmplCompiledEvaluator.hpp"
 #include <iostream>
 #include <fstream>
 
@@ -68,6 +70,8 @@ namespace Bonmin
       appName_(),
       upperBoundingObj_(-1),
       ampl_tnlp_(NULL),
+      evaluators_(NULL),
+      compiled_(NULL),
       branch_(),
       sos_(),
       suffix_handler_(NULL),
@@ -93,6 +97,8 @@ namespace Bonmin
       appName_(),
       upperBoundingObj_(-1),
       ampl_tnlp_(NULL),
+      evaluators_(NULL),
+      compiled_(NULL),
       branch_(),
       sos_(),
       suffix_handler_(NULL),
@@ -177,6 +183,27 @@ namespace Bonmin
         ampl_options_list, options_id.c_str(),
         appName.c_str(), appName.c_str(), nl_file_content);
 
+    int num_evaluators;
+    options->GetIntegerValue("num_ampl_evaluators", num_evaluators, "bonmin.");
+    delete evaluators_;
+    evaluators_ = NULL;
+    if (num_evaluators > 0) {
+      if (nl_file_content != NULL) {
+        jnlst_->Printf(J_WARNING, J_MAIN,
+            "num_ampl_evaluators is ignored when the model is not read from a .nl file.\n");
+      }
+      else {
+        evaluators_ = new AmplEvaluatorPool(ampl_tnlp_->AmplSolverObject(), num_evaluators);
+      }
+    }
+
+    int use_compiled;
+    options->GetEnumValue("ampl_compiled_evaluator", use_compiled, "bonmin.");
+    delete compiled_;
+    compiled_ = NULL;
+    if (use_compiled) {
+      setup_compiled_evaluator();
+    }
 
     /* Read suffixes */
     read_obj_suffixes();
@@ -203,11 +230,40 @@ namespace Bonmin
     }
   }
 
+  void
+  AmplTMINLP::setup_compiled_evaluator()
+  {
+    compiled_ = new AmplCompiledEvaluator(ampl_tnlp_->AmplSolverObject());
+    if (!compiled_->isCompiled()) {
+      jnlst_->Printf(J_WARNING, J_MAIN,
+          "Model can not be compiled (%s), evaluations will go through ASL.\n",
+          compiled_->reason().c_str());
+      delete compiled_;
+      compiled_ = NULL;
+      return;
+    }
+    Index n, m, nnz_jac_g, nnz_h_lag;
+    TNLP::IndexStyleEnum index_style;
+    ampl_tnlp_->get_nlp_info(n, m, nnz_jac_g, nnz_h_lag, index_style);
+
+    vector<Index> iRow(nnz_jac_g);
+    vector<Index> jCol(nnz_jac_g);
+    ampl_tnlp_->eval_jac_g(n, NULL, false, m, nnz_jac_g, iRow(), jCol(), NULL);
+    compiled_->setJacobianStructure(nnz_jac_g, iRow(), jCol(), index_style);
+
+    iRow.resize(nnz_h_lag);
+    jCol.resize(nnz_h_lag);
+    ampl_tnlp_->eval_h(n, NULL, false, 1., m, NULL, false, nnz_h_lag, iRow(), jCol(), NULL);
+    compiled_->setHessianStructure(nnz_h_lag, iRow(), jCol(), index_style);
+  }
+
   AmplTMINLP::~AmplTMINLP()
   {
     delete [] constraintsConvexities_;
     delete [] simpleConcaves_;
     delete [] nonConvexConstraintsAndRelaxations_;
+    delete evaluators_;
+    delete compiled_;
     delete ampl_tnlp_;
   }
 
@@ -628,16 +684,25 @@ namespace Bonmin
 
   bool AmplTMINLP::eval_f(Index n, const Number* x, bool new_x, Number& obj_value)
   {
+    if (compiled_ != NULL && x != NULL) {
+      return compiled_->eval_f(n, x, new_x, obj_value);
+    }
     return ampl_tnlp_->eval_f(n, x, new_x, obj_value);
   }
 
   bool AmplTMINLP::eval_grad_f(Index n, const Number* x, bool new_x, Number* grad_f)
   {
+    if (compiled_ != NULL && x != NULL) {
+      return compiled_->eval_grad_f(n, x, new_x, grad_f);
+    }
     return ampl_tnlp_->eval_grad_f(n, x, new_x, grad_f);
   }
 
   bool AmplTMINLP::eval_g(Index n, const Number* x, bool new_x, Index m, Number* g)
   {
+    if (compiled_ != NULL && x != NULL) {
+      return compiled_->eval_g(n, x, new_x, m, g);
+    }
     return ampl_tnlp_->eval_g(n, x, new_x, m, g);
   }
 
@@ -645,6 +710,9 @@ namespace Bonmin
       Index m, Index nele_jac, Index* iRow,
       Index *jCol, Number* values)
   {
+    if (compiled_ != NULL && values != NULL) {
+      return compiled_->eval_jac_g(n, x, new_x, m, nele_jac, values);
+    }
     return ampl_tnlp_->eval_jac_g(n, x, new_x,
         m, nele_jac, iRow, jCol,
         values);
@@ -655,6 +723,10 @@ namespace Bonmin
       bool new_lambda, Index nele_hess, Index* iRow,
       Index* jCol, Number* values)
   {
+    if (compiled_ != NULL && values != NULL) {
+      return compiled_->eval_h(n, x, new_x, obj_factor, m, lambda,
+          nele_hess, values);
+    }
     return ampl_tnlp_->eval_h(n, x, new_x, obj_factor,
         m, lambda, new_lambda, nele_hess, iRow,
         jCol, values);
@@ -663,9 +735,12 @@ namespace Bonmin
   bool AmplTMINLP::eval_gi(Index n, const Number* x, bool new_x,
       Index i, Number& gi)
   {
+    if (evaluators_ != NULL) {
+      return evaluators_->eval_gi(n, x, new_x, i, gi);
+    }
     ASL_pfgh* asl = ampl_tnlp_->AmplSolverObject();
 
-    // ignore new_x for now
+    // The point of ampl_tnlp_ is managed by Ipopt's calls, ignore new_x.
     xunknown();
 
     fint nerror = 0;
@@ -695,7 +770,11 @@ namespace Bonmin
     }
     DBG_ASSERT(values);
 
-    // ignore new_x for now
+    if (evaluators_ != NULL) {
+      return evaluators_->eval_grad_gi(n, x, new_x, i, values);
+    }
+
+    // The point of ampl_tnlp_ is managed by Ipopt's calls, ignore new_x.
     xunknown();
 
     asl->i.congrd_mode = 1;
@@ -709,6 +788,68 @@ namespace Bonmin
     }
   }
 
+  bool AmplTMINLP::get_obj_grad_structure(Index n, Index& nnz_grad_f,
+      Index* jCol)
+  {
+    ASL_pfgh* asl = ampl_tnlp_->AmplSolverObject();
+
+    nnz_grad_f = 0;
+    if (obj_no < 0 || obj_no >= n_obj) {
+      // No objective, the gradient is zero.
+      return true;
+    }
+    for (ograd* og=Ograd[obj_no]; og; og = og->next) {
+      if (jCol) {
+        jCol[nnz_grad_f] = og->varno + 1;
+      }
+      nnz_grad_f++;
+    }
+    return true;
+  }
+
+  bool AmplTMINLP::eval_gi_and_grad_gi(Index n, const Number* x, bool new_x,
+      Index nrows, const Index* rows, Number* g,
+      Index* start, Index* jCol, Number* values)
+  {
+    ASL_pfgh* asl = ampl_tnlp_->AmplSolverObject();
+
+    start[0] = 0;
+    for (Index k = 0 ; k < nrows ; k++) {
+      Index nnz = start[k];
+      for (cgrad* cg=Cgrad[rows[k]]; cg; cg = cg->next) {
+        jCol[nnz++] = cg->varno + 1;
+      }
+      start[k + 1] = nnz;
+    }
+
+    if (compiled_ != NULL || evaluators_ != NULL) {
+      for (Index k = 0 ; k < nrows ; k++) {
+        bool ok = (compiled_ != NULL) ?
+            compiled_->eval_gi_and_grad_gi(n, x, new_x, rows[k], g[k], values + start[k]) :
+            evaluators_->eval_gi_and_grad_gi(n, x, new_x, rows[k], g[k], values + start[k]);
+        if (!ok)
+          return false;
+        new_x = false;
+      }
+      return true;
+    }
+
+    // All rows are evaluated at the same point, computing the value of a
+    // row first lets congrd reuse what conival has stored in the
+    // expression graph instead of walking it again.
+    xknown(const_cast<real*>(x));
+    asl->i.congrd_mode = 1;
+    fint nerror = 0;
+    for (Index k = 0 ; k < nrows && nerror == 0 ; k++) {
+      g[k] = conival(rows[k], const_cast<real*>(x), &nerror);
+      if (nerror == 0)
+        congrd(rows[k], const_cast<real*>(x), values + start[k], &nerror);
+    }
+    // The point of ampl_tnlp_ is managed by Ipopt's calls.
+    xunknown();
+    return nerror == 0;
+  }
+
   void AmplTMINLP::finalize_solution(TMINLP::SolverReturn status,
       Index n, const Number* x, Number obj_value)
   {
@@ -37,6 +37,8 @@ namespace Ipopt
 
 namespace Bonmin
 {
+  class AmplEvaluatorPool;
+  class AmplCompiledEvaluator;
 
   /** Ampl MINLP Interface.
    *  Ampl MINLP Interface, implemented as a TMINLP.
@@ -80,6 +82,9 @@ namespace Bonmin
     /** Read suffixes on objective functions for upper bounding*/
     void read_obj_suffixes();
 
+    /** Compile the model and use the compiled evaluator if possible.*/
+    void setup_compiled_evaluator();
+
     /** Default constructor.*/
     AmplTMINLP();
 
@@ -163,6 +168,15 @@ namespace Bonmin
     virtual bool eval_grad_gi(Ipopt::Index n, const Ipopt::Number* x, bool new_x,
         Ipopt::Index i, Ipopt::Index& nele_grad_gi, Ipopt::Index* jCol,
         Ipopt::Number* values);
+    /** compute the values and gradients of a list of constraints in one
+        pass over their expressions.*/
+    virtual bool eval_gi_and_grad_gi(Ipopt::Index n, const Ipopt::Number* x, bool new_x,
+        Ipopt::Index nrows, const Ipopt::Index* rows, Ipopt::Number* g,
+        Ipopt::Index* start, Ipopt::Index* jCol, Ipopt::Number* values);
+    /** get the structure of the gradient of the objective (from ASL's
+        Ograd list).*/
+    virtual bool get_obj_grad_structure(Ipopt::Index n, Ipopt::Index& nnz_grad_f,
+        Ipopt::Index* jCol);
     //@}
 
     /** @name Solution Methods */
@@ -293,6 +307,12 @@ namespace Bonmin
     int upperBoundingObj_;
     /** pointer to the internal AmplTNLP */
     Ipopt::AmplTNLP* ampl_tnlp_;
+    /** Independent evaluators used by eval_gi and eval_grad_gi (NULL if
+        they go through ampl_tnlp_).*/
+    AmplEvaluatorPool * evaluators_;
+    /** Compiled evaluator used for eval_f, eval_g, their derivatives and the
+        Hessian (NULL if they go through ampl_tnlp_).*/
+    AmplCompiledEvaluator * compiled_;
     /** Journalist */
     Ipopt::SmartPtr<const Ipopt::Journalist> jnlst_;
 
@@ -7,6 +7,8 @@
 //
 // Date : 03/01/2011
 #include "BonSolReader.hpp"
+#include "BonDataFile.hpp"
+#include <cstring>
 #include <fstream>
 #include <iostream>
 
@@ -34,30 +36,41 @@ bool SolReader::readFile()
   if(hasNlExtension)
     fileName.erase(size-3,3);
   fileName+=suffix_;
-  std::ifstream inFile(fileName.c_str());
-  if(!inFile.is_open()) {
+  MappedFile file;
+  if(!file.open(fileName)) {
     return false;
   }
+  int n_cols, n_cols_2;
+  const char * data;
+  if(DataFile::isBinary(file, DataFile::Solution, n_cols, n_cols_2, data)){
+    x_.resize(n_cols);
+    if(n_cols > 0)
+      memcpy(x_(), data, n_cols * sizeof(double));
+    return true;
+  }
+  TextScanner scanner(file.data(), file.data() + file.size());
   std::string token;
-  inFile>>token;
-  assert(token == "bonmin:");
+  if(!scanner.token(token) || token != "bonmin:")
+    return false;
 
   std::string status;
-  inFile>>status;
-  inFile>>token;
+  scanner.token(status);
+  scanner.token(token);
   if(token == "Options"){
     for(int i = 0 ; i < 6 ; i++){
-      inFile>>token;
+      scanner.token(token);
     }
-    int n_cols, n_cols_2;
-    inFile>>n_cols_2>>n_cols;
+    n_cols = n_cols_2 = 0;
+    if(!scanner.number(n_cols_2) || !scanner.number(n_cols) || n_cols < 0)
+      return false;
     if(n_cols != static_cast<int>(x_.size())){
        fprintf(stderr, "Number of columns different %d\n", n_cols);
        x_.resize(n_cols);
     }
   }
-for(size_t i = 0 ; i < x_.size() ; i++){
-     inFile>>x_[i];
+  for(size_t i = 0 ; i < x_.size() ; i++){
+    if(!scanner.number(x_[i]))
+      return false;
   }
   return true;
 }
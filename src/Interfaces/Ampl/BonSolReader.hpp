@@ -44,6 +44,11 @@ public:
     return x_();
   }
 
+  /** Number of variables read.*/
+  int n_cols() const{
+    return static_cast<int>(x_.size());
+  }
+
   /** Set the number of variables in the problem.*/
   void set_n_cols(int n){
     x_.resize(n);
@@ -8,10 +8,51 @@
 // Date : 26/05/2005
 
 #include "BonBoundsReader.hpp"
+#include "BonDataFile.hpp"
+#include "CoinError.hpp"
 
-#include <fstream>
+#include <algorithm>
+#include <cstring>
+#include <vector>
 
 namespace Bonmin {
+/** Read bound changes from scanner into record up to a line "END" if
+    withEnd (ended tells if there was one) or up to the end. Lines starting
+    with '#' are skipped. Returns false on a bad line.*/
+static bool
+readTextRecord(TextScanner & scanner, BoundsReader::Record & record, bool withEnd,
+    bool & ended)
+{
+  ended = false;
+  std::string in;
+  while(scanner.token(in)) {
+    if(in[0] == '#') {
+      scanner.skipLine();
+      continue;
+    }
+    if(withEnd && in == "END") {
+      scanner.skipLine();
+      ended = true;
+      return true;
+    }
+    int index;
+    double bound;
+    if((in != "LO" && in != "UP") || !scanner.number(index) || index < 0 ||
+        !scanner.number(bound))
+      return false;
+    if(in == "LO") {
+      record.indexLowers.push_back(index);
+      record.lowerBounds.push_back(bound);
+    }
+    else {
+      record.indexUppers.push_back(index);
+      record.upperBounds.push_back(bound);
+    }
+    scanner.skipLine();
+  }
+  return true;
+}
+
 BoundsReader::~BoundsReader()
 {
   gutsOfDestructor();
@@ -55,56 +96,105 @@ void BoundsReader::read(const std::string &fileName)
 void BoundsReader::read()
 {
   gutsOfDestructor();
-  //First count the number of lower and upper bounds resp
-  std::string lo="LO";
-  std::string up="UP";
-  std::string in;
-  {
-    std::ifstream fin(fileName_.c_str());
-    //std::streampos begin = fin.tellg();
-    while(!fin.eof()) {
-      fin>>in;
-      if(in==lo)
-        nLower_++;
-      else if(in==up)
-        nUpper_++;
-      else
-        throw;
-      fin.ignore(10000,'\n');
+  MappedFile file;
+  if(!file.open(fileName_))
+    throw CoinError("Can not open bounds file " + fileName_, "read", "BoundsReader");
+  int nLower, nUpper;
+  const char * data;
+  if(DataFile::isBinary(file, DataFile::Bounds, nLower, nUpper, data)) {
+    if(nLower > 0) {
+      indexLowers_ = new int[nLower];
+      lowerBounds_ = new double[nLower];
+      memcpy(indexLowers_, data, nLower * sizeof(int));
+      data += nLower * sizeof(int);
+      memcpy(lowerBounds_, data, nLower * sizeof(double));
+      data += nLower * sizeof(double);
+    }
+    if(nUpper > 0) {
+      indexUppers_ = new int[nUpper];
+      upperBounds_ = new double[nUpper];
+      memcpy(indexUppers_, data, nUpper * sizeof(int));
+      data += nUpper * sizeof(int);
+      memcpy(upperBounds_, data, nUpper * sizeof(double));
     }
+    nLower_ = nLower;
+    nUpper_ = nUpper;
+    return;
   }
+
+  // Text: lines "LO index bound" or "UP index bound", read in one pass.
+  TextScanner scanner(file.data(), file.data() + file.size());
+  Record record;
+  bool ended;
+  if(!readTextRecord(scanner, record, false, ended))
+    throw CoinError("Bad line in bounds file " + fileName_, "read", "BoundsReader");
+  const std::vector<int> & indexLowers = record.indexLowers;
+  const std::vector<int> & indexUppers = record.indexUppers;
+  const std::vector<double> & lowerBounds = record.lowerBounds;
+  const std::vector<double> & upperBounds = record.upperBounds;
+  nLower_ = static_cast<int>(indexLowers.size());
+  nUpper_ = static_cast<int>(indexUppers.size());
   if(nLower_ > 0) {
     lowerBounds_ = new double[nLower_];
     indexLowers_ = new int[nLower_];
+    std::copy(lowerBounds.begin(), lowerBounds.end(), lowerBounds_);
+    std::copy(indexLowers.begin(), indexLowers.end(), indexLowers_);
   }
   if(nUpper_ > 0) {
     upperBounds_ = new double[nUpper_];
     indexUppers_ = new int[nUpper_];
+    std::copy(upperBounds.begin(), upperBounds.end(), upperBounds_);
+    std::copy(indexUppers.begin(), indexUppers.end(), indexUppers_);
   }
-  //fin.seekg(0);
-  // fin.seekg( 0, std::ios::beg);
-  nLower_ = 0;
-  nUpper_ = 0;
-  {
-    std::ifstream fin2(fileName_.c_str());
-    //fin.close();
-    //fin.open(fileName_.c_str());
-    while(!fin2.eof()) {
-      int index;
-      double bound;
-      fin2>>in>>index>>bound;
-      if(in==lo) {
-        lowerBounds_[nLower_] = bound;
-        indexLowers_[nLower_++] = index;
+}
+
+void BoundsReader::readRecords(const std::string & fileName, std::vector<Record> & records)
+{
+  MappedFile file;
+  if(!file.open(fileName))
+    throw CoinError("Can not open records file " + fileName, "readRecords", "BoundsReader");
+  const char * current = file.data();
+  const char * end = file.data() + file.size();
+  int nLower, nUpper;
+  const char * data;
+  if(DataFile::isBinary(current, end - current, DataFile::Bounds, nLower, nUpper, data)) {
+    while(current < end) {
+      if(!DataFile::isBinary(current, end - current, DataFile::Bounds, nLower, nUpper, data))
+        throw CoinError("Bad record in records file " + fileName, "readRecords", "BoundsReader");
+      records.push_back(Record());
+      Record & record = records.back();
+      record.indexLowers.resize(nLower);
+      record.lowerBounds.resize(nLower);
+      record.indexUppers.resize(nUpper);
+      record.upperBounds.resize(nUpper);
+      // The data may not be aligned.
+      if(nLower > 0) {
+        memcpy(&record.indexLowers[0], data, nLower * sizeof(int));
+        data += nLower * sizeof(int);
+        memcpy(&record.lowerBounds[0], data, nLower * sizeof(double));
+        data += nLower * sizeof(double);
       }
-      else if(in==up) {
-        upperBounds_[nUpper_] = bound;
-        indexUppers_[nUpper_++] = index;
+      if(nUpper > 0) {
+        memcpy(&record.indexUppers[0], data, nUpper * sizeof(int));
+        data += nUpper * sizeof(int);
+        memcpy(&record.upperBounds[0], data, nUpper * sizeof(double));
+        data += nUpper * sizeof(double);
       }
-      else
-        throw;
-      fin2.ignore(10000,'\n');
+      current = data;
     }
+    return;
+  }
+
+  // Text, an END line ends a record even if it is empty.
+  TextScanner scanner(current, end);
+  while(!scanner.atEnd()) {
+    records.push_back(Record());
+    Record & record = records.back();
+    bool ended;
+    if(!readTextRecord(scanner, record, true, ended))
+      throw CoinError("Bad line in records file " + fileName, "readRecords", "BoundsReader");
+    if(!ended && record.indexLowers.empty() && record.indexUppers.empty())
+      records.pop_back();
   }
 }
 
@@ -11,20 +11,33 @@
 #define BoundsReader_HPP
 
 #include <string>
+#include <vector>
 #include "BonOsiTMINLPInterface.hpp"
 
 
 namespace Bonmin {
 /** Reads a file containing change bounds for variables.
-    Files follows pretty much the Bounds section in MPS standard.*/
+    Files follows pretty much the Bounds section in MPS standard, or are
+    binary data files (see DataFile).*/
 class BONMINLIB_EXPORT BoundsReader
 {
 public:
+  /// Bound changes of one record of a records file.
+  struct Record
+  {
+    std::vector<int> indexLowers;
+    std::vector<double> lowerBounds;
+    std::vector<int> indexUppers;
+    std::vector<double> upperBounds;
+  };
+
   //Default constructor
   BoundsReader():
       fileName_(),
       lowerBounds_(NULL),
       upperBounds_(NULL),
+      indexLowers_(NULL),
+      indexUppers_(NULL),
       nLower_(0),
       nUpper_(0)
   {}
@@ -61,7 +74,49 @@ public:
 
   //Read fileName_ and apply the bounds read to solver
   void readAndApply(OsiTMINLPInterface * solver);
+
+  /** Read the records of fileName and append them to records. A text
+      records file is a bounds file whose records end with a line "END"
+      (the last one may not), a binary one is a sequence of binary bounds
+      data (see DataFile), one per record.*/
+  static void readRecords(const std::string & fileName, std::vector<Record> & records);
+
+  /// Number of changed lower bounds read.
+  int numberLowers() const
+  {
+    return nLower_;
+  }
+  /// Indices of the changed lower bounds read.
+  const int * indexLowers() const
+  {
+    return indexLowers_;
+  }
+  /// Changed lower bounds read.
+  const double * lowerBounds() const
+  {
+    return lowerBounds_;
+  }
+  /// Number of changed upper bounds read.
+  int numberUppers() const
+  {
+    return nUpper_;
+  }
+  /// Indices of the changed upper bounds read.
+  const int * indexUppers() const
+  {
+    return indexUppers_;
+  }
+  /// Changed upper bounds read.
+  const double * upperBounds() const
+  {
+    return upperBounds_;
+  }
 private:
+  /// Copy constructor (not implemented).
+  BoundsReader(const BoundsReader &);
+  /// Assignment operator (not implemented).
+  BoundsReader & operator=(const BoundsReader &);
+
 
   /// Current file
   std::string fileName_;
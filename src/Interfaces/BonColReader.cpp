@@ -7,6 +7,7 @@
 //
 // Date : 26/05/2005
 #include "BonColReader.hpp"
+#include "BonDataFile.hpp"
 #include <fstream>
 #include <iostream>
 
@@ -34,22 +35,21 @@ bool NamesReader::readFile()
   if(hasNlExtension)
     colFileName.erase(size-3,3);
   colFileName+=suffix_;
-  std::ifstream inFile(colFileName.c_str());
-  if(!inFile.is_open()) {
+  MappedFile file;
+  if(!file.open(colFileName)) {
     return false;
   }
+  TextScanner scanner(file.data(), file.data() + file.size());
   std::string name;
-  int nVar = 0;
-  do {
-    name="";
-    inFile>>name;
-    if(name.size()==0)
-      continue;
+  while(scanner.token(name)) {
     names_.push_back(name);
-    indices_[names_[nVar].c_str()] = nVar;
-    nVar++;
   }
-  while(!inFile.eof());
+  // Index once all names are stored (the keys point to them).
+  int nVar = static_cast<int>(names_.size());
+  indices_.clear();
+  for(int i = 0 ; i < nVar ; i++) {
+    indices_[names_[i].c_str()] = i;
+  }
 
   //  names_ = new std::string[nVar];
   for(int i = 0 ; i < nVar ; i++) {
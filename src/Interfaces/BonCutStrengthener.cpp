@@ -5,23 +5,67 @@
 //
 // Author:   Andreas Waechter                 IBM    2007-03-30
 
+#include <atomic>
+#include <map>
+#include <thread>
+
 #include "BonCutStrengthener.hpp"
+#include "BonOptionalLock.hpp"
 #include "IpBlas.hpp"
+#include "CoinTime.hpp"
 
 namespace Bonmin
 {
   using namespace Ipopt;
 
+  struct CutStrengthener::Worker
+  {
+    /** Solver for the TNLPs of this worker */
+    SmartPtr<TNLPSolver> solver;
+    /** TMINLP for which the TNLPs in tnlps were built */
+    TMINLP* tminlp;
+    /** TNLP last used for each constraint (-1 is the objective) */
+    std::map<int, SmartPtr<StrengtheningTNLP> > tnlps;
+    /** Mutex serializing the evaluations of the TMINLP (NULL if the worker
+     *  runs alone) */
+    std::mutex* eval_mutex;
+  };
+
+  /** State of a batch of cuts shared by the workers. */
+  struct CutStrengthener::Round
+  {
+    TMINLP* tminlp;
+    TMINLP2TNLP* problem;
+    std::vector<CutRequest>* requests;
+    int n;
+    const double* x;
+    double infty;
+    /** Wallclock time after which no new cut is started */
+    double deadline;
+    /** Next request to be handled */
+    std::atomic<int> next;
+    /** Local cuts generated for each request */
+    std::vector<OsiCuts> local_cuts;
+    /** Outcome of each request: 0 ok, 1 failed, 2 not started */
+    std::vector<int> status;
+  };
+
   CutStrengthener::CutStrengthener(SmartPtr<TNLPSolver> tnlp_solver,
 				   SmartPtr<OptionsList> options)
     :
-    tnlp_solver_(tnlp_solver)
+    tnlp_solver_(tnlp_solver),
+    workers_()
   {
     options->GetIntegerValue("oa_log_level", oa_log_level_, tnlp_solver->prefix());
     options->GetEnumValue("cut_strengthening_type", cut_strengthening_type_,
 			  tnlp_solver->prefix());
     options->GetEnumValue("disjunctive_cut_type", disjunctive_cut_type_,
 			  tnlp_solver->prefix());
+    int num_threads;
+    options->GetIntegerValue("cut_strengthening_threads", num_threads,
+			     tnlp_solver->prefix());
+    options->GetNumericValue("cut_strengthening_time_limit", round_time_limit_,
+			     tnlp_solver->prefix());
 
     tnlp_solver_->options()->clear();
     if (!tnlp_solver_->Initialize("strength.opt")) {
@@ -29,13 +73,25 @@ namespace Bonmin
     }
     tnlp_solver_->options()->SetStringValue("hessian_approximation","limited-memory");
     tnlp_solver_->options()->SetStringValue("mu_strategy", "adaptive");
+
+    // Solvers of the workers are cloned once and for all.
+    for (int i = 0; i < num_threads; i++) {
+      Worker* w = new Worker;
+      w->solver = (i == 0) ? tnlp_solver_ : tnlp_solver_->cloneForThread();
+      w->tminlp = NULL;
+      w->eval_mutex = NULL;
+      workers_.push_back(w);
+    }
   }
 
   CutStrengthener::~CutStrengthener()
   {
+    for (unsigned int i = 0; i < workers_.size(); i++) {
+      delete workers_[i];
+    }
   }
 
-  bool CutStrengthener::HandleOneCut(bool is_tight, TMINLP* tminlp,
+  bool CutStrengthener::HandleOneCut(Worker& w, bool is_tight, TMINLP* tminlp,
 				     TMINLP2TNLP* problem,
 				     const double* minlp_lb,
 				     const double* minlp_ub,
@@ -52,7 +108,7 @@ namespace Bonmin
     switch (disjunctive_cut_type_) {
     case DC_None:
       if (!is_tight) {
-	retval = StrengthenCut(tminlp, gindex, cut, n, x, minlp_lb, minlp_ub,
+	retval = StrengthenCut(w, tminlp, gindex, cut, n, x, minlp_lb, minlp_ub,
 			       cut_lb, cut_ub);
       }
       break;
@@ -75,7 +131,7 @@ namespace Bonmin
       if (imostfra == -1) {
 	// No disjunction to be done
 	if (!is_tight) {
-	  retval = StrengthenCut(tminlp, gindex, cut, n, x, minlp_lb, minlp_ub,
+	  retval = StrengthenCut(w, tminlp, gindex, cut, n, x, minlp_lb, minlp_ub,
 				 cut_lb, cut_ub);
 	}
       }
@@ -93,14 +149,14 @@ namespace Bonmin
 	changed_bnds[idx] = down_xi;
 	double cut_lb_down = cut_lb;
 	double cut_ub_down = cut_ub;
-	retval = StrengthenCut(tminlp, gindex, cut, n, x, minlp_lb,
+	retval = StrengthenCut(w, tminlp, gindex, cut, n, x, minlp_lb,
 			       changed_bnds, cut_lb_down, cut_ub_down);
 	double cut_lb_up = cut_lb;
 	double cut_ub_up = cut_ub;
 	if (retval) {
 	  CoinCopyN(minlp_lb, n, changed_bnds);
 	  changed_bnds[idx] = down_xi + 1.;
-	  retval = StrengthenCut(tminlp, gindex, cut, n, x, changed_bnds,
+	  retval = StrengthenCut(w, tminlp, gindex, cut, n, x, changed_bnds,
 				 minlp_ub, cut_lb_up, cut_ub_up);
 	}
 	delete [] changed_bnds;
@@ -142,6 +198,108 @@ namespace Bonmin
 				    const double g_ub,
 				    int n, const double* x,
 				    double infty)
+  {
+    Worker& w = *workers_[0];
+    w.eval_mutex = NULL;
+    return ComputeOneCut(w, cs, tminlp, problem, gindex, cut, cut_lb, cut_ub,
+			 g_val, g_lb, g_ub, n, x, infty);
+  }
+
+  bool CutStrengthener::ComputeCuts(OsiCuts &cs,
+				    TMINLP* tminlp,
+				    TMINLP2TNLP* problem,
+				    std::vector<CutRequest>& requests,
+				    int n, const double* x,
+				    double infty,
+				    CoinMessageHandler* handler)
+  {
+    const int num_requests = static_cast<int>(requests.size());
+    if (num_requests == 0) {
+      return true;
+    }
+    const int num_workers = CoinMin(static_cast<int>(workers_.size()),
+				    num_requests);
+
+    Round r;
+    r.tminlp = tminlp;
+    r.problem = problem;
+    r.requests = &requests;
+    r.n = n;
+    r.x = x;
+    r.infty = infty;
+    r.deadline = CoinWallclockTime() + round_time_limit_;
+    r.next = 0;
+    r.local_cuts.resize(num_requests);
+    r.status.assign(num_requests, 2);
+
+    for (int i = 0; i < num_workers; i++) {
+      workers_[i]->eval_mutex = (num_workers > 1) ? &eval_mutex_ : NULL;
+    }
+    std::vector<std::thread> threads;
+    for (int i = 1; i < num_workers; i++) {
+      threads.push_back(std::thread(&CutStrengthener::RunRequests, this,
+				    std::ref(*workers_[i]), std::ref(r)));
+    }
+    RunRequests(*workers_[0], r);
+    for (unsigned int i = 0; i < threads.size(); i++) {
+      threads[i].join();
+    }
+
+    // Add local cuts in the order of the requests so that the result does
+    // not depend on the scheduling.
+    bool retval = true;
+    int num_skipped = 0;
+    for (int k = 0; k < num_requests; k++) {
+      const OsiCuts& local = r.local_cuts[k];
+      for (int j = 0; j < local.sizeRowCuts(); j++) {
+	cs.insert(local.rowCut(j));
+      }
+      if (r.status[k] == 1) {
+	retval = false;
+      }
+      else if (r.status[k] == 2) {
+	num_skipped++;
+      }
+    }
+    if (num_skipped > 0 && oa_log_level_ >= 1 && handler != NULL) {
+      *handler << "Cut strengthening time limit reached," << num_skipped
+	       << "cuts not strengthened" << CoinMessageEol;
+    }
+    return retval;
+  }
+
+  void CutStrengthener::RunRequests(Worker& w, Round& r)
+  {
+    const int num_requests = static_cast<int>(r.requests->size());
+    while (true) {
+      const int k = r.next++;
+      if (k >= num_requests || CoinWallclockTime() > r.deadline) {
+	break;
+      }
+      CutRequest& req = (*r.requests)[k];
+      bool retval;
+      try {
+	retval = ComputeOneCut(w, r.local_cuts[k], r.tminlp, r.problem,
+			       req.gindex, *req.cut, *req.cut_lb, *req.cut_ub,
+			       req.g_val, req.g_lb, req.g_ub, r.n, r.x, r.infty);
+      }
+      catch (...) {
+	// The cut stays valid, it just has not been strengthened.
+	retval = false;
+      }
+      r.status[k] = retval ? 0 : 1;
+    }
+  }
+
+  bool CutStrengthener::ComputeOneCut(Worker& w, OsiCuts &cs,
+				      TMINLP* tminlp,
+				      TMINLP2TNLP* problem,
+				      const int gindex, CoinPackedVector& cut,
+				      double& cut_lb, double& cut_ub,
+				      const double g_val, const double g_lb,
+				      const double g_ub,
+				      int n, const double* x,
+				      double infty)
   {
     //printf("before: lb = %e ub = %e rl = %e ru = %e g = %e\n", lb[i], ub[i], rowLower[bindi], rowUpper[bindi], g[bindi]);
     // First check if the cut is indeed away from the constraint
@@ -162,7 +320,7 @@ namespace Bonmin
 	cut_strengthening_type_ == CS_StrengthenedGlobal_StrengthenedLocal) {
       const double orig_lb = cut_lb;
       const double orig_ub = cut_ub;
-      bool retval = HandleOneCut(is_tight, tminlp, problem,
+      bool retval = HandleOneCut(w, is_tight, tminlp, problem,
 				 problem->orig_x_l(),
 				 problem->orig_x_u(), gindex, cut,
 				 cut_lb, cut_ub, n, x, infty);
@@ -188,7 +346,7 @@ namespace Bonmin
       Number lb2 = cut_lb;
       Number ub2 = cut_ub;
       CoinPackedVector cut2(cut);
-      bool retval = HandleOneCut(is_tight, tminlp, problem, problem->x_l(),
+      bool retval = HandleOneCut(w, is_tight, tminlp, problem, problem->x_l(),
 				 problem->x_u(), gindex, cut2,
 				 lb2, ub2, n, x, infty);
       if (!retval) {
@@ -218,7 +376,8 @@ namespace Bonmin
     return true;
   }
 
-  bool CutStrengthener::StrengthenCut(SmartPtr<TMINLP> tminlp,
+  bool CutStrengthener::StrengthenCut(Worker& w,
+				      TMINLP* tminlp,
 				      int constr_index,
 				      const CoinPackedVector& row,
 				      int n,
@@ -228,45 +387,6 @@ namespace Bonmin
 				      double& lb,
 				      double& ub)
   {
-    // Get data to set up the NLP to be solved
-    Index nele_grad_gi;
-    Index* jCol = new Index[n+1];
-    bool new_x = true;
-    if (constr_index == -1) {
-      // Objective function
-      // Compute random perturbation of point
-      double* x_rand = new double[n];
-      for (int i=0; i<n; i++) {
-	const double radius = CoinMin(1., x_u[i]-x_l[i]);
-	const double p = CoinMax(CoinMin(x[i]-0.5*radius, x_u[i]-radius),
-				 x_l[i]);
-	x_rand[i] = p + radius*CoinDrand48();
-      }
-      Number* grad_f = new Number[n];
-      bool retval = tminlp->eval_grad_f(n, x_rand, new_x, grad_f);
-      delete [] x_rand;
-      if (!retval) {
-	delete [] grad_f;
-	delete [] jCol;
-	return false;
-      }
-      nele_grad_gi = 0;
-      for (int i=0; i<n; i++) {
-	if (grad_f[i] != 0.) {
-	  jCol[nele_grad_gi++] = i;
-	}
-      }
-      delete [] grad_f;
-      jCol[nele_grad_gi++] = n; // for the z variable
-    }
-    else {
-      if (!tminlp->eval_grad_gi(n, x, new_x, constr_index, nele_grad_gi,
-				jCol, NULL)) {
-	delete [] jCol;
-	return false;
-      }
-    }
-
     bool lower_bound;
     if (lb <= -COIN_DBL_MAX) {
       assert(ub < COIN_DBL_MAX);
@@ -276,14 +396,83 @@ namespace Bonmin
       assert(ub >= COIN_DBL_MAX);
       lower_bound = true;
     }
-    SmartPtr<StrengtheningTNLP> stnlp =
-      new StrengtheningTNLP(tminlp, row, lower_bound, n, x, x_l, x_u,
-			    constr_index, nele_grad_gi, jCol);
 
-    delete [] jCol;
+    // TNLPs built for another TMINLP can not be reused (TNLPs hold a
+    // reference to the TMINLP, they are created and destroyed under lock)
+    if (w.tminlp != tminlp) {
+      OptionalLock lock(w.eval_mutex);
+      w.tnlps.clear();
+      w.tminlp = tminlp;
+    }
+    std::map<int, SmartPtr<StrengtheningTNLP> >::iterator cached =
+      w.tnlps.find(constr_index);
+
+    SmartPtr<StrengtheningTNLP> stnlp;
+    if (constr_index >= 0 && cached != w.tnlps.end()) {
+      // The variables of a constraint never change, reuse its TNLP
+      stnlp = cached->second;
+      stnlp->reset(row, lower_bound, x, x_l, x_u);
+    }
+    else {
+      // Get data to set up the NLP to be solved
+      Index nele_grad_gi;
+      Index* jCol = new Index[n+1];
+      bool new_x = true;
+      if (constr_index == -1) {
+	// Objective function
+	OptionalLock lock(w.eval_mutex);
+	// Compute random perturbation of point
+	double* x_rand = new double[n];
+	for (int i=0; i<n; i++) {
+	  const double radius = CoinMin(1., x_u[i]-x_l[i]);
+	  const double p = CoinMax(CoinMin(x[i]-0.5*radius, x_u[i]-radius),
+				   x_l[i]);
+	  x_rand[i] = p + radius*CoinDrand48();
+	}
+	Number* grad_f = new Number[n];
+	bool retval = tminlp->eval_grad_f(n, x_rand, new_x, grad_f);
+	delete [] x_rand;
+	if (!retval) {
+	  delete [] grad_f;
+	  delete [] jCol;
+	  return false;
+	}
+	nele_grad_gi = 0;
+	for (int i=0; i<n; i++) {
+	  if (grad_f[i] != 0.) {
+	    jCol[nele_grad_gi++] = i;
+	  }
+	}
+	delete [] grad_f;
+	jCol[nele_grad_gi++] = n; // for the z variable
+      }
+      else {
+	OptionalLock lock(w.eval_mutex);
+	if (!tminlp->eval_grad_gi(n, x, new_x, constr_index, nele_grad_gi,
+				  jCol, NULL)) {
+	  delete [] jCol;
+	  return false;
+	}
+      }
+
+      if (cached != w.tnlps.end() &&
+	  cached->second->sameVariables(nele_grad_gi, jCol)) {
+	stnlp = cached->second;
+	stnlp->reset(row, lower_bound, x, x_l, x_u);
+      }
+      else {
+	OptionalLock lock(w.eval_mutex);
+	stnlp = new StrengtheningTNLP(tminlp, row, lower_bound, n, x, x_l, x_u,
+				      constr_index, nele_grad_gi, jCol);
+	w.tnlps[constr_index] = stnlp;
+      }
+
+      delete [] jCol;
+    }
+    stnlp->setEvalMutex(w.eval_mutex);
 
     TNLPSolver::ReturnStatus status =
-      tnlp_solver_->OptimizeTNLP(GetRawPtr(stnlp));
+      w.solver->OptimizeTNLP(GetRawPtr(stnlp));
 
     if (status == TNLPSolver::solvedOptimal ||
 	status == TNLPSolver::solvedOptimalTol) {
@@ -321,16 +510,41 @@ namespace Bonmin
     nvar_constr_(nvar_constr),
     lower_bound_(lower_bound),
     have_final_bound_(false),
-    grad_f_(NULL)
+    grad_f_(NULL),
+    eval_mutex_(NULL)
   {
     starting_point_ = new Number[n_orig_];
     x_full_ = new Number[n_orig_];
-    IpBlasDcopy(n_orig_, starting_point, 1, starting_point_, 1);
-    IpBlasDcopy(n_orig_, starting_point, 1, x_full_, 1);
 
     obj_grad_ = new Number[nvar_constr_];
     x_l_ = new Number[nvar_constr_];
     x_u_ = new Number[nvar_constr_];
+
+    var_indices_ = new Index[nvar_constr_];
+    for (int i=0; i<nvar_constr_; i++) {
+      var_indices_[i] = jCol[i];
+    }
+
+    if (constr_index_ == -1) {
+      grad_f_ = new Number[n_orig_];
+    }
+
+    reset(cut, lower_bound, starting_point, x_l_orig, x_u_orig);
+  }
+
+  void CutStrengthener::StrengtheningTNLP::
+  reset(const CoinPackedVector& cut,
+	bool lower_bound,
+	const Number* starting_point,
+	const double* x_l_orig,
+	const double* x_u_orig)
+  {
+    lower_bound_ = lower_bound;
+    have_final_bound_ = false;
+
+    IpBlasDcopy(n_orig_, starting_point, 1, starting_point_, 1);
+    IpBlasDcopy(n_orig_, starting_point, 1, x_full_, 1);
+
     const Number zero = 0.;
     IpBlasDcopy(nvar_constr_, &zero, 0, obj_grad_, 1);
 
@@ -343,7 +557,7 @@ namespace Bonmin
       // ToDo: This could be done more efficiently
       Index jidx = -1;
       for (int j=0; j<nvar_constr_; j++) {
-	if (idx == jCol[j]) {
+	if (idx == var_indices_[j]) {
 	  jidx = j;
 	  break;
 	}
@@ -362,11 +576,9 @@ namespace Bonmin
 
     }
 
-    var_indices_ = new Index[nvar_constr_];
     for (int i=0; i<nvar_constr_; i++) {
-      const Index& j = jCol[i];
-      var_indices_[i] = j;
-      if (j < n) {
+      const Index& j = var_indices_[i];
+      if (j < n_orig_) {
 	x_l_[i] = x_l_orig[j];
 	x_u_[i] = x_u_orig[j];
       }
@@ -375,10 +587,20 @@ namespace Bonmin
 	x_u_[i] = 1e100;
       }
     }
+  }
 
-    if (constr_index_ == -1) {
-      grad_f_ = new Number[n_orig_];
+  bool CutStrengthener::StrengtheningTNLP::
+  sameVariables(Index nvar_constr, const Index* jCol) const
+  {
+    if (nvar_constr != nvar_constr_) {
+      return false;
     }
+    for (Index i=0; i<nvar_constr_; i++) {
+      if (var_indices_[i] != jCol[i]) {
+	return false;
+      }
+    }
+    return true;
   }
 
   CutStrengthener::StrengtheningTNLP::~StrengtheningTNLP()
@@ -406,6 +628,7 @@ namespace Bonmin
     Index nnz_jac_g_orig;
     Index nnz_h_lag_orig;
     TNLP::IndexStyleEnum index_style_orig;
+    OptionalLock lock(eval_mutex_);
     if(!tminlp_->get_nlp_info(n_orig, m_orig_, nnz_jac_g_orig, nnz_h_lag_orig,
 			      index_style_orig)) {
       return false;
@@ -432,6 +655,7 @@ namespace Bonmin
       Number* g_l_orig = new Number[m_orig_];
       Number* g_u_orig = new Number[m_orig_];
 
+      OptionalLock lock(eval_mutex_);
       if (!tminlp_->get_bounds_info(n_orig_, x_l_orig, x_u_orig,
 				  m_orig_, g_l_orig, g_u_orig)) {
 	delete [] x_l_orig;
@@ -504,6 +728,9 @@ namespace Bonmin
   eval_g(Index n, const Number* x, bool new_x, Index m, Number* g)
   {
     update_x_full(x);
+    OptionalLock lock(eval_mutex_);
+    // Other threads evaluate the TMINLP at other points in between.
+    new_x = new_x || eval_mutex_ != NULL;
     bool retval;
     if (constr_index_ == -1) {
       retval = tminlp_->eval_f(n_orig_, x_full_, new_x, g[0]);
@@ -531,6 +758,8 @@ namespace Bonmin
     else {
       DBG_ASSERT(!iRow && values);
       update_x_full(x);
+      OptionalLock lock(eval_mutex_);
+      new_x = new_x || eval_mutex_ != NULL;
       if (constr_index_ == -1) {
 	retval = tminlp_->eval_grad_f(n_orig_, x_full_, new_x, grad_f_);
 	if (retval) {
@@ -8,8 +8,12 @@
 #ifndef __BONCUTSTRENGTHENER_HPP__
 #define __BONCUTSTRENGTHENER_HPP__
 
+#include <mutex>
+#include <vector>
+
 #include "BonTMINLP.hpp"
 #include "CoinPackedVector.hpp"
+#include "CoinMessageHandler.hpp"
 #include "BonTNLPSolver.hpp"
 
 namespace Bonmin
@@ -49,6 +53,24 @@ namespace Bonmin
       /** Destructor */
       ~StrengtheningTNLP();
 
+      /** Set up the TNLP for a new cut on the same variables.  The
+       *  arguments have the same meaning as for the constructor. */
+      void reset(const CoinPackedVector& cut,
+		 bool lower_bound,
+		 const Ipopt::Number* starting_point,
+		 const double* x_l_orig,
+		 const double* x_u_orig);
+
+      /** Does the TNLP have this list of variables? */
+      bool sameVariables(Ipopt::Index nvar_constr, const Ipopt::Index* jCol) const;
+
+      /** Set the mutex serializing the evaluations of the TMINLP (NULL if
+       *  no other thread evaluates it). */
+      void setEvalMutex(std::mutex* eval_mutex)
+      {
+        eval_mutex_ = eval_mutex;
+      }
+
       /**@name Overloaded from TNLP */
       //@{
       /** Method to return some info about the nlp */
@@ -161,6 +183,9 @@ namespace Bonmin
       /** space for original gradient if objective function is handled */
       Ipopt::Number* grad_f_;
 
+      /** Mutex serializing the evaluations of tminlp_ (NULL if none) */
+      std::mutex* eval_mutex_;
+
       /** Auxilliary method for updating the full x variable */
       void update_x_full(const Ipopt::Number *x);
     };
@@ -188,6 +213,38 @@ namespace Bonmin
 		     int n, const double* x,
 		     double infty);
 
+    /** Description of one cut of a batch. */
+    struct CutRequest {
+      /** Index of the constraint the cut was generated from (-1 for the objective) */
+      int gindex;
+      /** Cut to be strengthened (modified in place) */
+      CoinPackedVector* cut;
+      /** Lower bound of the cut (modified in place) */
+      double* cut_lb;
+      /** Upper bound of the cut (modified in place) */
+      double* cut_ub;
+      /** Value of the constraint at x */
+      double g_val;
+      /** Lower bound of the constraint */
+      double g_lb;
+      /** Upper bound of the constraint */
+      double g_ub;
+    };
+
+    /** Method for strengthening the cuts of a whole round.  The cuts are
+     *  handled by cut_strengthening_threads workers, each with its own
+     *  copy of the NLP solver. Cuts which are not started before the time
+     *  budget of the round is exhausted are left as they are (and
+     *  reported to handler if it is not NULL).  Returns false if
+     *  strengthening failed for one of the cuts. */
+    bool ComputeCuts(OsiCuts &cs,
+		     TMINLP* tminlp,
+		     TMINLP2TNLP* problem,
+		     std::vector<CutRequest>& requests,
+		     int n, const double* x,
+		     double infty,
+		     CoinMessageHandler* handler = NULL);
+
   private:
     /**@name Default Compiler Generated Methods
      * (Hidden to avoid implicit creation/calling).
@@ -207,8 +264,30 @@ namespace Bonmin
     void operator=(const CutStrengthener&);
     //@}
 
-    /** Method for strengthening one cut. */
-    bool StrengthenCut(Ipopt::SmartPtr<TMINLP> tminlp /** current TMINLP */,
+    /** Solver and cached TNLPs of one worker. */
+    struct Worker;
+
+    /** Cuts of a batch and their outcome. */
+    struct Round;
+
+    /** Handle requests of round r with worker w until there are none left. */
+    void RunRequests(Worker& w, Round& r);
+
+    /** Method for generating and strenghtening the cuts of one row with
+     *  worker w. */
+    bool ComputeOneCut(Worker& w, OsiCuts &cs,
+		       TMINLP* tminlp,
+		       TMINLP2TNLP* problem,
+		       const int gindex, CoinPackedVector& cut,
+		       double& cut_lb, double& cut_ub,
+		       const double g_val, const double g_lb,
+		       const double g_ub,
+		       int n, const double* x,
+		       double infty);
+
+    /** Method for strengthening one cut with worker w. */
+    bool StrengthenCut(Worker& w,
+		       TMINLP* tminlp /** current TMINLP */,
 		       int constr_index /** Ipopt::Index number of the constraint to be strengthened, -1 means objective function */,
 		       const CoinPackedVector& row /** Cut to be strengthened */,
 		       int n /** Ipopt::Number of variables */,
@@ -219,7 +298,7 @@ namespace Bonmin
 		       double& ub);
 
     /** Method for generating one type of cut (strengthened or disjunctive) */
-    bool HandleOneCut(bool is_tight, TMINLP* tminlp,
+    bool HandleOneCut(Worker& w, bool is_tight, TMINLP* tminlp,
 		      TMINLP2TNLP* problem,
 		      const double* minlp_lb,
 		      const double* minlp_ub,
@@ -231,6 +310,15 @@ namespace Bonmin
     /** Object for solving the TNLPs */
     Ipopt::SmartPtr<TNLPSolver> tnlp_solver_;
 
+    /** Workers (the first one uses tnlp_solver_) */
+    std::vector<Worker*> workers_;
+
+    /** Mutex serializing the TMINLP evaluations when several workers run */
+    std::mutex eval_mutex_;
+
+    /** Time budget (in seconds) for strengthening the cuts of one round */
+    double round_time_limit_;
+
     /** Type of OA cut strengthener */
     int cut_strengthening_type_;
     /** What kind of disjuntion should be done */
@@ -0,0 +1,303 @@
+// (C) Copyright Bonmin contributors 2026
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+//
+// Date : 10/19/2026
+
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "BonDataFile.hpp"
+
+namespace Bonmin
+{
+
+  MappedFile::MappedFile():
+      data_(NULL),
+      size_(0),
+      mapped_(false),
+      buffer_()
+  {}
+
+  MappedFile::~MappedFile()
+  {
+    close();
+  }
+
+  bool
+  MappedFile::open(const std::string & fileName)
+  {
+    close();
+#ifndef _WIN32
+    int fd = ::open(fileName.c_str(), O_RDONLY);
+    if (fd < 0)
+      return false;
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+      void * map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (map != MAP_FAILED) {
+        ::close(fd);
+        data_ = static_cast<const char *>(map);
+        size_ = st.st_size;
+        mapped_ = true;
+        return true;
+      }
+    }
+    ::close(fd);
+#endif
+    // Empty files and systems without mmap: read the file in one block.
+    std::ifstream in(fileName.c_str(), std::ios::in | std::ios::binary);
+    if (!in.is_open())
+      return false;
+    in.seekg(0, std::ios::end);
+    std::streamoff length = in.tellg();
+    in.seekg(0, std::ios::beg);
+    buffer_.resize(length > 0 ? static_cast<size_t>(length) : 0);
+    if (!buffer_.empty())
+      in.read(&buffer_[0], buffer_.size());
+    if (!in)
+      return false;
+    data_ = buffer_.empty() ? NULL : &buffer_[0];
+    size_ = buffer_.size();
+    return true;
+  }
+
+  void
+  MappedFile::close()
+  {
+#ifndef _WIN32
+    if (mapped_)
+      munmap(const_cast<char *>(data_), size_);
+#endif
+    data_ = NULL;
+    size_ = 0;
+    mapped_ = false;
+    buffer_.clear();
+  }
+
+  /** Is c a white space character?*/
+  static inline bool
+  isSpace(char c)
+  {
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\f' || c == '\v';
+  }
+
+  void
+  TextScanner::skipSpaces()
+  {
+    while (current_ < end_ && isSpace(*current_))
+      current_++;
+  }
+
+  bool
+  TextScanner::atEnd()
+  {
+    skipSpaces();
+    return current_ == end_;
+  }
+
+  void
+  TextScanner::skipLine()
+  {
+    while (current_ < end_ && *current_ != '\n')
+      current_++;
+    if (current_ < end_)
+      current_++;
+  }
+
+  bool
+  TextScanner::token(const char * & begin, size_t & length)
+  {
+    skipSpaces();
+    if (current_ == end_)
+      return false;
+    begin = current_;
+    while (current_ < end_ && !isSpace(*current_))
+      current_++;
+    length = current_ - begin;
+    return true;
+  }
+
+  bool
+  TextScanner::token(std::string & value)
+  {
+    const char * begin;
+    size_t length;
+    if (!token(begin, length))
+      return false;
+    value.assign(begin, length);
+    return true;
+  }
+
+  bool
+  TextScanner::number(int & value)
+  {
+    const char * begin;
+    size_t length;
+    if (!token(begin, length))
+      return false;
+    const char * end = begin + length;
+    bool negative = *begin == '-';
+    if (*begin == '-' || *begin == '+')
+      begin++;
+    if (begin == end)
+      return false;
+    // Values outside the range of int are rejected, not truncated.
+    const long long limit = negative ? -static_cast<long long>(INT_MIN) : INT_MAX;
+    long long v = 0;
+    for (; begin < end ; begin++) {
+      if (*begin < '0' || *begin > '9')
+        return false;
+      v = 10 * v + (*begin - '0');
+      if (v > limit)
+        return false;
+    }
+    value = static_cast<int>(negative ? -v : v);
+    return true;
+  }
+
+  bool
+  TextScanner::number(double & value)
+  {
+    const char * begin;
+    size_t length;
+    if (!token(begin, length))
+      return false;
+    // strtod needs a terminated string, copy the token.
+    char buffer[64];
+    std::string longToken;
+    const char * text = buffer;
+    if (length < sizeof(buffer)) {
+      memcpy(buffer, begin, length);
+      buffer[length] = '\0';
+    }
+    else {
+      longToken.assign(begin, length);
+      text = longToken.c_str();
+    }
+    char * end;
+    value = strtod(text, &end);
+    return end == text + length;
+  }
+
+  /** Magic of the binary data files.*/
+  static const char binaryMagic[4] = {'B', 'N', 'M', 'B'};
+
+  /** Size of the header of the binary data files.*/
+  static const size_t headerSize = sizeof(binaryMagic) + 3 * sizeof(int);
+
+  bool
+  DataFile::isBinary(const MappedFile & file, Kind kind,
+      int & count1, int & count2, const char * & data)
+  {
+    return isBinary(file.data(), file.size(), kind, count1, count2, data);
+  }
+
+  bool
+  DataFile::isBinary(const char * begin, size_t size, Kind kind,
+      int & count1, int & count2, const char * & data)
+  {
+    if (size < headerSize || memcmp(begin, binaryMagic, sizeof(binaryMagic)) != 0)
+      return false;
+    int header[3];
+    memcpy(header, begin + sizeof(binaryMagic), sizeof(header));
+    if (header[0] != kind || header[1] < 0 || header[2] < 0)
+      return false;
+    count1 = header[1];
+    count2 = header[2];
+    data = begin + headerSize;
+    size_t needed = 0;
+    if (kind == Bounds)
+      needed = (size_t(count1) + count2) * (sizeof(int) + sizeof(double));
+    else if (kind == StartPoint)
+      needed = (size_t(count1) + count2) * sizeof(double);
+    else
+      needed = size_t(count1) * sizeof(double);
+    return size >= headerSize + needed;
+  }
+
+  /** Write the header of a binary data file.*/
+  static void
+  writeHeader(FILE * f, DataFile::Kind kind, int count1, int count2)
+  {
+    int header[3] = {kind, count1, count2};
+    fwrite(binaryMagic, 1, sizeof(binaryMagic), f);
+    fwrite(header, sizeof(int), 3, f);
+  }
+
+  bool
+  DataFile::writeBounds(const std::string & fileName, bool binary,
+      int nLower, const int * indexLowers, const double * lowerBounds,
+      int nUpper, const int * indexUppers, const double * upperBounds)
+  {
+    FILE * f = fopen(fileName.c_str(), binary ? "wb" : "w");
+    if (f == NULL)
+      return false;
+    if (binary) {
+      writeHeader(f, Bounds, nLower, nUpper);
+      fwrite(indexLowers, sizeof(int), nLower, f);
+      fwrite(lowerBounds, sizeof(double), nLower, f);
+      fwrite(indexUppers, sizeof(int), nUpper, f);
+      fwrite(upperBounds, sizeof(double), nUpper, f);
+    }
+    else {
+      for (int i = 0 ; i < nLower ; i++)
+        fprintf(f, "LO %d %.17g\n", indexLowers[i], lowerBounds[i]);
+      for (int i = 0 ; i < nUpper ; i++)
+        fprintf(f, "UP %d %.17g\n", indexUppers[i], upperBounds[i]);
+    }
+    return fclose(f) == 0;
+  }
+
+  bool
+  DataFile::writeStartPoint(const std::string & fileName, bool binary,
+      int numPrimals, const double * primals, int numDuals, const double * duals)
+  {
+    FILE * f = fopen(fileName.c_str(), binary ? "wb" : "w");
+    if (f == NULL)
+      return false;
+    if (binary) {
+      writeHeader(f, StartPoint, numPrimals, numDuals);
+      fwrite(primals, sizeof(double), numPrimals, f);
+      fwrite(duals, sizeof(double), numDuals, f);
+    }
+    else {
+      fprintf(f, "%d %d\n", numPrimals, numDuals);
+      for (int i = 0 ; i < numPrimals ; i++)
+        fprintf(f, "%.17g\n", primals[i]);
+      for (int i = 0 ; i < numDuals ; i++)
+        fprintf(f, "%.17g\n", duals[i]);
+    }
+    return fclose(f) == 0;
+  }
+
+  bool
+  DataFile::writeSolution(const std::string & fileName, bool binary,
+      int n, const double * x)
+  {
+    FILE * f = fopen(fileName.c_str(), binary ? "wb" : "w");
+    if (f == NULL)
+      return false;
+    if (binary) {
+      writeHeader(f, Solution, n, 0);
+      fwrite(x, sizeof(double), n, f);
+    }
+    else {
+      // Header of an AMPL .sol file without duals.
+      fprintf(f, "bonmin: converted\n\nOptions\n3\n1\n1\n0\n0\n0\n%d\n%d\n", n, n);
+      for (int i = 0 ; i < n ; i++)
+        fprintf(f, "%.17g\n", x[i]);
+    }
+    return fclose(f) == 0;
+  }
+}
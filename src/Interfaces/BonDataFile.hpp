@@ -0,0 +1,153 @@
+// (C) Copyright Bonmin contributors 2026
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+//
+// Date : 10/19/2026
+
+#ifndef BonDataFile_H
+#define BonDataFile_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "BonminConfig.h"
+
+namespace Bonmin
+{
+  /** Read only view of the content of a file, memory mapped when the
+      system allows it (read in one block otherwise).*/
+  class BONMINLIB_EXPORT MappedFile
+  {
+  public:
+    /** Constructor.*/
+    MappedFile();
+
+    /** Destructor, unmaps the file.*/
+    ~MappedFile();
+
+    /** Map fileName, returns false if it can not be read.*/
+    bool open(const std::string & fileName);
+
+    /** Unmap the file.*/
+    void close();
+
+    /** Content of the file.*/
+    const char * data() const
+    {
+      return data_;
+    }
+
+    /** Size of the file in bytes.*/
+    size_t size() const
+    {
+      return size_;
+    }
+
+  private:
+    /** Copy constructor (not implemented).*/
+    MappedFile(const MappedFile &);
+    /** Assignment operator (not implemented).*/
+    MappedFile & operator=(const MappedFile &);
+
+    /** Content of the file.*/
+    const char * data_;
+    /** Size of the file.*/
+    size_t size_;
+    /** Is data_ a mapping (or points to buffer_)?*/
+    bool mapped_;
+    /** Content of the file when it is not mapped.*/
+    std::vector<char> buffer_;
+  };
+
+  /** Reads white space separated tokens and numbers from a buffer in one
+      pass, without streams nor copies of the buffer. Integers are parsed
+      in place; a floating point number is converted with strtod from a
+      copy of its token only.*/
+  class BONMINLIB_EXPORT TextScanner
+  {
+  public:
+    /** Constructor on the characters from begin to end (excluded).*/
+    TextScanner(const char * begin, const char * end):
+        current_(begin),
+        end_(end)
+    {}
+
+    /** Next token, returns false at the end of the buffer.*/
+    bool token(const char * & begin, size_t & length);
+
+    /** Next token as a string, returns false at the end of the buffer.*/
+    bool token(std::string & value);
+
+    /** Next token as an integer, returns false if there is none, it is
+        not an integer or it is out of the range of int.*/
+    bool number(int & value);
+
+    /** Next token as a double, returns false if there is none or it is
+        not a number.*/
+    bool number(double & value);
+
+    /** Skip to the beginning of the next line.*/
+    void skipLine();
+
+    /** Is there no token left?*/
+    bool atEnd();
+
+  private:
+    /** Skip white space.*/
+    void skipSpaces();
+
+    /** Current position.*/
+    const char * current_;
+    /** End of the buffer.*/
+    const char * end_;
+  };
+
+  /** Binary data files.
+      A binary data file starts with the 4 characters "BNMB" followed by
+      three 32 bits integers: the kind of data and two counts, then the
+      data in the native byte order:
+      - bounds: counts are the number of changed lower and upper bounds,
+        followed by the indices (ints) and values (doubles) of the lower
+        bounds then the ones of the upper bounds (as BoundsReader),
+      - starting point: counts are the number of primal and dual values,
+        followed by the values (doubles) (as StartPointReader),
+      - solution: first count is the number of columns, followed by the
+        values (doubles) (as SolReader).*/
+  class BONMINLIB_EXPORT DataFile
+  {
+  public:
+    /** Kinds of data.*/
+    enum Kind {
+      Bounds = 1/** Bound changes.*/,
+      StartPoint = 2/** Primal and dual starting point.*/,
+      Solution = 3/** Primal solution.*/};
+
+    /** Is file a binary data file of kind? If so give the counts of its
+        header and the position of its data.*/
+    static bool isBinary(const MappedFile & file, Kind kind,
+        int & count1, int & count2, const char * & data);
+
+    /** Same as above for the size bytes from begin (data files can be
+        stored one after the other).*/
+    static bool isBinary(const char * begin, size_t size, Kind kind,
+        int & count1, int & count2, const char * & data);
+
+    /** Write bound changes to fileName (in the text format of BoundsReader
+        if !binary), returns false on error.*/
+    static bool writeBounds(const std::string & fileName, bool binary,
+        int nLower, const int * indexLowers, const double * lowerBounds,
+        int nUpper, const int * indexUppers, const double * upperBounds);
+
+    /** Write a starting point to fileName (in the text format of
+        StartPointReader if !binary), returns false on error.*/
+    static bool writeStartPoint(const std::string & fileName, bool binary,
+        int numPrimals, const double * primals, int numDuals, const double * duals);
+
+    /** Write a primal solution to fileName (as a .sol file SolReader reads
+        if !binary), returns false on error.*/
+    static bool writeSolution(const std::string & fileName, bool binary,
+        int n, const double * x);
+  };
+}
+#endif
@@ -0,0 +1,42 @@
+// (C) Copyright Bonmin contributors 2026
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+//
+// Date : 10/19/2026
+
+#ifndef BonOptionalLock_H
+#define BonOptionalLock_H
+
+#include <mutex>
+
+namespace Bonmin
+{
+  /** Lock a mutex for the lifetime of the object if there is one (a NULL
+      mutex means that the caller is the only thread using the resource).*/
+  class OptionalLock
+  {
+  public:
+    /** Constructor, locks m if it is not NULL.*/
+    OptionalLock(std::mutex * m):
+        m_(m)
+    {
+      if (m_) m_->lock();
+    }
+
+    /** Destructor, unlocks the mutex.*/
+    ~OptionalLock()
+    {
+      if (m_) m_->unlock();
+    }
+
+  private:
+    /** Copy constructor (not implemented).*/
+    OptionalLock(const OptionalLock &);
+    /** Assignment operator (not implemented).*/
+    OptionalLock & operator=(const OptionalLock &);
+
+    /** Mutex locked (NULL if none).*/
+    std::mutex * m_;
+  };
+}
+#endif
@@ -36,6 +36,7 @@
 #include "OsiBranchingObject.hpp"
 #include "OsiRowCutDebugger.hpp"
 #include "BonStrongBranchingSolver.hpp"
+#include "BonProfiler.hpp"
 
 //Macros to try and make messages definition less heavy
 #include "BonMsgUtils.hpp"
@@ -43,7 +44,8 @@
 using namespace Ipopt;
 
 
-extern bool BonminAbortAll;
+#include <atomic>
+extern std::atomic<bool> BonminAbortAll;
 namespace Bonmin {
 ///Register options
 static void
@@ -71,6 +73,23 @@ register_general_options
       "This will affect the function getWarmStart(), and as a consequence the warm starting in the various algorithms.");
   roptions->setOptionExtraInfo("warm_start",8);
 
+  roptions->AddLowerBoundedIntegerOption("num_ampl_evaluators",
+      "Number of independent copies of an AMPL model used to evaluate single constraints and their gradients.",
+      0,0,
+      "Each copy can be used by one thread at a time so that several threads can evaluate the model concurrently. "
+      "If 0, evaluations go through the AMPL model used by the NLP solver.");
+  roptions->setOptionExtraInfo("num_ampl_evaluators",127);
+
+  roptions->AddStringOption2("ampl_compiled_evaluator",
+      "Evaluate AMPL models with a compiled version of their expressions.",
+      "no",
+      "no", "Evaluate through the AMPL solver library",
+      "yes", "Compile the expressions of the model once and evaluate the compiled form",
+      "Functions, gradients, Jacobian and Hessian of the Lagrangian are computed from a flat representation "
+      "of the expressions built when the model is read. "
+      "If the model uses operators which can not be compiled, evaluations go through the AMPL solver library.");
+  roptions->setOptionExtraInfo("ampl_compiled_evaluator",127);
+
   roptions->SetRegisteringCategory("Output and Loglevel", RegisteredOptions::BonminCategory);
   
   roptions->AddBoundedIntegerOption("nlp_log_level",
@@ -218,6 +237,18 @@ static void register_OA_options
                              "");
   roptions->setOptionExtraInfo("cut_strengthening_type",119);
 
+  roptions->AddLowerBoundedIntegerOption("cut_strengthening_threads",
+      "Number of threads used to strengthen the cuts of one round of outer approximation.",
+      1, 1,
+      "Each thread has its own copy of the NLP solver and strengthens its share of the cuts.");
+  roptions->setOptionExtraInfo("cut_strengthening_threads",119);
+
+  roptions->AddLowerBoundedNumberOption("cut_strengthening_time_limit",
+      "Time budget (wallclock seconds) for strengthening the cuts of one round of outer approximation.",
+      0., 0, 1e10,
+      "Cuts which are not started when the budget is exhausted are added unstrengthened.");
+  roptions->setOptionExtraInfo("cut_strengthening_time_limit",119);
+
   roptions->SetRegisteringCategory("Outer Approximation cuts generation", RegisteredOptions::BonminCategory);
 
   roptions->AddStringOption2("oa_cuts_scope","Specify if OA cuts added are to be set globally or locally valid",
@@ -360,7 +391,7 @@ OsiTMINLPInterface::OaMessages::OaMessages(): CoinMessages((int) OA_MESSAGES_DUM
 
    ADD_MSG(OA_CUT_GENERATED, std_m, 1,"Row %d: Outer approximation cut not generated.");
 }
-bool OsiTMINLPInterface::hasPrintedOptions=0;
+std::atomic<bool> OsiTMINLPInterface::hasPrintedOptions(false);
 
 ////////////////////////////////////////////////////////////////////
 // Constructors and desctructors                                  //
@@ -512,6 +543,47 @@ OsiTMINLPInterface::setModel(SmartPtr<TMINLP> tminlp)
   }
 }
 
+void
+OsiTMINLPInterface::resetModel(SmartPtr<TMINLP> tminlp)
+{
+  assert(IsValid(app_));
+  freeCachedData();
+  delete [] jRow_;
+  delete [] jCol_;
+  delete [] jValues_;
+  jRow_ = jCol_ = NULL;
+  jValues_ = NULL;
+  nnz_jac = 0;
+  delete [] constTypes_;
+  constTypes_ = NULL;
+  nNonLinear_ = 0;
+  delete [] obj_;
+  obj_ = NULL;
+  delete warmstart_;
+  warmstart_ = NULL;
+  deleteObjects();
+  strong_branching_solver_ = NULL;
+
+  nCallOptimizeTNLP_ = 0;
+  totalNlpSolveTime_ = 0;
+  totalIterations_ = 0;
+  hasBeenOptimized_ = false;
+  hasContinuedAfterNlpFailure_ = false;
+  firstSolve_ = true;
+  OsiDualObjectiveLimit_ = 1e200;
+
+  app_->forgetPreviousSolve();
+  for(std::list<Ipopt::SmartPtr<TNLPSolver> >::iterator i = debug_apps_.begin() ;
+      i != debug_apps_.end() ; i++){
+    (*i)->forgetPreviousSolve();
+  }
+  setModel(tminlp);
+  if(IsValid(linearizer_))
+    linearizer_->set_model(GetRawPtr(problem_));
+  // Options may have changed since the previous model.
+  extractInterfaceParams();
+}
+
 
 
 void
@@ -628,11 +700,28 @@ OsiTMINLPInterface::OsiTMINLPInterface (const OsiTMINLPInterface &source):
 OsiSolverInterface * 
 OsiTMINLPInterface::clone(bool copyData ) const
 {
+  ProfileTimer timer(Profiler::SolverClone);
   if(copyData)
     return new OsiTMINLPInterface(*this);
   else return new OsiTMINLPInterface;
 }
 
+OsiTMINLPInterface *
+OsiTMINLPInterface::cloneForThread(std::mutex * eval_mutex) const
+{
+  OsiTMINLPInterface * copy = dynamic_cast<OsiTMINLPInterface *>(clone());
+  assert(copy != NULL);
+  if(IsValid(tminlp_)) {
+    copy->app_ = app_->cloneForThread();
+    copy->debug_apps_.clear();
+    copy->testOthers_ = false;
+    copy->problem_->SetWarmStarter(NULL);
+    copy->problem_->setEvalMutex(eval_mutex);
+  }
+  copy->strong_branching_solver_ = NULL;
+  return copy;
+}
+
 /// Assignment operator
 OsiTMINLPInterface & OsiTMINLPInterface::operator=(const OsiTMINLPInterface& rhs)
 {
@@ -1695,7 +1784,6 @@ OsiTMINLPInterface::getDblParam(OsiDblParam key, double& value) const
     retval = false;
     break;
   case OsiPrimalTolerance:
-    options()->GetNumericValue("tol", value,"");
     value = 1e-07;
     retval = true;
     break;
@@ -1837,31 +1925,42 @@ int OsiTMINLPInterface::initializeJacobianArrays()
 
 double 
 OsiTMINLPInterface::getConstraintsViolation(const double *x, double &obj)
+{
+  double norm;
+  getConstraintsViolations(1, x, &obj, &norm);
+  return norm;
+}
+
+bool
+OsiTMINLPInterface::getConstraintsViolations(int npoints, const double *x,
+    double *obj, double *violation)
 {
   int numcols = getNumCols();
   int numrows = getNumRows();
-  double * g = new double[numrows];
-  tminlp_->eval_g(numcols, x, 1, numrows, g);
+  double * g = new double[numrows * npoints];
+  bool ok = tminlp_->eval_f_and_g_batch(numcols, npoints, x, obj, numrows, g);
   const double * rowLower = getRowLower();
   const double * rowUpper = getRowUpper();
 
+  for(int k = 0 ; k < npoints ; k++) {
+    const double * gk = g + k * numrows;
+    double norm = 0;
+    for(int i = 0; i< numrows ; i++) {
+      if(!constTypes_ || constTypes_[i] == TNLP::NON_LINEAR) {
+        double rowViolation = 0;
+        if(rowLower[i] > -1e10)
+           rowViolation = std::max(0.,rowLower[i] - gk[i]);
 
-  double norm = 0;
-  for(int i = 0; i< numrows ; i++) {
-    if(!constTypes_ || constTypes_[i] == TNLP::NON_LINEAR) {
-      double rowViolation = 0;
-      if(rowLower[i] > -1e10)
-         rowViolation = std::max(0.,rowLower[i] - g[i]);
-
-      if(rowUpper[i] < 1e10)
-        rowViolation = std::max(rowViolation, g[i] - rowUpper[i]);
+        if(rowUpper[i] < 1e10)
+          rowViolation = std::max(rowViolation, gk[i] - rowUpper[i]);
 
-      norm = rowViolation > norm ? rowViolation : norm;
+        norm = rowViolation > norm ? rowViolation : norm;
+      }
     }
+    violation[k] = ok ? norm : COIN_DBL_MAX;
   }
-  tminlp_->eval_f(numcols, x, 1, obj);
   delete [] g;
-  return norm;
+  return ok;
 }
 
 /** get infinity norm of constraint violation of a point and objective error*/
@@ -2008,6 +2107,8 @@ OsiTMINLPInterface::getOuterApproximation(OsiCuts &cs, const double * x,
     }
   }
 
+  vector<int> selected;
+  selected.reserve(numCuts);
   for(int cutIdx = 0; cutIdx < numCuts; cutIdx++) {
     //Compute cut violation
     if(x2 != NULL) {
@@ -2021,22 +2122,39 @@ OsiTMINLPInterface::getOuterApproximation(OsiCuts &cs, const double * x,
       if(oaHandler_->logLevel() > 0)
           oaHandler_->message(VIOLATED_OA_CUT_GENERATED, oaMessages_)<<cut2rowIdx[cutIdx]<<violation<<CoinMessageEol;
     }
-  OsiRowCut newCut;
+    selected.push_back(cutIdx);
+  }
+
+  if (IsValid(cutStrengthener_)) {
+    // Strengthen all the cuts of the round in one batch.
+    std::vector<CutStrengthener::CutRequest> requests(selected.size());
+    for(unsigned int k = 0 ; k < selected.size() ; k++) {
+      const int & cutIdx = selected[k];
+      const int & rowIdx = cut2rowIdx[cutIdx];
+      CutStrengthener::CutRequest & req = requests[k];
+      req.gindex = rowIdx;
+      req.cut = &cuts[cutIdx];
+      req.cut_lb = &lb[cutIdx];
+      req.cut_ub = &ub[cutIdx];
+      req.g_val = g[rowIdx];
+      req.g_lb = rowLower[rowIdx];
+      req.g_ub = rowUpper[rowIdx];
+    }
+    bool retval =
+      cutStrengthener_->ComputeCuts(cs, GetRawPtr(tminlp_),
+				     GetRawPtr(problem_), requests,
+				     n, x, infty, oaHandler_);
+    if (!retval) {
+      (*messageHandler()) << "error in cutStrengthener_->ComputeCuts\n";
+      //exit(-2);
+    }
+  }
+
+  for(unsigned int k = 0 ; k < selected.size() ; k++) {
+    const int & cutIdx = selected[k];
+    OsiRowCut newCut;
     //    if(lb[i]>-1e20) assert (ub[i]>1e20);
 
-    if (IsValid(cutStrengthener_)) {
-      const int& rowIdx = cut2rowIdx[cutIdx];
-      bool retval =
-	cutStrengthener_->ComputeCuts(cs, GetRawPtr(tminlp_),
-				       GetRawPtr(problem_), rowIdx,
-				       cuts[cutIdx], lb[cutIdx], ub[cutIdx], g[rowIdx],
-				       rowLower[rowIdx], rowUpper[rowIdx],
-				       n, x, infty);
-      if (!retval) {
-	(*messageHandler()) << "error in cutStrengthener_->ComputeCuts\n";
-	//exit(-2);
-      }
-    }
     if(global) {
       newCut.setGloballyValidAsInteger(1);
     }
@@ -2211,9 +2329,14 @@ OsiTMINLPInterface::getConstraintOuterApproximation(OsiCuts &cs, int rowIdx,
   double g;
   int * indices = new int[getNumCols()];
   double * values = new double[getNumCols()];
-  int nnz;
-  problem_->eval_grad_gi(getNumCols(), x, 1, rowIdx, nnz, indices, values);
-  problem_->eval_gi(getNumCols(),x,1, rowIdx, g);
+  int start[2];
+  problem_->eval_gi_and_grad_gi(getNumCols(), x, 1, 1, &rowIdx, &g,
+                                start, indices, values);
+  int nnz = start[1];
+  if(problem_->index_style() == Ipopt::TNLP::FORTRAN_STYLE){
+    for(int i = 0 ; i < nnz ; i++)
+      indices[i]--;
+  }
 
   CoinPackedVector cut;
   double lb;
@@ -2327,6 +2450,7 @@ OsiTMINLPInterface::solveFeasibilityProblem(size_t n,const double * x_bar,const
   feasibilityProblem_->set_use_cutoff_constraint(false);
   feasibilityProblem_->set_use_local_branching_constraint(false);  
   nCallOptimizeTNLP_++;
+  ProfileTimer timer(Profiler::FeasibilityNlpSolve);
   totalNlpSolveTime_-=CoinCpuTime();
   SmartPtr<TNLPSolver> app2 = app_->clone();
   app2->options()->SetIntegerValue("print_level", (Index) 0);
@@ -2352,6 +2476,7 @@ OsiTMINLPInterface::solveFeasibilityProblem(size_t n,const double * x_bar,const
   feasibilityProblem_->set_cutoff(cutoff);
   feasibilityProblem_->set_use_local_branching_constraint(false);  
   nCallOptimizeTNLP_++;
+  ProfileTimer timer(Profiler::FeasibilityNlpSolve);
   totalNlpSolveTime_-=CoinCpuTime();
   SmartPtr<TNLPSolver> app2 = app_->clone();
   app2->options()->SetIntegerValue("print_level", (Index) 0);
@@ -2372,7 +2497,7 @@ OsiTMINLPInterface::getFeasibilityOuterApproximation(int n,const double * x_bar,
 }
 #endif
 
-static bool WarnedForNonConvexOa=false;
+static std::atomic<bool> WarnedForNonConvexOa(false);
 
 void
 OsiTMINLPInterface::extractLinearRelaxation(OsiSolverInterface &si, 
@@ -2426,9 +2551,8 @@ OsiTMINLPInterface::extractLinearRelaxation(OsiSolverInterface &si,
       else
         if(rowLower[i] > - infty_){
           rowLow[i] = (rowLower[i] - g[i]) - 1e-07;
-          if(! WarnedForNonConvexOa && rowUpper[i] < infty_){
+          if(rowUpper[i] < infty_ && ! WarnedForNonConvexOa.exchange(true)){
              messageHandler()->message(WARNING_NON_CONVEX_OA, messages_)<<CoinMessageEol;
-             WarnedForNonConvexOa = true;
           }
         }
       else
@@ -2609,6 +2733,7 @@ OsiTMINLPInterface::solveAndCheckErrors(bool warmStarted, bool throwOnFailure,
     const char * whereFrom)
 {
   if (BonminAbortAll == true) return;
+  ProfileTimer timer(Profiler::NlpSolve);
   totalNlpSolveTime_-=CoinCpuTime();
   if(warmStarted)
     optimizationStatus_ = app_->ReOptimizeTNLP(GetRawPtr(problem_to_optimize_));
@@ -2629,8 +2754,7 @@ OsiTMINLPInterface::solveAndCheckErrors(bool warmStarted, bool throwOnFailure,
    }
 
   //Options should have been printed if not done already turn off Ipopt output
-  if(!hasPrintedOptions) {
-    hasPrintedOptions = 1;
+  if(!hasPrintedOptions.exchange(true)) {
     //app_->Options()->SetIntegerValue("print_level",0, true, true);
     app_->options()->SetStringValue("print_user_options","no", false, true);
   }
@@ -2797,8 +2921,7 @@ void OsiTMINLPInterface::initialSolve(const char * whereFrom)
   solveAndCheckErrors(0,1,"initialSolve");
   
   //Options should have been printed if not done already turn off Ipopt output
-  if(!hasPrintedOptions) {
-    hasPrintedOptions = 1;
+  if(!hasPrintedOptions.exchange(true)) {
     app_->options()->SetStringValue("print_user_options","no");
     app_->options()->SetIntegerValue("print_level",0);
   }
@@ -15,6 +15,7 @@
 
 #define INT_BIAS 0e-8
 
+#include <atomic>
 #include <string>
 #include <iostream>
 
@@ -154,6 +155,12 @@ class Messages : public CoinMessages
 
   /** Set the model to be solved by interface.*/
   void setModel(Ipopt::SmartPtr<TMINLP> tminlp);
+  /** Replace the model solved by an initialized interface with tminlp,
+      keeping the NLP solver, its options and its journalist. Everything
+      the interface knows of the previous model (cached rows, jacobian,
+      warm start, branching objects, strong branching solver, counters) is
+      dropped.*/
+  void resetModel(Ipopt::SmartPtr<TMINLP> tminlp);
   /** Set the solver to be used by interface.*/
   void setSolver(Ipopt::SmartPtr<TNLPSolver> app);
   /** Sets the TMINLP2TNLP to be used by the interface.*/
@@ -165,6 +172,13 @@ class Messages : public CoinMessages
   /** Virtual copy constructor */
   OsiSolverInterface * clone(bool copyData = true) const;
 
+  /** Copy for solving NLPs in another thread than this interface (e.g. to
+      strong branch in parallel). The copy has its own NLP solver (see
+      TNLPSolver::cloneForThread), does not use the strong branching solver
+      nor the interior point warm starter, and its evaluations of the TMINLP
+      are serialized with eval_mutex.*/
+  OsiTMINLPInterface * cloneForThread(std::mutex * eval_mutex) const;
+
   /// Assignment operator
   OsiTMINLPInterface & operator=(const OsiTMINLPInterface& rhs);
 
@@ -1046,6 +1060,14 @@ void getBendersCut(OsiCuts &cs, bool global);
      obj the objective value of x.*/
  double getConstraintsViolation(const double * x, double & obj);
 
+  /** Get infinity norms of constraint violation of npoints points with
+      one evaluation of the problem (see TMINLP::eval_f_and_g_batch).
+      Point k is in positions k*n to k*n+n-1 of x, its objective value is
+      put in obj[k] and its violation in violation[k]. Returns false (and
+      violations of COIN_DBL_MAX) if the evaluation failed.*/
+  bool getConstraintsViolations(int npoints, const double * x, double * obj,
+      double * violation);
+
   /** Get infinity norm of constraint violation for x and error in objective
       value where obj is the estimated objective value of x.*/
   double getNonLinearitiesViolation(const double *x, const double obj);
@@ -1247,8 +1269,9 @@ protected:
       pseudo costs initialization.  AW: I changed this, it will now be
       the objective gradient at current point. */
   mutable double * obj_;
-  /** flag to say wether options have been printed or not.*/
-  static bool hasPrintedOptions;
+  /** flag to say wether options have been printed or not (by any
+      interface of the process).*/
+  static std::atomic<bool> hasPrintedOptions;
 
   /** Adapter for TNLP to a feasibility problem */
   Ipopt::SmartPtr<TNLP2FPNLP> feasibilityProblem_;
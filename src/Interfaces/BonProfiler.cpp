@@ -0,0 +1,103 @@
+// (C) Copyright Bonmin contributors 2026
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+//
+// Date : 10/19/2026
+
+#include <cstdio>
+#include <ostream>
+
+#include "BonProfiler.hpp"
+
+namespace Bonmin
+{
+
+  thread_local bool Profiler::enabled_ = false;
+  thread_local long long Profiler::counts_[Profiler::NumSections];
+  thread_local long long Profiler::nanoseconds_[Profiler::NumSections];
+
+  /** Names of the sections, in the order of Profiler::Section.*/
+  static const char * sectionNames[Profiler::NumSections] = {
+    "nlp_solve",
+    "feasibility_nlp_solve",
+    "strong_branching",
+    "oa_generation",
+    "heuristic",
+    "sub_mip",
+    "solver_clone",
+    "eval_f",
+    "eval_grad_f",
+    "eval_g",
+    "eval_jac_g",
+    "eval_h",
+    "eval_gi"};
+
+  void
+  Profiler::setEnabled(bool value)
+  {
+    enabled_ = value;
+  }
+
+  void
+  Profiler::reset()
+  {
+    for (int i = 0 ; i < NumSections ; i++) {
+      counts_[i] = 0;
+      nanoseconds_[i] = 0;
+    }
+  }
+
+  long long
+  Profiler::count(Section section)
+  {
+    return counts_[section];
+  }
+
+  double
+  Profiler::seconds(Section section)
+  {
+    return 1e-09 * nanoseconds_[section];
+  }
+
+  const char *
+  Profiler::name(Section section)
+  {
+    return sectionNames[section];
+  }
+
+  void
+  Profiler::report(std::ostream & os, Format format, double elapsed)
+  {
+    char buffer[256];
+    if (format == Json) {
+      snprintf(buffer, sizeof(buffer), "{\"elapsed\": %.6f, \"sections\": {", elapsed);
+      os << buffer;
+      for (int i = 0 ; i < NumSections ; i++) {
+        Section s = static_cast<Section>(i);
+        snprintf(buffer, sizeof(buffer), "%s\"%s\": {\"calls\": %lld, \"seconds\": %.6f}",
+            i ? ", " : "", name(s), count(s), seconds(s));
+        os << buffer;
+      }
+      os << "}}" << std::endl;
+      return;
+    }
+    snprintf(buffer, sizeof(buffer), "Bonmin profile after %.2f seconds (times are inclusive)\n",
+        elapsed);
+    os << buffer;
+    snprintf(buffer, sizeof(buffer), "%-24s %12s %12s %12s %8s\n",
+        "section", "calls", "seconds", "avg (ms)", "% time");
+    os << buffer;
+    for (int i = 0 ; i < NumSections ; i++) {
+      Section s = static_cast<Section>(i);
+      long long calls = count(s);
+      if (calls == 0)
+        continue;
+      double time = seconds(s);
+      snprintf(buffer, sizeof(buffer), "%-24s %12lld %12.3f %12.4f %8.2f\n",
+          name(s), calls, time, 1e3 * time / calls,
+          elapsed > 0. ? 100. * time / elapsed : 0.);
+      os << buffer;
+    }
+    os.flush();
+  }
+}
@@ -0,0 +1,128 @@
+// (C) Copyright Bonmin contributors 2026
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+//
+// Date : 10/19/2026
+
+#ifndef BonProfiler_H
+#define BonProfiler_H
+
+#include <chrono>
+#include <iosfwd>
+#include "BonminConfig.h"
+
+namespace Bonmin
+{
+  /** Counters and timers of the hot paths of Bonmin (NLP solves, outer
+   *  approximation, strong branching, heuristics, sub-MILPs, cloning of the
+   *  solver and evaluations of the functions of the TMINLP).
+   *  Each section counts its calls and accumulates their wallclock time.
+   *  Times are inclusive: the time of a heuristic contains the time of the
+   *  NLPs it solves.
+   *  Profiling is off by default; then a ProfileTimer only tests a flag.
+   *  The flag and the counters are per thread, so that searches running on
+   *  different threads (BatchSolver) are profiled separately. Work done on
+   *  helper threads of a search (cut strengthening) is not counted.
+   */
+  class BONMINLIB_EXPORT Profiler
+  {
+  public:
+    /** Instrumented sections.*/
+    enum Section {
+      NlpSolve = 0/** Solves of the NLP relaxation (OsiTMINLPInterface).*/,
+      FeasibilityNlpSolve/** Solves of feasibility NLPs (feasibility pump, OA).*/,
+      StrongBranching/** Strong branching (BonChooseVariable).*/,
+      OaGeneration/** Outer approximation decomposition (OACutGenerator2).*/,
+      Heuristic/** Primal heuristics.*/,
+      SubMip/** Solves of sub-MILPs (SubMipSolver).*/,
+      SolverClone/** Copies of OsiTMINLPInterface.*/,
+      EvalF/** Evaluations of the objective.*/,
+      EvalGradF/** Evaluations of the gradient of the objective.*/,
+      EvalG/** Evaluations of the constraints.*/,
+      EvalJacG/** Evaluations of the jacobian.*/,
+      EvalH/** Evaluations of the hessian of the lagrangian.*/,
+      EvalGi/** Evaluations of single constraints and their gradients.*/,
+      NumSections};
+
+    /** Formats of the report.*/
+    enum Format {
+      Text = 0/** Table for a human.*/,
+      Json/** One JSON object on one line.*/};
+
+    /** Is profiling on?*/
+    static bool enabled()
+    {
+      return enabled_;
+    }
+
+    /** Turn profiling on or off on this thread.*/
+    static void setEnabled(bool value);
+
+    /** Zero all the counters of this thread.*/
+    static void reset();
+
+    /** Record one call of section which took nanoseconds.*/
+    static void add(Section section, long long nanoseconds)
+    {
+      counts_[section]++;
+      nanoseconds_[section] += nanoseconds;
+    }
+
+    /** Number of calls of section.*/
+    static long long count(Section section);
+
+    /** Wallclock seconds spent in section.*/
+    static double seconds(Section section);
+
+    /** Name of section in the reports.*/
+    static const char * name(Section section);
+
+    /** Write the counters to os, elapsed is the wallclock time of the run.*/
+    static void report(std::ostream & os, Format format, double elapsed);
+
+  private:
+    /** Is profiling on?*/
+    static thread_local bool enabled_;
+    /** Number of calls of each section.*/
+    static thread_local long long counts_[NumSections];
+    /** Nanoseconds spent in each section.*/
+    static thread_local long long nanoseconds_[NumSections];
+  };
+
+  /** Times the scope in which it lives and records it in a section of the
+      Profiler (does nothing if profiling is off when it is created).*/
+  class ProfileTimer
+  {
+  public:
+    /** Constructor, starts timing.*/
+    ProfileTimer(Profiler::Section section):
+        section_(section),
+        active_(Profiler::enabled())
+    {
+      if (active_)
+        start_ = std::chrono::steady_clock::now();
+    }
+
+    /** Destructor, records the time in the Profiler.*/
+    ~ProfileTimer()
+    {
+      if (active_)
+        Profiler::add(section_, std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start_).count());
+    }
+
+  private:
+    /** Copy constructor (not implemented).*/
+    ProfileTimer(const ProfileTimer &);
+    /** Assignment operator (not implemented).*/
+    ProfileTimer & operator=(const ProfileTimer &);
+
+    /** Section timed.*/
+    Profiler::Section section_;
+    /** Was profiling on at creation?*/
+    bool active_;
+    /** Start time.*/
+    std::chrono::steady_clock::time_point start_;
+  };
+}
+#endif
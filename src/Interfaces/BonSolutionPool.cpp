@@ -0,0 +1,92 @@
+// (C) Copyright Bonmin contributors 2026
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+//
+// Date : 10/19/2026
+
+#include "BonSolutionPool.hpp"
+#include <algorithm>
+
+namespace Bonmin
+{
+  /** Constructor.*/
+  SolutionPool::SolutionPool(int capacity):
+      Coin::ReferencedObject(),
+      capacity_(capacity),
+      mutex_()
+  {}
+
+  /** Destructor.*/
+  SolutionPool::~SolutionPool()
+  {}
+
+  int
+  SolutionPool::capacity() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return capacity_;
+  }
+
+  void
+  SolutionPool::setCapacity(int capacity)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    capacity_ = capacity;
+    for (int k = 0 ; k < NumKinds ; k++) {
+      if (static_cast<int>(points_[k].size()) > capacity_)
+        points_[k].resize(capacity_);
+    }
+  }
+
+  bool
+  SolutionPool::add(const double * x, int n, double obj, Kind kind)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<Point> & points = points_[kind];
+    int size = static_cast<int>(points.size());
+    if (capacity_ <= 0 || (size >= capacity_ && obj >= points.back().obj))
+      return false;
+    int pos = size;
+    for (int i = 0 ; i < size ; i++) {
+      if (static_cast<int>(points[i].x.size()) == n &&
+          std::equal(x, x + n, points[i].x.begin()))
+        return false;
+      if (pos == size && obj < points[i].obj)
+        pos = i;
+    }
+    Point p;
+    p.obj = obj;
+    p.x.assign(x, x + n);
+    points.insert(points.begin() + pos, p);
+    if (static_cast<int>(points.size()) > capacity_)
+      points.pop_back();
+    return true;
+  }
+
+  int
+  SolutionPool::size(Kind kind) const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return static_cast<int>(points_[kind].size());
+  }
+
+  bool
+  SolutionPool::get(int i, Kind kind, std::vector<double> & x, double & obj) const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const std::vector<Point> & points = points_[kind];
+    if (i < 0 || i >= static_cast<int>(points.size()))
+      return false;
+    x = points[i].x;
+    obj = points[i].obj;
+    return true;
+  }
+
+  void
+  SolutionPool::clear()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (int k = 0 ; k < NumKinds ; k++)
+      points_[k].clear();
+  }
+}/* end namespace Bonmin*/
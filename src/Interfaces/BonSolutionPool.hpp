@@ -0,0 +1,83 @@
+// (C) Copyright Bonmin contributors 2026
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+//
+// Date : 10/19/2026
+
+#ifndef BonSolutionPool_H
+#define BonSolutionPool_H
+
+#include <mutex>
+#include <vector>
+#include "CoinSmartPtr.hpp"
+#include "BonminConfig.h"
+
+namespace Bonmin
+{
+  /** Bounded pool of the best distinct solutions found during a
+   *  branch-and-bound. Two kinds of points are kept, each in its own list
+   *  sorted by objective value: points feasible for the MINLP and
+   *  integer feasible points of the MILP master problems of OA. Each list
+   *  keeps at most capacity() points, the worst one being dropped when a
+   *  better one comes in.
+   *  All methods can be called concurrently from several threads.
+   */
+  class BONMINLIB_EXPORT SolutionPool : public Coin::ReferencedObject
+  {
+  public:
+    /** Kinds of points.*/
+    enum Kind {
+      MinlpFeasible = 0/** Feasible for the MINLP.*/,
+      MilpFeasible/** Integer feasible for a MILP master (outer approximation).*/,
+      NumKinds};
+
+    /** Constructor.*/
+    SolutionPool(int capacity = 5);
+
+    /** Destructor.*/
+    ~SolutionPool();
+
+    /** Maximum number of points of each kind.*/
+    int capacity() const;
+
+    /** Set maximum number of points of each kind.*/
+    void setCapacity(int capacity);
+
+    /** Add point x of size n with objective value obj. Returns true if the
+        point was kept (it is not already in the pool and is among the
+        capacity() best).*/
+    bool add(const double * x, int n, double obj, Kind kind);
+
+    /** Number of points of a kind.*/
+    int size(Kind kind) const;
+
+    /** Copy i-th best point of a kind in x and its objective value in obj.
+        Returns false if there are less than i+1 points of that kind.*/
+    bool get(int i, Kind kind, std::vector<double> & x, double & obj) const;
+
+    /** Remove all points.*/
+    void clear();
+
+  private:
+    /** A point of the pool.*/
+    struct Point
+    {
+      double obj;
+      std::vector<double> x;
+    };
+
+    /** Copy constructor (not implemented).*/
+    SolutionPool(const SolutionPool &);
+    /** Assignment operator (not implemented).*/
+    SolutionPool & operator=(const SolutionPool &);
+
+    /** Maximum number of points of each kind.*/
+    int capacity_;
+    /** Points of each kind, best first.*/
+    std::vector<Point> points_[NumKinds];
+    /** Protects everything above.*/
+    mutable std::mutex mutex_;
+  };
+}/* End namespace.*/
+
+#endif
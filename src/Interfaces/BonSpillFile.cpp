@@ -0,0 +1,103 @@
+// (C) Copyright Bonmin contributors 2026
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+//
+// Date : 10/19/2026
+
+#include <cstdio>
+
+#include "BonSpillFile.hpp"
+
+namespace Bonmin
+{
+
+  SpillFile::SpillFile(const std::string & fileName):
+      fileName_(fileName),
+      file_(),
+      end_(0),
+      bytesStored_(0),
+      freeBlocks_()
+  {}
+
+  SpillFile::~SpillFile()
+  {
+    if (file_.is_open()) {
+      file_.close();
+      std::remove(fileName_.c_str());
+    }
+  }
+
+  bool
+  SpillFile::open()
+  {
+    if (file_.is_open())
+      return true;
+    file_.open(fileName_.c_str(), std::ios::in | std::ios::out |
+        std::ios::binary | std::ios::trunc);
+    end_ = 0;
+    return file_.is_open();
+  }
+
+  long long
+  SpillFile::write(const void * data, size_t size)
+  {
+    if (size == 0 || !open())
+      return -1;
+    long long position = end_;
+    std::multimap<size_t, long long>::iterator block = freeBlocks_.lower_bound(size);
+    if (block != freeBlocks_.end()) {
+      position = block->second;
+      size_t left = block->first - size;
+      freeBlocks_.erase(block);
+      if (left > 0)
+        freeBlocks_.insert(std::make_pair(left, position + static_cast<long long>(size)));
+    }
+    file_.clear();
+    file_.seekp(position);
+    file_.write(static_cast<const char *>(data), size);
+    if (!file_) {
+      file_.clear();
+      if (position != end_)
+        freeBlocks_.insert(std::make_pair(size, position));
+      return -1;
+    }
+    if (position == end_)
+      end_ += static_cast<long long>(size);
+    bytesStored_ += size;
+    return position;
+  }
+
+  bool
+  SpillFile::read(long long position, void * data, size_t size)
+  {
+    if (!file_.is_open() || position < 0 ||
+        position + static_cast<long long>(size) > end_)
+      return false;
+    file_.clear();
+    file_.seekg(position);
+    file_.read(static_cast<char *>(data), size);
+    if (!file_) {
+      file_.clear();
+      return false;
+    }
+    return true;
+  }
+
+  void
+  SpillFile::release(long long position, size_t size)
+  {
+    if (position < 0 || size == 0)
+      return;
+    bytesStored_ -= size;
+    if (bytesStored_ == 0) {
+      // Everything is free, start again from the beginning of the file.
+      freeBlocks_.clear();
+      end_ = 0;
+      return;
+    }
+    if (position + static_cast<long long>(size) == end_)
+      end_ = position;
+    else
+      freeBlocks_.insert(std::make_pair(size, position));
+  }
+}
@@ -0,0 +1,80 @@
+// (C) Copyright Bonmin contributors 2026
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+//
+// Date : 10/19/2026
+
+#ifndef BonSpillFile_H
+#define BonSpillFile_H
+
+#include <cstddef>
+#include <fstream>
+#include <map>
+#include <string>
+#include "BonminConfig.h"
+
+namespace Bonmin
+{
+  /** File to which blocks of data are moved out of memory and from which
+      they are read back later (used to bound the memory taken by the open
+      nodes of a branch-and-bound).
+      A block is identified by its position in the file. The space of
+      released blocks is reused for blocks written later (best fit), so that
+      the size of the file follows the amount of data it holds. The file is
+      created at the first write and removed by the destructor.
+  */
+  class BONMINLIB_EXPORT SpillFile
+  {
+  public:
+    /** Constructor (the file is not created yet).*/
+    SpillFile(const std::string & fileName);
+
+    /** Destructor, removes the file.*/
+    ~SpillFile();
+
+    /** Write size bytes of data in the file. Returns the position of the
+        block, or -1 if the file can not be written.*/
+    long long write(const void * data, size_t size);
+
+    /** Read the block of size bytes written at position in data. Returns
+        false on error.*/
+    bool read(long long position, void * data, size_t size);
+
+    /** Declare that the block of size bytes at position is no longer
+        used.*/
+    void release(long long position, size_t size);
+
+    /** Number of bytes in the blocks in use.*/
+    size_t bytesStored() const
+    {
+      return bytesStored_;
+    }
+
+    /** Name of the file.*/
+    const std::string & fileName() const
+    {
+      return fileName_;
+    }
+
+  private:
+    /** Copy constructor (not implemented).*/
+    SpillFile(const SpillFile &);
+    /** Assignment operator (not implemented).*/
+    SpillFile & operator=(const SpillFile &);
+
+    /** Open the file if it is not. Returns false on error.*/
+    bool open();
+
+    /** Name of the file.*/
+    std::string fileName_;
+    /** The file.*/
+    std::fstream file_;
+    /** Size of the file.*/
+    long long end_;
+    /** Number of bytes in the blocks in use.*/
+    size_t bytesStored_;
+    /** Free parts of the file (size, position).*/
+    std::multimap<size_t, long long> freeBlocks_;
+  };
+}
+#endif
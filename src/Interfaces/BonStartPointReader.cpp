@@ -7,29 +7,52 @@
 //
 // Date : 26/05/2005
 #include "BonStartPointReader.hpp"
+#include "BonDataFile.hpp"
+
+#include <cstring>
 
 
 namespace Bonmin {
 
   bool StartPointReader::readFile()
   {
-    std::ifstream inFile(fileName_.c_str());
-    if(!inFile.is_open()) {
+    MappedFile file;
+    if(!file.open(fileName_)) {
       std::cerr<<"Error in opening initial point file";
       return false;
     }
+    gutsOfDestructor();
     int numPrimals;
     int numDuals;
-    inFile>>numPrimals>>numDuals;
-    gutsOfDestructor();
-    primals_ = new double [numPrimals];
-    duals_ = new double[numDuals];
-    for(int i = 0; i < numPrimals ; i++) {
-      inFile>>primals_[i];
+    const char * data;
+    if(DataFile::isBinary(file, DataFile::StartPoint, numPrimals, numDuals, data)) {
+      primals_ = new double [numPrimals];
+      duals_ = new double[numDuals];
+      memcpy(primals_, data, numPrimals * sizeof(double));
+      memcpy(duals_, data + numPrimals * sizeof(double), numDuals * sizeof(double));
     }
-    for(int i = 0; i < numDuals ; i++) {
-      inFile>>duals_[i];
+    else {
+      TextScanner scanner(file.data(), file.data() + file.size());
+      if(!scanner.number(numPrimals) || !scanner.number(numDuals) ||
+          numPrimals < 0 || numDuals < 0) {
+        std::cerr<<"Error in reading initial point file";
+        return false;
+      }
+      primals_ = new double [numPrimals];
+      duals_ = new double[numDuals];
+      bool ok = true;
+      for(int i = 0; ok && i < numPrimals ; i++)
+        ok = scanner.number(primals_[i]);
+      for(int i = 0; ok && i < numDuals ; i++)
+        ok = scanner.number(duals_[i]);
+      if(!ok) {
+        gutsOfDestructor();
+        std::cerr<<"Error in reading initial point file";
+        return false;
+      }
     }
+    numPrimals_ = numPrimals;
+    numDuals_ = numDuals;
     return true;
   }
 
@@ -19,7 +19,8 @@
 
 namespace Bonmin {
 /** This class reads a file with a starting point for Ipopt initalization. File format is number of primals number of duals then values one after another
- * Numbering of variables is first variables, then duals on lower bounds duals on upper bounds and to finish duals on constraints */
+ * Numbering of variables is first variables, then duals on lower bounds duals on upper bounds and to finish duals on constraints
+ * (files can also be binary data files, see DataFile) */
 class BONMINLIB_EXPORT StartPointReader
 {
 public:
@@ -27,13 +28,17 @@ public:
   StartPointReader(std::string fileName = ""):
       fileName_(fileName),
       primals_(NULL),
-      duals_(NULL)
+      duals_(NULL),
+      numPrimals_(0),
+      numDuals_(0)
   {}
   /** Constructor with fileName_ given by a const char * */
   StartPointReader(const char * fileName):
       fileName_(fileName),
       primals_(NULL),
-      duals_(NULL)
+      duals_(NULL),
+      numPrimals_(0),
+      numDuals_(0)
   {}
 
   /** Reads the .initP file*/
@@ -59,6 +64,10 @@ public:
       delete[] primals_;
     if(duals_!=NULL)
       delete[] duals_;
+    primals_ = NULL;
+    duals_ = NULL;
+    numPrimals_ = 0;
+    numDuals_ = 0;
   }
 
   /// Access primal variables values.
@@ -71,7 +80,22 @@ public:
   {
     return duals_;
   }
+  /// Number of primal variables values read.
+  int numberPrimals() const
+  {
+    return numPrimals_;
+  }
+  /// Number of dual variables values read.
+  int numberDuals() const
+  {
+    return numDuals_;
+  }
 private:
+  /// Copy constructor (not implemented).
+  StartPointReader(const StartPointReader &);
+  /// Assignment operator (not implemented).
+  StartPointReader & operator=(const StartPointReader &);
+
   /** Name of the file with initial point */
   std::string fileName_;
 
@@ -79,6 +103,10 @@ private:
   double * primals_;
   /// Dual variables values.
   double * duals_;
+  /// Number of primal variables values.
+  int numPrimals_;
+  /// Number of dual variables values.
+  int numDuals_;
 };
 
 }
@@ -72,6 +72,8 @@ struct BonminProblemInfo
     Eval_Grad_F_CB eval_grad_f;
     Eval_Jac_G_CB eval_jac_g;
     Eval_H_CB eval_h;
+    Eval_F_G_Jac_CB eval_f_g_jac;
+    Eval_Batch_CB eval_batch;
     VariableTypeC* var_types;
     LinearityTypeC* var_linearity_types;
     LinearityTypeC* constraint_linearity_types;
@@ -82,8 +84,68 @@ struct BonminProblemInfo
     Number obj_scaling;
     Number* x_scaling;
     Number* g_scaling;
+    /** Structures of the Jacobian and of the Hessian (NULL if not given) */
+    Index* jac_iRow;
+    Index* jac_jCol;
+    Index* h_iRow;
+    Index* h_jCol;
+    /** Are the arrays of the problem borrowed from the caller? */
+    Bool borrowed;
 };
 
+/** Check the arguments common to CreateBonminProblem and
+ *  CreateBonminProblemNoCopy.*/
+static bool
+checkBonminProblem(Index n, Number* x_L, Number* x_U, Index m,
+                   Number* g_L, Number* g_U, Index nele_jac, Index nele_hess,
+                   Eval_F_CB eval_f, Eval_G_CB eval_g, Eval_Grad_F_CB eval_grad_f,
+                   Eval_Jac_G_CB eval_jac_g, VariableTypeC* var_types,
+                   LinearityTypeC* var_linearity_types,
+                   LinearityTypeC* constraint_linearity_types)
+{
+    return !( n<1 || m<0 || !x_L || !x_U || (m>0 && (!g_L || !g_U)) ||
+            (m==0 && nele_jac != 0) || (m>0 && nele_jac < 1) || nele_hess < 0 ||
+            !eval_f || !eval_grad_f || (m>0 && (!eval_g || !eval_jac_g)) ||
+            !var_types || !var_linearity_types || (m>0 && !constraint_linearity_types) );
+}
+
+/** Set the members of a new problem which do not depend on the way its
+ *  arrays are stored.*/
+static void
+initBonminProblem(BonminProblem problem, Index n, Index m, Index nele_jac,
+                  Index nele_hess, Index index_style, Eval_F_CB eval_f,
+                  Eval_G_CB eval_g, Eval_Grad_F_CB eval_grad_f,
+                  Eval_Jac_G_CB eval_jac_g, Eval_H_CB eval_h,
+                  BonminSosInfo* sos_info, BonminBranchingInfo* branch_info)
+{
+    problem->n = n;
+    problem->m = m;
+    problem->nele_jac = nele_jac;
+    problem->nele_hess = nele_hess;
+    problem->index_style = index_style;
+    problem->eval_f = eval_f;
+    problem->eval_g = eval_g;
+    problem->eval_grad_f = eval_grad_f;
+    problem->eval_jac_g = eval_jac_g;
+    problem->eval_h = eval_h;
+    problem->eval_f_g_jac = NULL;
+    problem->eval_batch = NULL;
+    problem->sos_info = sos_info;
+    problem->branch_info = branch_info;
+    problem->intermediate_cb = NULL;
+
+    problem->obj_scaling = 1;
+    problem->x_scaling = NULL;
+    problem->g_scaling = NULL;
+    problem->jac_iRow = NULL;
+    problem->jac_jCol = NULL;
+    problem->h_iRow = NULL;
+    problem->h_jCol = NULL;
+    problem->borrowed = FALSE;
+
+    problem->bonmin_setup.initializeOptionsAndJournalist();
+}
+
 BonminProblem CreateBonminProblem(
                 Index n
                 , Number* x_L
@@ -105,16 +167,17 @@ BonminProblem CreateBonminProblem(
                 , BonminSosInfo* sos_info
                 , BonminBranchingInfo* branch_info )
 {
-    if ( n<1 || m<0 || !x_L || !x_U || (m>0 && (!g_L || !g_U)) ||
-            (m==0 && nele_jac != 0) || (m>0 && nele_jac < 1) || nele_hess < 0 ||
-            !eval_f || !eval_grad_f || (m>0 && (!eval_g || !eval_jac_g)) ||
-            !var_types || !var_linearity_types || (m>0 && !constraint_linearity_types) )
+    if ( !checkBonminProblem(n, x_L, x_U, m, g_L, g_U, nele_jac, nele_hess,
+                             eval_f, eval_g, eval_grad_f, eval_jac_g, var_types,
+                             var_linearity_types, constraint_linearity_types) )
     {
         return NULL;
     }
     BonminProblem retval = new BonminProblemInfo;
+    initBonminProblem(retval, n, m, nele_jac, nele_hess, index_style, eval_f,
+                      eval_g, eval_grad_f, eval_jac_g, eval_h, sos_info,
+                      branch_info);
 
-    retval->n = n;
     retval->x_L = new Number[n];
 
     for (Index i=0; i<n; i++)
@@ -127,7 +190,6 @@ BonminProblem CreateBonminProblem(
         retval->x_U[i] = x_U[i];
     }
 
-    retval->m = m;
     if (m>0)
     {
         retval->g_L = new Number[m];
@@ -160,25 +222,80 @@ BonminProblem CreateBonminProblem(
         retval->constraint_linearity_types[i] = constraint_linearity_types[i];
     }
 
-    retval->nele_jac = nele_jac;
-    retval->nele_hess = nele_hess;
-    retval->index_style = index_style;
-    retval->eval_f = eval_f;
-    retval->eval_g = eval_g;
-    retval->eval_grad_f = eval_grad_f;
-    retval->eval_jac_g = eval_jac_g;
-    retval->eval_h = eval_h;
-    retval->intermediate_cb = NULL;
-
-    retval->obj_scaling = 1;
-    retval->x_scaling = NULL;
-    retval->g_scaling = NULL;
+    return retval;
+}
 
-    retval->bonmin_setup.initializeOptionsAndJournalist();
+BonminProblem CreateBonminProblemNoCopy(
+                Index n
+                , Number* x_L
+                , Number* x_U
+                , Index m
+                , Number* g_L
+                , Number* g_U
+                , Index nele_jac
+                , Index nele_hess
+                , Index index_style
+                , Eval_F_CB eval_f
+                , Eval_G_CB eval_g
+                , Eval_Grad_F_CB eval_grad_f
+                , Eval_Jac_G_CB eval_jac_g
+                , Eval_H_CB eval_h
+                , VariableTypeC* var_types
+                , LinearityTypeC* var_linearity_types
+                , LinearityTypeC* constraint_linearity_types
+                , Index* jac_iRow
+                , Index* jac_jCol
+                , Index* h_iRow
+                , Index* h_jCol
+                , BonminSosInfo* sos_info
+                , BonminBranchingInfo* branch_info )
+{
+    if ( !checkBonminProblem(n, x_L, x_U, m, g_L, g_U, nele_jac, nele_hess,
+                             eval_f, eval_g, eval_grad_f, eval_jac_g, var_types,
+                             var_linearity_types, constraint_linearity_types) )
+    {
+        return NULL;
+    }
+    BonminProblem retval = new BonminProblemInfo;
+    initBonminProblem(retval, n, m, nele_jac, nele_hess, index_style, eval_f,
+                      eval_g, eval_grad_f, eval_jac_g, eval_h, sos_info,
+                      branch_info);
+
+    retval->x_L = x_L;
+    retval->x_U = x_U;
+    retval->g_L = (m>0) ? g_L : NULL;
+    retval->g_U = (m>0) ? g_U : NULL;
+    retval->var_types = var_types;
+    retval->var_linearity_types = var_linearity_types;
+    retval->constraint_linearity_types = constraint_linearity_types;
+    if (jac_iRow && jac_jCol)
+    {
+        retval->jac_iRow = jac_iRow;
+        retval->jac_jCol = jac_jCol;
+    }
+    if (h_iRow && h_jCol)
+    {
+        retval->h_iRow = h_iRow;
+        retval->h_jCol = h_jCol;
+    }
+    retval->borrowed = TRUE;
 
     return retval;
 }
 
+Bool SetBonminCombinedCallbacks(BonminProblem bonmin_problem,
+              Eval_F_G_Jac_CB eval_f_g_jac,
+              Eval_Batch_CB eval_batch)
+{
+    if (bonmin_problem == NULL)
+    {
+        return (Bool)false;
+    }
+    bonmin_problem->eval_f_g_jac = eval_f_g_jac;
+    bonmin_problem->eval_batch = eval_batch;
+    return (Bool)true;
+}
+
 void FreeBonminProblem(BonminProblem bonmin_problem)
 {
     if (bonmin_problem == NULL)
@@ -186,15 +303,18 @@ void FreeBonminProblem(BonminProblem bonmin_problem)
         return;
     }
 
-    delete [] bonmin_problem->x_L;
-    delete [] bonmin_problem->x_U;
-    delete [] bonmin_problem->var_types;
-    delete [] bonmin_problem->var_linearity_types;
-    if (bonmin_problem->m>0)
+    if (!bonmin_problem->borrowed)
     {
+        delete [] bonmin_problem->x_L;
+        delete [] bonmin_problem->x_U;
+        delete [] bonmin_problem->var_types;
+        delete [] bonmin_problem->var_linearity_types;
         delete [] bonmin_problem->constraint_linearity_types;
-        delete [] bonmin_problem->g_L;
-        delete [] bonmin_problem->g_U;
+        if (bonmin_problem->m>0)
+        {
+            delete [] bonmin_problem->g_L;
+            delete [] bonmin_problem->g_U;
+        }
     }
 
     if(bonmin_problem->x_scaling != NULL)
@@ -360,24 +480,23 @@ Int BonminSolve(
     }
 
 
-    // convert from C type enum to C++ enum
-    TMINLP::VariableType* variable_types = new TMINLP::VariableType[bonmin_problem->n];
-    TNLP::LinearityType* variable_linearity_types = new TNLP::LinearityType[bonmin_problem->n];
-    for (Index i=0; i<bonmin_problem->n; i++)
-    {
-        variable_types[i] = static_cast<TMINLP::VariableType>( (int)bonmin_problem->var_types[i] ); // yikes
-        variable_linearity_types[i] = static_cast<TNLP::LinearityType>( (int)bonmin_problem->var_linearity_types[i] ); // yikes
-    }
-
-    TNLP::LinearityType* constraint_linearity_types = NULL;
-    if( bonmin_problem->m > 0 )
-    {
-        constraint_linearity_types = new TNLP::LinearityType[bonmin_problem->m];
-        for (Index i=0; i<bonmin_problem->m; i++)
-        {
-            constraint_linearity_types[i] = static_cast<TNLP::LinearityType>( (int)bonmin_problem->constraint_linearity_types[i] ); // yikes
-        }
-    }
+    // The arrays of the problem are used as they are (StdInterfaceTMINLP
+    // only reads them with memcpy), the C enums have to match the C++ ones.
+    static_assert(sizeof(VariableTypeC) == sizeof(TMINLP::VariableType) &&
+                  (int)CONTINUOUS == (int)TMINLP::CONTINUOUS &&
+                  (int)BINARY == (int)TMINLP::BINARY &&
+                  (int)INTEGER == (int)TMINLP::INTEGER,
+                  "VariableTypeC does not match TMINLP::VariableType");
+    static_assert(sizeof(LinearityTypeC) == sizeof(TNLP::LinearityType) &&
+                  (int)LINEAR == (int)TNLP::LINEAR &&
+                  (int)NON_LINEAR == (int)TNLP::NON_LINEAR,
+                  "LinearityTypeC does not match TNLP::LinearityType");
+    TMINLP::VariableType* variable_types =
+        reinterpret_cast<TMINLP::VariableType*>(bonmin_problem->var_types);
+    TNLP::LinearityType* variable_linearity_types =
+        reinterpret_cast<TNLP::LinearityType*>(bonmin_problem->var_linearity_types);
+    TNLP::LinearityType* constraint_linearity_types =
+        reinterpret_cast<TNLP::LinearityType*>(bonmin_problem->constraint_linearity_types);
 
 
     SmartPtr<TMINLP> tminlp;
@@ -404,6 +523,10 @@ Int BonminSolve(
                                         bonmin_problem->obj_scaling,
                                         bonmin_problem->x_scaling,
                                         bonmin_problem->g_scaling);
+        interfaceTMINLP->setStructure(bonmin_problem->jac_iRow, bonmin_problem->jac_jCol,
+                                      bonmin_problem->h_iRow, bonmin_problem->h_jCol);
+        interfaceTMINLP->setCombinedCallbacks(bonmin_problem->eval_f_g_jac,
+                                              bonmin_problem->eval_batch);
 
         if( bonmin_problem->sos_info != NULL )
         {
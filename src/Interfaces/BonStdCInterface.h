@@ -114,6 +114,33 @@ typedef Bool (*Eval_H_CB)(Index n, Number *x, Bool new_x, Number obj_factor,
                       Index nnz_h_lag, Index *iRow, Index *jCol,
                       Number *values, UserDataPtr user_data);
 
+/** Type defining the optional callback function for evaluating
+ *  together the value of the objective function, the values of the
+ *  constraint functions and the values of the Jacobian of the
+ *  constraints (in the order of the structure returned by the
+ *  Eval_Jac_G_CB callback) at one point.  When it is given, it replaces
+ *  the separate evaluations of f, g and of the Jacobian values, which
+ *  then cost one call instead of three.  Return value should be set to
+ *  false if there was a problem doing the evaluation.
+ */
+typedef Bool (*Eval_F_G_Jac_CB)(Index n, Number* x, Bool new_x,
+                           Number* obj_value, Index m, Number* g,
+                           Index nele_jac, Number* jac_values,
+                           UserDataPtr user_data);
+
+/** Type defining the optional callback function for evaluating the
+ *  objective function and the constraint functions at a batch of
+ *  points.  Point k is in positions k*n to k*n+n-1 of x, its objective
+ *  value goes to obj_values[k] and its constraint values to positions
+ *  k*m to k*m+m-1 of g (g is NULL when only the objective values are
+ *  needed).  It should not change what the single point callbacks
+ *  rely on through new_x.  Return value should be set to false if
+ *  there was a problem doing the evaluation.
+ */
+typedef Bool (*Eval_Batch_CB)(Index n, Index num_points, Number* x,
+                         Number* obj_values, Index m, Number* g,
+                         UserDataPtr user_data);
+
 /** Type defining the callback function for giving intermediate
  *  execution control to the user.  If set, it is called once per
  *  iteration, providing the user with some information on the state
@@ -152,6 +179,51 @@ BonminProblem CreateBonminProblem(
           , struct BonminBranchingInfo* branching_info );
 
 
+/** Variant of CreateBonminProblem which does not copy the arrays it is
+ *  given: x_L, x_U, g_L, g_U, var_types, var_linearity_types and
+ *  constraint_linearity_types are borrowed, as are the optional
+ *  structures of the Jacobian (jac_iRow, jac_jCol, nele_jac entries
+ *  each) and of the Hessian (h_iRow, h_jCol, nele_hess entries each).
+ *  All these arrays must stay valid and unchanged until
+ *  FreeBonminProblem is called; FreeBonminProblem does not free them.
+ *  When a structure is not given (NULL pointers) it is asked once to the
+ *  eval_jac_g or eval_h callback and cached.
+ */
+BonminProblem CreateBonminProblemNoCopy(
+          Index n
+          , Number* x_L
+          , Number* x_U
+          , Index m
+          , Number* g_L
+          , Number* g_U
+          , Index nnz_jac_g
+          , Index nnz_h_lag
+          , Index index_style
+          , Eval_F_CB eval_f
+          , Eval_G_CB eval_g
+          , Eval_Grad_F_CB eval_grad_f
+          , Eval_Jac_G_CB eval_jac_g
+          , Eval_H_CB eval_h
+          , VariableTypeC* var_types
+          , LinearityTypeC* var_linearity_types
+          , LinearityTypeC* constraint_linearity_types
+          , Index* jac_iRow
+          , Index* jac_jCol
+          , Index* h_iRow
+          , Index* h_jCol
+          , struct BonminSosInfo* sos_info
+          , struct BonminBranchingInfo* branching_info );
+
+/** Function for giving the optional combined callbacks, to be called
+ *  before BonminSolve.  Either may be NULL, the single point callbacks
+ *  given to CreateBonminProblem are then used instead (they are still
+ *  needed for the structures of the Jacobian and of the Hessian, for
+ *  the gradient of the objective and for the Hessian values).
+ */
+Bool SetBonminCombinedCallbacks(BonminProblem bonmin_problem,
+                          Eval_F_G_Jac_CB eval_f_g_jac,
+                          Eval_Batch_CB eval_batch);
+
 /** Method for freeing a previously created BonminProblem.
  * After freeing an BonminProblem, it cannot be used anymore.
  */
@@ -62,6 +62,8 @@ namespace Bonmin
                     eval_grad_f_(eval_grad_f),
                     eval_jac_g_(eval_jac_g),
                     eval_h_(eval_h),
+                    eval_f_g_jac_(NULL),
+                    eval_batch_(NULL),
                     var_types_(var_types),
                     var_linearity_types_(var_linearity_types),
                     constraint_linearity_types_(constraint_linearity_types),
@@ -73,6 +75,20 @@ namespace Bonmin
                     x_scaling_(NULL),
                     g_scaling_(NULL),
                     non_const_x_(NULL),
+                    jac_iRow_(NULL),
+                    jac_jCol_(NULL),
+                    h_iRow_(NULL),
+                    h_jCol_(NULL),
+                    jac_structure_(NULL),
+                    h_structure_(NULL),
+                    jac_row_start_(NULL),
+                    jac_col_(NULL),
+                    jac_pos_(NULL),
+                    g_values_(NULL),
+                    jac_values_(NULL),
+                    obj_value_(0),
+                    values_cached_(false),
+                    g_jac_cached_(false),
                     x_sol_(x_sol),
                     z_L_sol_(z_L_sol),
                     z_U_sol_(z_U_sol),
@@ -105,6 +121,13 @@ namespace Bonmin
         delete [] non_const_x_;
         delete [] x_scaling_;
         delete [] g_scaling_;
+        delete [] jac_structure_;
+        delete [] h_structure_;
+        delete [] jac_row_start_;
+        delete [] jac_col_;
+        delete [] jac_pos_;
+        delete [] g_values_;
+        delete [] jac_values_;
     }
 
 
@@ -244,6 +267,14 @@ namespace Bonmin
     {
         DBG_ASSERT(n==n_var_);
 
+        if (eval_f_g_jac_) {
+            if (!eval_f_g_jac(n, x, new_x)) {
+                return false;
+            }
+            obj_value = obj_value_;
+            return true;
+        }
+
         apply_new_x(new_x, n, x);
 
         Bool retval = (*eval_f_)(n, non_const_x_, (Bool)new_x,
@@ -269,6 +300,16 @@ namespace Bonmin
         DBG_ASSERT(n==n_var_);
         DBG_ASSERT(m==n_con_);
 
+        if (eval_f_g_jac_) {
+            if (!eval_f_g_jac(n, x, new_x)) {
+                return false;
+            }
+            for (Index i=0; i<m; i++) {
+                g[i] = g_values_[i];
+            }
+            return true;
+        }
+
         apply_new_x(new_x, n, x);
 
         Bool retval = (*eval_g_)(n, non_const_x_, (Bool)new_x, m, g, user_data_);
@@ -285,7 +326,24 @@ namespace Bonmin
 
         Bool retval=1;
 
-        if ( (iRow && jCol && !values) || (!iRow && !jCol && values) ) {
+        if (iRow && jCol && !values) {
+            if (!cache_jac_structure()) {
+                return false;
+            }
+            for (Index k=0; k<nele_jac; k++) {
+                iRow[k] = jac_iRow_[k];
+                jCol[k] = jac_jCol_[k];
+            }
+        }
+        else if (values && eval_f_g_jac_) {
+            if (!eval_f_g_jac(n, x, new_x)) {
+                return false;
+            }
+            for (Index k=0; k<nele_jac; k++) {
+                values[k] = jac_values_[k];
+            }
+        }
+        else if (!iRow && !jCol && values) {
             apply_new_x(new_x, n, x);
             retval = (*eval_jac_g_)(n, non_const_x_, (Bool)new_x, m, nele_jac,
                 iRow, jCol, values, user_data_);
@@ -308,7 +366,16 @@ namespace Bonmin
 
         Bool retval=1;
 
-        if ( (iRow && jCol && !values) || (!iRow && !jCol && values) ) {
+        if (iRow && jCol && !values) {
+            if (!cache_h_structure()) {
+                return false;
+            }
+            for (Index k=0; k<nele_hess; k++) {
+                iRow[k] = h_iRow_[k];
+                jCol[k] = h_jCol_[k];
+            }
+        }
+        else if (!iRow && !jCol && values) {
             apply_new_x(new_x, n, x);
             Number* non_const_lambda = new Number[m];
             if (lambda) {
@@ -328,10 +395,174 @@ namespace Bonmin
         return (retval!=0);
     }
 
+    bool StdInterfaceTMINLP::eval_gi_and_grad_gi(Index n, const Number* x, bool new_x,
+        Index nrows, const Index* rows, Number* g,
+        Index* start, Index* jCol, Number* values)
+    {
+        DBG_ASSERT(n==n_var_);
+
+        if (!jac_row_start_) {
+            // Sort the elements of the Jacobian by rows.
+            if (!cache_jac_structure()) {
+                return false;
+            }
+            Index offset = (index_style_ == 0) ? 0 : 1;
+            const Index* iRow = jac_iRow_;
+            const Index* jacCol = jac_jCol_;
+            jac_row_start_ = new Index[n_con_ + 1];
+            for (Index i=0; i<=n_con_; i++) {
+                jac_row_start_[i] = 0;
+            }
+            for (Index k=0; k<nele_jac_; k++) {
+                jac_row_start_[iRow[k] - offset + 1]++;
+            }
+            for (Index i=0; i<n_con_; i++) {
+                jac_row_start_[i + 1] += jac_row_start_[i];
+            }
+            jac_col_ = new Index[nele_jac_];
+            jac_pos_ = new Index[nele_jac_];
+            Index* next = new Index[n_con_];
+            for (Index i=0; i<n_con_; i++) {
+                next[i] = jac_row_start_[i];
+            }
+            for (Index k=0; k<nele_jac_; k++) {
+                Index p = next[iRow[k] - offset]++;
+                jac_col_[p] = jacCol[k];
+                jac_pos_[p] = k;
+            }
+            delete [] next;
+        }
+
+        if (eval_f_g_jac_) {
+            if (!eval_f_g_jac(n, x, new_x)) {
+                return false;
+            }
+        }
+        else {
+            apply_new_x(new_x, n, x);
+            if (!g_jac_cached_) {
+                // One evaluation of g and of the Jacobian serves all the rows
+                // asked for at this point.
+                allocate_values();
+                Bool retval = (*eval_g_)(n, non_const_x_, (Bool)new_x, n_con_, g_values_, user_data_);
+                if (retval!=0) {
+                    retval = (*eval_jac_g_)(n, non_const_x_, (Bool)false, n_con_, nele_jac_,
+                        NULL, NULL, jac_values_, user_data_);
+                }
+                if (retval==0) {
+                    return false;
+                }
+                g_jac_cached_ = true;
+            }
+        }
+
+        start[0] = 0;
+        for (Index k=0; k<nrows; k++) {
+            Index i = rows[k];
+            g[k] = g_values_[i];
+            Index nnz = start[k];
+            for (Index p=jac_row_start_[i]; p<jac_row_start_[i + 1]; p++) {
+                jCol[nnz] = jac_col_[p];
+                values[nnz] = jac_values_[jac_pos_[p]];
+                nnz++;
+            }
+            start[k + 1] = nnz;
+        }
+        return true;
+    }
+
+    bool StdInterfaceTMINLP::eval_f_and_g_batch(Index n, Index npoints, const Number* x,
+        Number* obj, Index m, Number* g)
+    {
+        DBG_ASSERT(n==n_var_);
+
+        if (!eval_batch_) {
+            return TMINLP::eval_f_and_g_batch(n, npoints, x, obj, m, g);
+        }
+        Number* non_const_x = new Number[n * npoints];
+        for (Index i=0; i<n * npoints; i++) {
+            non_const_x[i] = x[i];
+        }
+        Bool retval = (*eval_batch_)(n, npoints, non_const_x, obj, m, g, user_data_);
+        delete [] non_const_x;
+        return (retval!=0);
+    }
+
+    void StdInterfaceTMINLP::setStructure(const Index* jac_iRow, const Index* jac_jCol,
+        const Index* h_iRow, const Index* h_jCol)
+    {
+        if (jac_iRow && jac_jCol) {
+            jac_iRow_ = jac_iRow;
+            jac_jCol_ = jac_jCol;
+        }
+        if (h_iRow && h_jCol) {
+            h_iRow_ = h_iRow;
+            h_jCol_ = h_jCol;
+        }
+    }
+
+    bool StdInterfaceTMINLP::cache_jac_structure()
+    {
+        if (jac_iRow_) {
+            return true;
+        }
+        if (!jac_structure_) {
+            jac_structure_ = new Index[2 * nele_jac_];
+        }
+        Bool retval = (*eval_jac_g_)(n_var_, NULL, (Bool)false, n_con_, nele_jac_,
+            jac_structure_, jac_structure_ + nele_jac_, NULL, user_data_);
+        if (retval==0) {
+            return false;
+        }
+        jac_iRow_ = jac_structure_;
+        jac_jCol_ = jac_structure_ + nele_jac_;
+        return true;
+    }
+
+    bool StdInterfaceTMINLP::cache_h_structure()
+    {
+        if (h_iRow_) {
+            return true;
+        }
+        if (!h_structure_) {
+            h_structure_ = new Index[2 * nele_hess_];
+        }
+        Bool retval = (*eval_h_)(n_var_, NULL, (Bool)false, 0, n_con_, NULL, (Bool)false,
+            nele_hess_, h_structure_, h_structure_ + nele_hess_, NULL, user_data_);
+        if (retval==0) {
+            return false;
+        }
+        h_iRow_ = h_structure_;
+        h_jCol_ = h_structure_ + nele_hess_;
+        return true;
+    }
+
+    void StdInterfaceTMINLP::allocate_values()
+    {
+        if (!g_values_) {
+            g_values_ = new Number[n_con_];
+            jac_values_ = new Number[nele_jac_];
+        }
+    }
+
+    bool StdInterfaceTMINLP::eval_f_g_jac(Index n, const Number* x, bool new_x)
+    {
+        apply_new_x(new_x, n, x);
+        if (!values_cached_) {
+            allocate_values();
+            Bool retval = (*eval_f_g_jac_)(n, non_const_x_, (Bool)new_x, &obj_value_,
+                n_con_, g_values_, nele_jac_, jac_values_, user_data_);
+            values_cached_ = (retval!=0);
+        }
+        return values_cached_;
+    }
+
     void StdInterfaceTMINLP::apply_new_x(bool new_x, Index n, const Number* x)
     {
         if (new_x)
         {
+            values_cached_ = false;
+            g_jac_cached_ = false;
             //copy the data to the non_const_x_
             if (!non_const_x_)
             {
@@ -95,10 +95,39 @@ namespace Bonmin
             bool new_lambda, Ipopt::Index nele_hess,
             Ipopt::Index* iRow, Ipopt::Index* jCol, Ipopt::Number* values);
 
+        /** Values and gradients of a list of constraints. The constraints
+         *  and the Jacobian are evaluated once per point through the user
+         *  callbacks and the requested rows are extracted from them (later
+         *  calls at the same point only extract rows).*/
+        virtual bool eval_gi_and_grad_gi(Ipopt::Index n, const Ipopt::Number* x, bool new_x,
+            Ipopt::Index nrows, const Ipopt::Index* rows, Ipopt::Number* g,
+            Ipopt::Index* start, Ipopt::Index* jCol, Ipopt::Number* values);
+
+        /** Objective and constraint values at several points, with one call
+         *  of the batch callback if it was given.*/
+        virtual bool eval_f_and_g_batch(Ipopt::Index n, Ipopt::Index npoints,
+            const Ipopt::Number* x, Ipopt::Number* obj, Ipopt::Index m, Ipopt::Number* g);
+
         virtual void finalize_solution(TMINLP::SolverReturn status, Ipopt::Index n, const Ipopt::Number* x, Ipopt::Number obj_value){}
 
         void apply_new_x(bool new_x, Ipopt::Index n, const Ipopt::Number* x);
 
+        /** Give the structures of the Jacobian and of the Hessian (triplets
+         *  in the index style of the problem). The arrays are borrowed: they
+         *  must stay valid and unchanged as long as this object is used.
+         *  A structure which is not given (NULL pointers) is asked once to
+         *  the callbacks and cached.*/
+        void setStructure(const Ipopt::Index* jac_iRow, const Ipopt::Index* jac_jCol,
+            const Ipopt::Index* h_iRow, const Ipopt::Index* h_jCol);
+
+        /** Set the optional combined callbacks (either may be NULL).*/
+        void setCombinedCallbacks(Eval_F_G_Jac_CB eval_f_g_jac, Eval_Batch_CB eval_batch)
+        {
+            eval_f_g_jac_ = eval_f_g_jac;
+            eval_batch_ = eval_batch;
+            values_cached_ = false;
+        }
+
         // TODO
         virtual const SosInfo * sosConstraints() const{return sos_info_;}
         virtual const BranchingInfo* branchingInfo() const{return branch_info_;}
@@ -107,6 +136,21 @@ namespace Bonmin
         BranchingInfo* getBranchingInfo(){return branch_info_;}
 
     private:
+        /** Make jac_iRow_ and jac_jCol_ point to the structure of the
+         *  Jacobian, asking it to the callback if it is not known yet.*/
+        bool cache_jac_structure();
+
+        /** Make h_iRow_ and h_jCol_ point to the structure of the Hessian,
+         *  asking it to the callback if it is not known yet.*/
+        bool cache_h_structure();
+
+        /** Allocate g_values_ and jac_values_ if needed.*/
+        void allocate_values();
+
+        /** Evaluate objective, constraints and Jacobian values at x with
+         *  eval_f_g_jac_ unless they are cached for this point.*/
+        bool eval_f_g_jac(Ipopt::Index n, const Ipopt::Number* x, bool new_x);
+
         /** Journlist *info_/
         Ipopt::SmartPtr<const Ipopt::Journalist> jnlst_; */
 
@@ -154,6 +198,14 @@ namespace Bonmin
         /** Pointer to callback function evaluating Hessian of Lagrangian */
         Eval_H_CB eval_h_;
 
+        /** Pointer to optional callback function evaluating objective,
+         *  constraints and Jacobian values together (NULL if not given) */
+        Eval_F_G_Jac_CB eval_f_g_jac_;
+
+        /** Pointer to optional callback function evaluating objective and
+         *  constraints at a batch of points (NULL if not given) */
+        Eval_Batch_CB eval_batch_;
+
         VariableType* var_types_;
 
         Ipopt::TNLP::LinearityType* var_linearity_types_;
@@ -183,6 +235,46 @@ namespace Bonmin
         /** A non-const copy of x - this is kept up-to-date in apply_new_x */
         Ipopt::Number* non_const_x_;
 
+        /** @name Structures of the Jacobian and of the Hessian (borrowed from
+         *  the caller or cached in jac_structure_ and h_structure_) */
+        //@{
+        /** Rows of the Jacobian elements (NULL until known) */
+        const Ipopt::Index* jac_iRow_;
+        /** Columns of the Jacobian elements */
+        const Ipopt::Index* jac_jCol_;
+        /** Rows of the Hessian elements (NULL until known) */
+        const Ipopt::Index* h_iRow_;
+        /** Columns of the Hessian elements */
+        const Ipopt::Index* h_jCol_;
+        /** Cached structure of the Jacobian (rows then columns) */
+        Ipopt::Index* jac_structure_;
+        /** Cached structure of the Hessian (rows then columns) */
+        Ipopt::Index* h_structure_;
+        //@}
+
+        /** @name Jacobian stored by rows (built on first call to eval_gi_and_grad_gi)
+         *  and buffers for the values of the constraints and of the Jacobian */
+        //@{
+        /** Start of each row */
+        Ipopt::Index* jac_row_start_;
+        /** Column of each element (in the problem index style) */
+        Ipopt::Index* jac_col_;
+        /** Position of each element in the values given by eval_jac_g */
+        Ipopt::Index* jac_pos_;
+        /** Buffer for the constraint values */
+        Ipopt::Number* g_values_;
+        /** Buffer for the Jacobian values */
+        Ipopt::Number* jac_values_;
+        /** Objective value given by eval_f_g_jac_ */
+        Ipopt::Number obj_value_;
+        /** Do obj_value_, g_values_ and jac_values_ hold the values given by
+         *  eval_f_g_jac_ at non_const_x_? */
+        bool values_cached_;
+        /** Do g_values_ and jac_values_ hold the values given by eval_g_ and
+         *  eval_jac_g_ at non_const_x_ (when there is no eval_f_g_jac_)? */
+        bool g_jac_cached_;
+        //@}
+
         /** Pointers to the user provided vectors for solution */
         Ipopt::Number* x_sol_;
         Ipopt::Number* z_L_sol_;
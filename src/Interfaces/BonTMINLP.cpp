@@ -131,4 +131,36 @@ TMINLP::hasGeneralInteger(){
    return false;
 }
 
+/** Compute values and gradients of a list of constraints.*/
+bool
+TMINLP::eval_gi_and_grad_gi(Ipopt::Index n, const Ipopt::Number* x, bool new_x,
+                            Ipopt::Index nrows, const Ipopt::Index* rows, Ipopt::Number* g,
+                            Ipopt::Index* start, Ipopt::Index* jCol, Ipopt::Number* values){
+  start[0] = 0;
+  for(int k = 0 ; k < nrows ; k++){
+    int nnz;
+    if(!eval_grad_gi(n, x, new_x, rows[k], nnz, jCol + start[k], NULL))
+      return false;
+    if(!eval_grad_gi(n, x, new_x, rows[k], nnz, NULL, values + start[k]))
+      return false;
+    new_x = false;
+    if(!eval_gi(n, x, new_x, rows[k], g[k]))
+      return false;
+    start[k + 1] = start[k] + nnz;
+  }
+  return true;
+}
+
+bool
+TMINLP::eval_f_and_g_batch(Ipopt::Index n, Ipopt::Index npoints, const Ipopt::Number* x,
+                           Ipopt::Number* obj, Ipopt::Index m, Ipopt::Number* g){
+  for(int k = 0 ; k < npoints ; k++){
+    if(!eval_f(n, x + k * n, true, obj[k]))
+      return false;
+    if(g != NULL && m > 0 && !eval_g(n, x + k * n, false, m, g + k * m))
+      return false;
+  }
+  return true;
+}
+
 }
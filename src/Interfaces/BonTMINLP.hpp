@@ -331,6 +331,39 @@ namespace Bonmin
       std::cerr << "Method eval_grad_gi not overloaded from TMINLP\n";
       throw -1;
     }
+    /** Compute the values and the gradients of a list of constraints
+     *  in one pass. The value of constraint rows[k] is put in g[k], its
+     *  gradient in positions start[k] to start[k+1]-1 of jCol and values
+     *  (start has nrows + 1 entries, jCol and values must be large enough
+     *  to hold all the gradients, nnz_jac_g entries are always enough
+     *  when rows has no duplicates). Indices in jCol follow the index style
+     *  of the problem. The default implementation calls eval_gi and
+     *  eval_grad_gi for each constraint, overload it when values and
+     *  gradients can be computed together more efficiently. */
+    virtual bool eval_gi_and_grad_gi(Ipopt::Index n, const Ipopt::Number* x, bool new_x,
+        Ipopt::Index nrows, const Ipopt::Index* rows, Ipopt::Number* g,
+        Ipopt::Index* start, Ipopt::Index* jCol, Ipopt::Number* values);
+    /** Evaluate the objective and the constraints at npoints points in
+     *  one call. Point k is in positions k*n to k*n+n-1 of x, its
+     *  objective value is put in obj[k] and its constraint values in
+     *  positions k*m to k*m+m-1 of g (g may be NULL if only the objective
+     *  is needed). The default implementation calls eval_f and eval_g for
+     *  each point, overload it when several points can be evaluated more
+     *  efficiently together (outer approximation checks all the points of
+     *  the pool of its MILP with one call). */
+    virtual bool eval_f_and_g_batch(Ipopt::Index n, Ipopt::Index npoints,
+        const Ipopt::Number* x, Ipopt::Number* obj, Ipopt::Index m, Ipopt::Number* g);
+    /** Get the structure of the gradient of the objective: the indices
+     *  (following the index style of the problem) of the variables which
+     *  may have a nonzero partial derivative. If jCol is NULL only
+     *  nnz_grad_f is set. Returns false if the structure is not known, the
+     *  gradient has then to be considered dense (this is what the default
+     *  implementation does). */
+    virtual bool get_obj_grad_structure(Ipopt::Index /*n*/, Ipopt::Index& /*nnz_grad_f*/,
+        Ipopt::Index* /*jCol*/)
+    {
+      return false;
+    }
     //@}
 
     /** @name Solution Methods */
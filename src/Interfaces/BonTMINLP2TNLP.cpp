@@ -11,9 +11,12 @@
 
 
 #include "BonTMINLP2TNLP.hpp"
+#include "BonProfiler.hpp"
+#include "BonOptionalLock.hpp"
 #include "IpBlas.hpp"
 #include "IpAlgTypes.hpp"
 #include "IpIpoptCalculatedQuantities.hpp"
+#include <atomic>
 #include <climits>
 #include <string>
 #include <fstream>
@@ -23,7 +26,7 @@
 
 using namespace Ipopt;
 
-extern bool BonminAbortAll;
+extern std::atomic<bool> BonminAbortAll;
 class OsiObject;
 namespace Bonmin
 {
@@ -57,7 +60,8 @@ namespace Bonmin
       nlp_lower_bound_inf_(-DBL_MAX),
       nlp_upper_bound_inf_(DBL_MAX),
       warm_start_entire_iterate_(true),
-      need_new_warm_starter_(true)
+      need_new_warm_starter_(true),
+      eval_mutex_(NULL)
   {
     // read the nlp size and bounds information from
     // the TMINLP and keep an internal copy. This way the
@@ -135,7 +139,8 @@ namespace Bonmin
     nlp_lower_bound_inf_(other.nlp_lower_bound_inf_),
     nlp_upper_bound_inf_(other.nlp_upper_bound_inf_),
     warm_start_entire_iterate_(other.warm_start_entire_iterate_),
-    need_new_warm_starter_(other.need_new_warm_starter_)
+    need_new_warm_starter_(other.need_new_warm_starter_),
+    eval_mutex_(NULL)
   {
     gutsOfCopy(other);
   }
@@ -411,12 +416,20 @@ namespace Bonmin
   bool TMINLP2TNLP::eval_f(Index n, const Number* x, bool new_x,
       Number& obj_value)
   {
+    // Other threads may have evaluated the TMINLP at other points in between.
+    OptionalLock lock(eval_mutex_);
+    // Time the evaluation only, not the wait for the lock.
+    ProfileTimer timer(Profiler::EvalF);
+    new_x = new_x || eval_mutex_ != NULL;
     return tminlp_->eval_f(n, x, new_x, obj_value);
   }
 
   bool TMINLP2TNLP::eval_grad_f(Index n, const Number* x, bool new_x,
       Number* grad_f)
   {
+    OptionalLock lock(eval_mutex_);
+    ProfileTimer timer(Profiler::EvalGradF);
+    new_x = new_x || eval_mutex_ != NULL;
     grad_f[n-1] = 0;
     return tminlp_->eval_grad_f(n, x, new_x, grad_f);
   }
@@ -424,6 +437,9 @@ namespace Bonmin
   bool TMINLP2TNLP::eval_g(Index n, const Number* x, bool new_x,
       Index m, Number* g)
   {
+    OptionalLock lock(eval_mutex_);
+    ProfileTimer timer(Profiler::EvalG);
+    new_x = new_x || eval_mutex_ != NULL;
     int return_code = tminlp_->eval_g(n, x, new_x, m, g);
     return return_code;
   }
@@ -432,6 +448,9 @@ namespace Bonmin
       Index m, Index nele_jac, Index* iRow,
       Index *jCol, Number* values)
   {
+    OptionalLock lock(eval_mutex_);
+    ProfileTimer timer(Profiler::EvalJacG);
+    new_x = new_x || eval_mutex_ != NULL;
     bool return_code =
       tminlp_->eval_jac_g(n, x, new_x, m, nele_jac,
 			  iRow, jCol, values);
@@ -451,6 +470,9 @@ namespace Bonmin
       bool new_lambda, Index nele_hess,
       Index* iRow, Index* jCol, Number* values)
   {
+    OptionalLock lock(eval_mutex_);
+    ProfileTimer timer(Profiler::EvalH);
+    new_x = new_x || eval_mutex_ != NULL;
     return tminlp_->eval_h(n, x, new_x, obj_factor, m, lambda,
         new_lambda, nele_hess,
         iRow, jCol, values);
@@ -460,6 +482,9 @@ namespace Bonmin
   bool TMINLP2TNLP::eval_gi(Index n, const Number* x, bool new_x,
                            Index i, Number& gi)
   {
+    OptionalLock lock(eval_mutex_);
+    ProfileTimer timer(Profiler::EvalGi);
+    new_x = new_x || eval_mutex_ != NULL;
     return tminlp_->eval_gi(n, x, new_x, i, gi);
   }
   
@@ -467,9 +492,23 @@ namespace Bonmin
                                 Index i, Index& nele_grad_gi, Index* jCol,
                                 Number* values)
   {
+    OptionalLock lock(eval_mutex_);
+    ProfileTimer timer(Profiler::EvalGi);
+    new_x = new_x || eval_mutex_ != NULL;
     return tminlp_->eval_grad_gi(n, x, new_x, i, nele_grad_gi, jCol, values);
   }
 
+  bool TMINLP2TNLP::eval_gi_and_grad_gi(Index n, const Number* x, bool new_x,
+                                       Index nrows, const Index* rows, Number* g,
+                                       Index* start, Index* jCol, Number* values)
+  {
+    OptionalLock lock(eval_mutex_);
+    ProfileTimer timer(Profiler::EvalGi);
+    new_x = new_x || eval_mutex_ != NULL;
+    return tminlp_->eval_gi_and_grad_gi(n, x, new_x, nrows, rows, g,
+                                        start, jCol, values);
+  }
+
   void TMINLP2TNLP::finalize_solution(SolverReturn status,
       Index n, const Number* x, const Number* z_L, const Number* z_U,
       Index m, const Number* g, const Number* lambda,
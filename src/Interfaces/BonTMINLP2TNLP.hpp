@@ -12,6 +12,8 @@
 #ifndef __TMINLP2TNLP_HPP__
 #define __TMINLP2TNLP_HPP__
 
+#include <mutex>
+
 #include "IpTNLP.hpp"
 #include "BonTMINLP.hpp"
 #include "IpSmartPtr.hpp"
@@ -308,6 +310,18 @@ namespace Bonmin
     virtual bool eval_grad_gi(Ipopt::Index n, const Ipopt::Number* x, bool new_x,
 			      Ipopt::Index i, Ipopt::Index& nele_grad_gi, Ipopt::Index* jCol,
 			      Ipopt::Number* values);
+    /** compute the values and gradients of a list of constraints
+        (see TMINLP::eval_gi_and_grad_gi) */
+    virtual bool eval_gi_and_grad_gi(Ipopt::Index n, const Ipopt::Number* x, bool new_x,
+        Ipopt::Index nrows, const Ipopt::Index* rows, Ipopt::Number* g,
+        Ipopt::Index* start, Ipopt::Index* jCol, Ipopt::Number* values);
+    /** get the structure of the gradient of the objective
+        (see TMINLP::get_obj_grad_structure) */
+    virtual bool get_obj_grad_structure(Ipopt::Index n, Ipopt::Index& nnz_grad_f,
+        Ipopt::Index* jCol)
+    {
+      return tminlp_->get_obj_grad_structure(n, nnz_grad_f, jCol);
+    }
 
     /** Return the hessian of the
      *  lagrangian. The vectors iRow and jCol only need to be set once
@@ -355,6 +369,14 @@ namespace Bonmin
       Ipopt::SmartPtr<IpoptInteriorWarmStarter> GetWarmStarter();
 
     //@}
+
+    /** Set the mutex serializing the evaluations of the TMINLP (NULL if no
+        other thread evaluates it). When set, evaluations are always done with
+        new_x since other threads evaluate the TMINLP at other points in between.
+        The mutex is not copied by the copy constructor.*/
+    void setEvalMutex(std::mutex * eval_mutex){
+      eval_mutex_ = eval_mutex;
+    }
       
       /** Say if has a specific function to compute upper bounds*/
       virtual bool hasUpperBoundingObjective(){
@@ -487,6 +509,9 @@ namespace Bonmin
     bool need_new_warm_starter_;
     //@}
 
+    /** Mutex serializing the evaluations of tminlp_ (NULL if none).*/
+    std::mutex * eval_mutex_;
+
 
     /** Private method that throws an exception if the variable bounds
      * are not consistent with the variable type */
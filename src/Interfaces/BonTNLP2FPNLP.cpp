@@ -9,6 +9,7 @@
 
 
 #include "BonTNLP2FPNLP.hpp"
+#include "BonTMINLP2TNLP.hpp"
 
 using namespace Ipopt;
 
@@ -27,7 +28,9 @@ namespace Bonmin
       use_local_branching_constraint_(false),
       cutoff_(COIN_DBL_MAX),
       rhs_local_branching_constraint_(COIN_DBL_MAX),
-      index_style_(TNLP::C_STYLE)
+      index_style_(TNLP::C_STYLE),
+      cutoff_cols_(),
+      grad_f_()
   {}
 
   TNLP2FPNLP::TNLP2FPNLP(const SmartPtr<TNLP> tnlp, const SmartPtr<TNLP2FPNLP> other):
@@ -43,7 +46,9 @@ namespace Bonmin
       use_local_branching_constraint_(other->use_local_branching_constraint_),
       cutoff_(other->cutoff_),
       rhs_local_branching_constraint_(other->rhs_local_branching_constraint_),
-      index_style_(other->index_style_)
+      index_style_(other->index_style_),
+      cutoff_cols_(),
+      grad_f_()
   {}
 
   TNLP2FPNLP::~TNLP2FPNLP()
@@ -95,6 +100,36 @@ namespace Bonmin
     return ret_val;
   }
 
+  void
+  TNLP2FPNLP::compute_cutoff_structure(Index n)
+  {
+    cutoff_cols_.clear();
+    TMINLP2TNLP * problem = dynamic_cast<TMINLP2TNLP *>(GetRawPtr(tnlp_));
+    Index nnz_grad_f = 0;
+    if(problem == NULL || !problem->get_obj_grad_structure(n, nnz_grad_f, NULL)) {
+      // Structure unknown, the row is dense.
+      cutoff_cols_.resize(n);
+      for(int i = 0 ; i < n ; i++)
+        cutoff_cols_[i] = i;
+      return;
+    }
+    vector<Index> jCol(nnz_grad_f);
+    problem->get_obj_grad_structure(n, nnz_grad_f, jCol());
+    int index_correction = (index_style_ == TNLP::C_STYLE) ? 0 : 1;
+    vector<char> in_row(n, 0);
+    for(int i = 0 ; i < nnz_grad_f ; i++)
+      in_row[jCol[i] - index_correction] = 1;
+    // The distance to the point is part of the objective.
+    if(use_feasibility_pump_objective_) {
+      for(unsigned int i = 0 ; i < inds_.size() ; i++)
+        in_row[inds_[i]] = 1;
+    }
+    for(int i = 0 ; i < n ; i++) {
+      if(in_row[i])
+        cutoff_cols_.push_back(i);
+    }
+  }
+
   bool
   TNLP2FPNLP::get_nlp_info(Index& n, Index& m, Index& nnz_jac_g,
       Index& nnz_h_lag,
@@ -109,13 +144,18 @@ namespace Bonmin
     if(use_feasibility_pump_objective_ && norm_ == 2)
       nnz_h_lag += (int)vals_.size();
 
+    if(use_cutoff_constraint_) {
+      compute_cutoff_structure(n);
+      grad_f_.resize(n);
+    }
+
     if(use_cutoff_constraint_ && use_local_branching_constraint_) {
       m += 2;
-      nnz_jac_g += (n + (int)vals_.size());
+      nnz_jac_g += ((int)cutoff_cols_.size() + (int)vals_.size());
     }
     else if(use_cutoff_constraint_) {
       m++;
-      nnz_jac_g += n;
+      nnz_jac_g += (int)cutoff_cols_.size();
     }
     else if(use_local_branching_constraint_) {
       m++;
@@ -254,23 +294,23 @@ namespace Bonmin
 
     if(use_cutoff_constraint_ && use_local_branching_constraint_) {
       int n_integers = (int)vals_.size();
-      ret_code = tnlp_->eval_jac_g(n, x, new_x, m, nele_jac - n - n_integers, 
+      int n_cutoff = (int)cutoff_cols_.size();
+      ret_code = tnlp_->eval_jac_g(n, x, new_x, m, nele_jac - n_cutoff - n_integers, 
 				   iRow, jCol, values);
 
       if (iRow && jCol && !values) { //Initialization phase 
 	int index_correction = (index_style_ == TNLP::C_STYLE) ? 0 : 1;
 	// compute the jacobian contribution of the cutoff constraint
-	int k = nele_jac - n - n_integers;
+	int k = nele_jac - n_cutoff - n_integers;
 	iRow += k;
 	jCol += k;
-	for(int i = 0; i< n; i++) {
+	for(int i = 0; i< n_cutoff; i++) {
 	  iRow[i] = m - 2 + index_correction;
-	  jCol[i] = i + index_correction;
+	  jCol[i] = cutoff_cols_[i] + index_correction;
 	}
 	// compute the jacobian contribution of the local branching constraint
-	k = nele_jac - n_integers;
-	iRow += k;
-	jCol += k;
+	iRow += n_cutoff;
+	jCol += n_cutoff;
 	for(int i = 0; i< n_integers; i++) {
 	  iRow[i] = m - 1 + index_correction;
 	  jCol[i] = inds_[i] + index_correction;
@@ -278,21 +318,17 @@ namespace Bonmin
       }
       else if (!iRow & !jCol && values) { //computation phase
 	// compute the jacobian contribution of the cutoff constraint
-	Number* grad_f = new Number[n];
-	bool ret_code_grad_f = eval_grad_f(n, x, new_x, grad_f);
+	values += nele_jac - n_cutoff - n_integers;
+	bool ret_code_grad_f = eval_grad_f(n, x, new_x, grad_f_());
 	if(ret_code_grad_f) {
-	  int k = nele_jac - n - n_integers;
-	  values += k;
-	  for(int i = 0; i< n; i++) {
-	    values[i] = grad_f[i];
+	  for(int i = 0; i< n_cutoff; i++) {
+	    values[i] = grad_f_[cutoff_cols_[i]];
 	  }
 	}
 	else
 	  ret_code = false;
-	delete [] grad_f;
 	// compute the jacobian contribution of the local branching constraint
-	int k = nele_jac - n_integers;
-	values += k;
+	values += n_cutoff;
 	for(int i = 0; i< n_integers; i++) {
 	  if(vals_[i] <= 0.1)
 	    values[i] = 1.0;
@@ -305,32 +341,31 @@ namespace Bonmin
       }
     }
     else if(use_cutoff_constraint_) {
-      ret_code = tnlp_->eval_jac_g(n, x, new_x, m, nele_jac - n, 
+      int n_cutoff = (int)cutoff_cols_.size();
+      ret_code = tnlp_->eval_jac_g(n, x, new_x, m, nele_jac - n_cutoff, 
 				   iRow, jCol, values);
       
       if (iRow && jCol && !values) { //Initialization phase 
 	int index_correction = (index_style_ == TNLP::C_STYLE) ? 0 : 1;
-	int k = nele_jac - n;
+	int k = nele_jac - n_cutoff;
 	iRow += k;
 	jCol += k;
-	for(int i = 0; i< n; i++) {
+	for(int i = 0; i< n_cutoff; i++) {
 	  iRow[i] = m - 1 + index_correction;
-	  jCol[i] = i + index_correction;
+	  jCol[i] = cutoff_cols_[i] + index_correction;
 	}
       }
       else if (!iRow & !jCol && values) { //computation phase
-	Number* grad_f = new Number[n];
-	bool ret_code_grad_f = eval_grad_f(n, x, new_x, grad_f);
+	bool ret_code_grad_f = eval_grad_f(n, x, new_x, grad_f_());
 	if(ret_code_grad_f) {
-	  int k = nele_jac - n;
+	  int k = nele_jac - n_cutoff;
 	  values += k;
-	  for(int i = 0; i< n; i++) {
-	    values[i] = grad_f[i];
+	  for(int i = 0; i< n_cutoff; i++) {
+	    values[i] = grad_f_[cutoff_cols_[i]];
 	  }
 	}
 	else
 	  ret_code = false;
-	delete [] grad_f;
       }	  
       else { //error phase
 	DBG_ASSERT(false && "Invalid combination of iRow, jCol, and values pointers");
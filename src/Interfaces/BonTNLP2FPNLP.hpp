@@ -192,6 +192,9 @@ namespace Bonmin
     //@{
     /** Compute the norm-2 distance to the current point to which distance is minimized. */
     double dist_to_point(const Ipopt::Number *x);
+    /** Compute the columns of the cutoff constraint row (the structure of
+        the gradient of the objective if tnlp_ knows it, all columns otherwise). */
+    void compute_cutoff_structure(Ipopt::Index n);
     //@}
     /**@name Default Compiler Generated Methods
      * (Hidden to avoid implicit creation/calling).
@@ -257,6 +260,12 @@ namespace Bonmin
     /// Ipopt::Index style (C++ or Fortran)
     Ipopt::TNLP::IndexStyleEnum index_style_;
 
+    /// Columns (C style) of the cutoff constraint row
+    vector<Ipopt::Index> cutoff_cols_;
+
+    /// Scratch space for the gradient of the objective
+    vector<Ipopt::Number> grad_f_;
+
   };
 
 } // namespace Ipopt
@@ -110,6 +110,12 @@ TNLPSolver(Ipopt::SmartPtr<Bonmin::RegisteredOptions> roptions,
   ///virtual copy constructor
   virtual Ipopt::SmartPtr<TNLPSolver> clone() = 0;
 
+  /** Virtual copy constructor for a copy which will run in another thread
+      than this solver. The copy must not share with this solver any object
+      used (and reference counted) while solving. By default same as clone().*/
+  virtual Ipopt::SmartPtr<TNLPSolver> cloneForThread(){
+    return clone();}
+
    /// Virtual destructor
    virtual ~TNLPSolver();
 
@@ -149,6 +155,11 @@ TNLPSolver(Ipopt::SmartPtr<Bonmin::RegisteredOptions> roptions,
 
   /// Disable the warm start options in the solver
   virtual void disableWarmStart() = 0;
+
+  /** Forget the previous solve, the next problem solved is a new one
+      (its solve can not be warm started from the previous solve).*/
+  virtual void forgetPreviousSolve()
+  {}
    //@}
 
   ///Get a pointer to a journalist
@@ -36,7 +36,9 @@ extern "C"
     real *rstat, ftnlen cstype_len);
 }
 
-//Static variables
+//Static variables, the callbacks of filter reach the problem solved through
+//them. Filter and bqpd keep their own state in common blocks, they can not
+//solve two problems at once (in two threads).
 static Ipopt::TNLP * tnlpSolved = NULL;
 static fint nnz_h = -1;
 
@@ -383,16 +385,6 @@ namespace Bonmin
     tnlp->get_bounds_info(n, cached_->bounds, &cached_->bounds[n+m],
         m, &cached_->bounds[n], &cached_->bounds[2*n + m]);
 
-    tnlpSolved = static_cast<Ipopt::TNLP *>(Ipopt::GetRawPtr(tnlp));
-    nnz_h = cached_->nnz_h_;
-
-    hStruct = cached_->hStruct_;
-
-//Permutation to apply to jacobian in order to get it row ordered
-    permutationJac = cached_->permutationJac_;
-    permutationHess = cached_->permutationHess_;
-
-
     return callOptimizer();
   }
 
@@ -662,6 +654,14 @@ namespace Bonmin
   void
   FilterSolver::cachedInfo::optimize()
   {
+    // Point the callbacks to this problem, another one may have been solved
+    // since it was set up.
+    tnlpSolved = tnlp_;
+    nnz_h = nnz_h_;
+    hStruct = hStruct_;
+    permutationJac = permutationJac_;
+    permutationHess = permutationHess_;
+
     if (use_warm_start_in_cache_) {
       ifail = -1;
       use_warm_start_in_cache_ = false;
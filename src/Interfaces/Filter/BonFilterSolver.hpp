@@ -123,6 +123,13 @@ namespace Bonmin
       warmF_ = NULL;
      //No options to be set
     }
+
+    /// Next solve is not a reoptimization of the previous problem
+    virtual void forgetPreviousSolve()
+    {
+      cached_ = NULL;
+      warmF_ = NULL;
+    }
     //@}
 
     /// Virtual copy constructor
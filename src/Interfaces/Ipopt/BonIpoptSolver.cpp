@@ -14,9 +14,11 @@
 
 #include "BonIpoptInteriorWarmStarter.hpp"
 #include "BonIpoptWarmStart.hpp"
+#include "BonOsiTMINLPInterface.hpp"
 
 
-extern bool BonminAbortAll;
+#include <atomic>
+extern std::atomic<bool> BonminAbortAll;
 
 namespace Bonmin
 {
@@ -99,6 +101,29 @@ namespace Bonmin
     return GetRawPtr(retval);
   }
 
+  Ipopt::SmartPtr<TNLPSolver>
+  IpoptSolver::cloneForThread()
+  {
+    // The reference counts of Ipopt are not atomic and every option lookup
+    // copies a pointer to a registered option: the copy needs its own
+    // registered options, options and journalist.
+    Ipopt::SmartPtr<Bonmin::RegisteredOptions> roptions = new Bonmin::RegisteredOptions;
+    OsiTMINLPInterface::registerOptions(roptions);
+    Ipopt::SmartPtr<Ipopt::Journalist> journalist = new Ipopt::Journalist;
+    Ipopt::SmartPtr<Ipopt::OptionsList> options =
+      new Ipopt::OptionsList(GetRawPtr(roptions), journalist);
+    *options = *options_;
+    // The assignment also copied the pointers of the original, put ours back.
+    options->SetRegisteredOptions(GetRawPtr(roptions));
+    options->SetJournalist(journalist);
+    Ipopt::SmartPtr<IpoptSolver> retval =
+      new IpoptSolver(roptions, options, journalist, prefix());
+    retval->app_->Initialize("");
+    retval->warmStartStrategy_ = warmStartStrategy_;
+    retval->default_log_level_ = default_log_level_;
+    return GetRawPtr(retval);
+  }
+
 
   bool
   IpoptSolver::Initialize(std::string params_file)
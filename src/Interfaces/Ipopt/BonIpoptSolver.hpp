@@ -65,6 +65,9 @@ namespace Bonmin
     ///virtual copy constructor
     virtual Ipopt::SmartPtr<TNLPSolver> clone();
 
+    ///virtual copy constructor for a copy with its own registered options, options and journalist
+    virtual Ipopt::SmartPtr<TNLPSolver> cloneForThread();
+
     /// Virtual destructor
     virtual ~IpoptSolver();
 
@@ -106,6 +109,13 @@ namespace Bonmin
     /// Disable the warm start options in the solver
     virtual void disableWarmStart();
 
+    /// Next solve is not a reoptimization of the previous problem
+    virtual void forgetPreviousSolve()
+    {
+      optimized_before_ = false;
+      problemHadZeroDimension_ = false;
+    }
+
     //@}
 
     /// Get the CpuTime of the last optimization.
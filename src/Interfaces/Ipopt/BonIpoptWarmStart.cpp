@@ -8,7 +8,10 @@
 //
 // Date : 02/15/2006
 
+#include <vector>
+
 #include "BonIpoptWarmStart.hpp"
+#include "BonSpillFile.hpp"
 #include "CoinHelperFunctions.hpp"
 
 #include "BonTMINLP2TNLP.hpp"
@@ -18,6 +21,11 @@ using namespace Ipopt;
 
 namespace Bonmin
 {
+  /** Are the values of the diffs counted on this thread?*/
+  static thread_local bool countDiffEntries = false;
+  /** Bytes taken by the values of the diffs of this thread.*/
+  static thread_local size_t diffBytes = 0;
+
 /// Default constructor
   IpoptWarmStart::IpoptWarmStart
   (bool empty, int numvars, int numcont):
@@ -85,8 +93,30 @@ IpoptWarmStart::IpoptWarmStart(int primal_size, int dual_size,
     CoinWarmStartPrimalDualDiff * pdDiff =
       dynamic_cast<CoinWarmStartPrimalDualDiff*>(diff);
 
+    // Count the values of the diff so that it can be spilled.
+    int numPrimal = primalSize();
+    int numDual = dualSize();
+    int numberEntries = 0;
+    if (!countDiffEntries) {
+      numPrimal = numDual = 0;
+    }
+    else if (numPrimal == ws->primalSize() && numDual == ws->dualSize()) {
+      const double * newValues = primal();
+      const double * oldValues = ws->primal();
+      for (int i = 0 ; i < numPrimal ; i++)
+        if (newValues[i] != oldValues[i]) numberEntries++;
+      newValues = dual();
+      oldValues = ws->dual();
+      for (int i = 0 ; i < numDual ; i++)
+        if (newValues[i] != oldValues[i]) numberEntries++;
+    }
+    else {
+      numPrimal = numDual = 0;
+    }
+
     CoinWarmStartDiff* retval =
-      new IpoptWarmStartDiff(pdDiff, NULL);//warm_starter_);
+      new IpoptWarmStartDiff(pdDiff, NULL,//warm_starter_);
+                             numPrimal, numDual, numberEntries);
     delete diff;
 
     return retval;
@@ -99,6 +129,7 @@ IpoptWarmStart::IpoptWarmStart(int primal_size, int dual_size,
     IpoptWarmStartDiff const * const ipoptDiff =
       dynamic_cast<IpoptWarmStartDiff const * const > (cwsdDiff);
     DBG_ASSERT(ipoptDiff);
+    ipoptDiff->reload();
     CoinWarmStartPrimalDual::applyDiff(ipoptDiff);
     warm_starter_ = ipoptDiff->warm_starter();
   }
@@ -112,9 +143,182 @@ IpoptWarmStart::IpoptWarmStart(int primal_size, int dual_size,
     CoinWarmStartPrimalDual::clear();
   }
 
+  IpoptWarmStartDiff::IpoptWarmStartDiff(CoinWarmStartPrimalDualDiff * diff,
+      Ipopt::SmartPtr<IpoptInteriorWarmStarter> warm_starter,
+      int primalSize, int dualSize, int numberEntries):
+      CoinWarmStartPrimalDualDiff(),
+      warm_starter_(NULL),//(warm_starter)
+      primalSize_(primalSize),
+      dualSize_(dualSize),
+      numberEntries_(numberEntries),
+      spillFile_(NULL),
+      spillPosition_(-1)
+  {
+    CoinWarmStartPrimalDualDiff::swap(*diff);
+    diffBytes += memoryUsage();
+  }
+
+  // The values of other are read back before being copied.
+  IpoptWarmStartDiff::IpoptWarmStartDiff(const IpoptWarmStartDiff &other):
+      CoinWarmStartPrimalDualDiff((other.reload(), other)),
+      warm_starter_(NULL /*other.warm_starter_*/),
+      primalSize_(other.primalSize_),
+      dualSize_(other.dualSize_),
+      numberEntries_(other.numberEntries_),
+      spillFile_(NULL),
+      spillPosition_(-1)
+  {
+    diffBytes += memoryUsage();
+  }
+
+  IpoptWarmStartDiff::~IpoptWarmStartDiff()
+  {
+    if (spillFile_ != NULL)
+      spillFile_->release(spillPosition_, spillSize());
+    diffBytes -= memoryUsage();
+  }
+
+  void
+  IpoptWarmStartDiff::setCountEntries(bool count)
+  {
+    countDiffEntries = count;
+  }
+
+  bool
+  IpoptWarmStartDiff::countEntries()
+  {
+    return countDiffEntries;
+  }
+
+  size_t
+  IpoptWarmStartDiff::bytesInMemory()
+  {
+    return diffBytes;
+  }
+
   void
   IpoptWarmStartDiff::flushPoint()
   {
+    diffBytes -= memoryUsage();
+    if (spillFile_ != NULL) {
+      spillFile_->release(spillPosition_, spillSize());
+      spillFile_ = NULL;
+    }
+    numberEntries_ = 0;
+    CoinWarmStartPrimalDualDiff::clear();
+  }
+
+  void
+  IpoptWarmStartDiff::getEntries(int primalSize, int dualSize,
+      std::vector<int> & indices, std::vector<double> & values) const
+  {
+    indices.clear();
+    values.clear();
+    if (spillFile_ != NULL) {
+      std::vector<char> block(spillSize());
+      if (!spillFile_->read(spillPosition_, &block[0], block.size()))
+        return;
+      const double * blockValues = reinterpret_cast<const double *>(&block[0]);
+      const int * blockIndices =
+        reinterpret_cast<const int *>(&block[numberEntries_ * sizeof(double)]);
+      values.assign(blockValues, blockValues + numberEntries_);
+      indices.assign(blockIndices, blockIndices + numberEntries_);
+      return;
+    }
+    int size = primalSize + dualSize;
+    if (size == 0)
+      return;
+    // The values of the diff are not accessible, recover them by applying
+    // the diff to two different points: the entries of the diff are where
+    // the results agree.
+    std::vector<double> zeros(size, 0.);
+    std::vector<double> ones(size, 1.);
+    CoinWarmStartPrimalDual onZeros(primalSize, dualSize, &zeros[0], &zeros[0] + primalSize);
+    CoinWarmStartPrimalDual onOnes(primalSize, dualSize, &ones[0], &ones[0] + primalSize);
+    onZeros.applyDiff(this);
+    onOnes.applyDiff(this);
+    const double * p0 = onZeros.primal();
+    const double * p1 = onOnes.primal();
+    const double * d0 = onZeros.dual();
+    const double * d1 = onOnes.dual();
+    for (int i = 0 ; i < primalSize ; i++) {
+      if (p0[i] == p1[i]) {
+        indices.push_back(i);
+        values.push_back(p0[i]);
+      }
+    }
+    for (int i = 0 ; i < dualSize ; i++) {
+      if (d0[i] == d1[i]) {
+        indices.push_back(primalSize + i);
+        values.push_back(d0[i]);
+      }
+    }
+  }
+
+  size_t
+  IpoptWarmStartDiff::spill(SpillFile & file)
+  {
+    if (spillFile_ != NULL || numberEntries_ == 0 || primalSize_ + dualSize_ == 0)
+      return 0;
+    std::vector<int> indices;
+    std::vector<double> values;
+    indices.reserve(numberEntries_);
+    values.reserve(numberEntries_);
+    getEntries(primalSize_, dualSize_, indices, values);
+    if (indices.empty())
+      return 0;
+    size_t released = memoryUsage();
+    numberEntries_ = static_cast<int>(indices.size());
+    std::vector<char> block(spillSize());
+    CoinMemcpyN(reinterpret_cast<const char *>(&values[0]),
+        numberEntries_ * sizeof(double), &block[0]);
+    CoinMemcpyN(reinterpret_cast<const char *>(&indices[0]),
+        numberEntries_ * sizeof(int), &block[numberEntries_ * sizeof(double)]);
+    long long position = file.write(&block[0], block.size());
+    if (position < 0) {
+      // The values are still in memory.
+      diffBytes += memoryUsage() - released;
+      return 0;
+    }
+    diffBytes -= released;
+    spillFile_ = &file;
+    spillPosition_ = position;
     CoinWarmStartPrimalDualDiff::clear();
+    return released;
+  }
+
+  void
+  IpoptWarmStartDiff::reload() const
+  {
+    if (spillFile_ == NULL)
+      return;
+    SpillFile * file = spillFile_;
+    spillFile_ = NULL;
+    std::vector<char> block(spillSize());
+    bool ok = file->read(spillPosition_, &block[0], block.size());
+    file->release(spillPosition_, block.size());
+    if (!ok) {
+      // The diff is only a starting point, start from the parent's one.
+      numberEntries_ = 0;
+      return;
+    }
+    const double * values = reinterpret_cast<const double *>(&block[0]);
+    const int * indices = reinterpret_cast<const int *>(&block[numberEntries_ * sizeof(double)]);
+    // Rebuild the diff from two points which differ exactly at its entries.
+    int size = primalSize_ + dualSize_;
+    std::vector<double> newPoint(size, 0.);
+    std::vector<double> oldPoint(size, 0.);
+    for (int k = 0 ; k < numberEntries_ ; k++) {
+      newPoint[indices[k]] = values[k];
+      oldPoint[indices[k]] = (values[k] == 0.) ? 1. : 0.;
+    }
+    CoinWarmStartPrimalDual newWs(primalSize_, dualSize_, &newPoint[0], &newPoint[0] + primalSize_);
+    CoinWarmStartPrimalDual oldWs(primalSize_, dualSize_, &oldPoint[0], &oldPoint[0] + primalSize_);
+    CoinWarmStartDiff * diff = newWs.generateDiff(&oldWs);
+    CoinWarmStartPrimalDualDiff * pdDiff =
+      dynamic_cast<CoinWarmStartPrimalDualDiff*>(diff);
+    const_cast<IpoptWarmStartDiff *>(this)->CoinWarmStartPrimalDualDiff::swap(*pdDiff);
+    delete diff;
+    diffBytes += memoryUsage();
   }
 }
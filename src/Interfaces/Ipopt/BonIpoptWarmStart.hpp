@@ -11,6 +11,7 @@
 
 #ifndef IpoptWarmStart_HPP
 #define IpoptWarmStart_HPP
+#include <vector>
 #include "CoinWarmStartBasis.hpp"
 #include "CoinWarmStartPrimalDual.hpp"
 #include "BonIpoptInteriorWarmStarter.hpp"
@@ -19,6 +20,7 @@
 namespace Bonmin
 {
   class TMINLP2TNLP;
+  class SpillFile;
 
   /** \brief Class for storing warm start informations for Ipopt.<br>
    * This class inherits from CoinWarmStartPrimalDual, because that's what
@@ -104,27 +106,26 @@ namespace Bonmin
   /** \brief Diff class for IpoptWarmStart.
    * Actually get the differences from CoinWarmStartBasis and stores the
    whole vector of values.
+   The values can be moved to a SpillFile to free memory (see spill()), they
+   are read back automatically when the diff is applied.
    \todo Find a way to free unused values.
   */
   class BONMINLIB_EXPORT IpoptWarmStartDiff : public CoinWarmStartPrimalDualDiff
   {
   public:
     friend class IpoptWarmStart;
-    /** Useful constructor; takes over the data in \c diff */
+    /** Useful constructor; takes over the data in \c diff.
+        primalSize and dualSize are the sizes of the warm starts the diff
+        applies to and numberEntries its number of values (0 if not known,
+        the diff can then not be spilled).*/
     IpoptWarmStartDiff(CoinWarmStartPrimalDualDiff * diff,
-		       Ipopt::SmartPtr<IpoptInteriorWarmStarter> warm_starter):
-      CoinWarmStartPrimalDualDiff(),
-      warm_starter_(NULL)//(warm_starter)
-    {
-      CoinWarmStartPrimalDualDiff::swap(*diff);
-    }
-    /** Copy constructor. */
-    IpoptWarmStartDiff(const IpoptWarmStartDiff &other):
-        CoinWarmStartPrimalDualDiff(other),
-        warm_starter_(NULL /*other.warm_starter_*/) {}
+		       Ipopt::SmartPtr<IpoptInteriorWarmStarter> warm_starter,
+                       int primalSize = 0, int dualSize = 0, int numberEntries = 0);
+    /** Copy constructor (values of other are read back if spilled). */
+    IpoptWarmStartDiff(const IpoptWarmStartDiff &other);
 
     /// Abstract destructor
-    virtual ~IpoptWarmStartDiff() {}
+    virtual ~IpoptWarmStartDiff();
 
     /// `Virtual constructor'
     virtual CoinWarmStartDiff *clone() const
@@ -138,10 +139,66 @@ namespace Bonmin
       return warm_starter_;
     }
     void flushPoint();
+
+    /** Move the values of the diff to file. Returns the number of bytes of
+        memory released (0 if nothing was done).*/
+    size_t spill(SpillFile & file);
+
+    /** Read back the values moved by spill() (does nothing if they are in
+        memory).*/
+    void reload() const;
+
+    /** Entries of the diff for warm starts of primalSize primal and
+        dualSize dual values: the positions (the dual values come after the
+        primal ones) and the values it sets. The diff is left as it is, a
+        spilled diff is read from its file and stays there.*/
+    void getEntries(int primalSize, int dualSize, std::vector<int> & indices,
+        std::vector<double> & values) const;
+
+    /** Are the values of the diff in a spill file?*/
+    bool spilled() const
+    {
+      return spillFile_ != NULL;
+    }
+
+    /** Approximate number of bytes taken by the values of the diff.*/
+    size_t memoryUsage() const
+    {
+      return (spillFile_ != NULL) ? 0 :
+          numberEntries_ * (sizeof(double) + sizeof(unsigned int));
+    }
+
+    /** Set if IpoptWarmStart::generateDiff counts the values of the diffs
+        it makes on this thread (without the count a diff can not be
+        spilled and its memoryUsage() is 0). Off by default, counting costs
+        a pass over the two warm starts.*/
+    static void setCountEntries(bool count);
+
+    /** Does IpoptWarmStart::generateDiff count the values of the diffs on
+        this thread?*/
+    static bool countEntries();
+
+    /** Sum of memoryUsage() of the diffs of this thread.*/
+    static size_t bytesInMemory();
   private:
+    /** Bytes taken by the block of the diff in the spill file.*/
+    size_t spillSize() const
+    {
+      return numberEntries_ * (sizeof(double) + sizeof(int));
+    }
 
     /** warm start information object */
     Ipopt::SmartPtr<IpoptInteriorWarmStarter> warm_starter_;
+    /** Size of the primal part of the warm starts.*/
+    int primalSize_;
+    /** Size of the dual part of the warm starts.*/
+    int dualSize_;
+    /** Number of values of the diff.*/
+    mutable int numberEntries_;
+    /** File holding the values (NULL if they are in memory).*/
+    mutable SpillFile * spillFile_;
+    /** Position of the values in spillFile_.*/
+    mutable long long spillPosition_;
   };
 
 }
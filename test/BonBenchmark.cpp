@@ -0,0 +1,240 @@
+// (C) Copyright Bonmin contributors 2026
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+//
+// Date : 10/19/2026
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+#include "CoinPragma.hpp"
+#include "BonminConfig.h"
+#include "CoinTime.hpp"
+#include "CoinError.hpp"
+#include "CbcModel.hpp"
+#include "CbcCutGenerator.hpp"
+#include "BonAmplSetup.hpp"
+#include "BonCbc.hpp"
+#include "BonBatchSolver.hpp"
+#include "BonProfiler.hpp"
+#include "BonGeneratedMinlp.hpp"
+
+/************************************************************************
+
+Benchmark driver of the regression suite. Solves one instance with one
+algorithm and appends one line of measures to a tab separated file
+(the header is written when the file is empty):
+
+  bonminBench [-o resultsFile] [-time_limit seconds] [-options string]
+              [-threads number] algorithm instance
+
+algorithm is one of B-BB, B-OA, B-QG, B-Hyb, B-Ecp and B-iFP.
+instance is either the name of a .nl file, gen:size:seed for a
+generated instance (see GeneratedMinlp) or batch:count:size:seed for
+count generated instances (seeds seed to seed + count - 1) solved by a
+BatchSolver on -threads threads (1 by default); the objective, bound and
+nodes of a batch are the sums over its instances. -options gives more
+options in the syntax of bonmin.opt, bonmin.opt itself is not read.
+
+The columns of the file are the instance, the algorithm, the status, the
+objective, the bound, the wallclock time, the number of nodes, the
+number of NLP solves, the number of NLP iterations, the number of cuts
+generated and the peak resident memory (in kB). run_benchmarks.sh runs
+the whole suite and compare_benchmarks.sh compares two such files.
+
+************************************************************************/
+
+using namespace Bonmin;
+
+/** Names of the statuses of Bab in the results file.*/
+static const char * statusNames[Bab::NumMipStats] = {
+  "optimal",
+  "infeasible",
+  "feasible",
+  "unbounded",
+  "no_solution"};
+
+/** Peak resident memory of the process in kB (0 if unknown).*/
+static long
+peakMemory()
+{
+#ifndef _WIN32
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024;
+#else
+    return usage.ru_maxrss;
+#endif
+  }
+#endif
+  return 0;
+}
+
+int main (int argc, char *argv[])
+{
+  using namespace Ipopt;
+
+  std::string resultsFile = "benchmark.tsv";
+  std::string timeLimit = "600";
+  std::string moreOptions;
+  int numberThreads = 1;
+  int i = 1;
+  for (; i + 1 < argc && argv[i][0] == '-' ; i += 2) {
+    if (strcmp(argv[i], "-o") == 0)
+      resultsFile = argv[i + 1];
+    else if (strcmp(argv[i], "-time_limit") == 0)
+      timeLimit = argv[i + 1];
+    else if (strcmp(argv[i], "-options") == 0)
+      moreOptions = argv[i + 1];
+    else if (strcmp(argv[i], "-threads") == 0)
+      numberThreads = atoi(argv[i + 1]);
+    else
+      break;
+  }
+  if (argc - i != 2) {
+    std::cerr<<"Usage: "<<argv[0]<<" [-o resultsFile] [-time_limit seconds] [-options string]"
+             <<" [-threads number] algorithm instance"<<std::endl;
+    return 1;
+  }
+  std::string algorithm = argv[i];
+  std::string instance = argv[i + 1];
+  // .nl files are named without their directory in the results.
+  std::string name = instance.substr(instance.find_last_of('/') + 1);
+
+  std::string options = "bonmin.algorithm " + algorithm + "\n"
+      "bonmin.time_limit " + timeLimit + "\n"
+      "bonmin.bb_log_level 0\n"
+      "bonmin.nlp_log_level 0\n"
+      "bonmin.oa_log_level 0\n"
+      "bonmin.fp_log_level 0\n"
+      "bonmin.milp_log_level 0\n"
+      "bonmin.lp_log_level 0\n"
+      "print_level 0\n" + moreOptions + "\n";
+
+  Profiler::reset();
+  Profiler::setEnabled(true);
+  double start = CoinWallclockTime();
+
+  std::string status = "error";
+  double objective = COIN_DBL_MAX;
+  double bound = -COIN_DBL_MAX;
+  int nodes = 0;
+  int nlpIterations = 0;
+  long long nlpSolves = 0;
+  int cuts = 0;
+  BonminSetup * setup = NULL;
+  try {
+    if (instance.compare(0, 6, "batch:") == 0) {
+      int count = 0;
+      int size = 0;
+      unsigned long long seed = 0;
+      if (sscanf(instance.c_str() + 6, "%d:%d:%llu", &count, &size, &seed) != 3
+          || count < 1 || size < 1) {
+        std::cerr<<"Batches of generated instances are named batch:count:size:seed"<<std::endl;
+        return 1;
+      }
+      std::vector<SmartPtr<TMINLP> > models;
+      for (int k = 0 ; k < count ; k++)
+        models.push_back(new GeneratedMinlp(size, seed + k));
+      BatchSolver batch(numberThreads, options);
+      std::vector<BatchSolver::Result> results = batch.solve(models);
+      status = statusNames[Bab::FeasibleOptimal];
+      objective = bound = 0.;
+      for (int k = 0 ; k < count ; k++) {
+        if (!results[k].error.empty()) {
+          std::cerr<<"Instance "<<k<<" of the batch: "<<results[k].error<<std::endl;
+          status = "error";
+        }
+        else if (results[k].status != Bab::FeasibleOptimal && status != "error")
+          status = statusNames[results[k].status];
+        objective += results[k].bestObj;
+        bound += results[k].bestBound;
+        nodes += results[k].numNodes;
+        // The profiler is per thread, the workers count their own solves.
+        nlpSolves += results[k].nlpSolves;
+      }
+    }
+    else if (instance.compare(0, 4, "gen:") == 0) {
+      int size = 0;
+      unsigned long long seed = 0;
+      if (sscanf(instance.c_str() + 4, "%d:%llu", &size, &seed) != 2 || size < 1) {
+        std::cerr<<"Generated instances are named gen:size:seed"<<std::endl;
+        return 1;
+      }
+      setup = new BonminSetup;
+      setup->readOptionsString(options);
+      setup->initialize(new GeneratedMinlp(size, seed));
+    }
+    else {
+      // Options are read first so that bonmin.opt of the current directory is ignored.
+      char * args[3] = {argv[0], const_cast<char *>(instance.c_str()), NULL};
+      char ** amplArgv = args;
+      BonminAmplSetup * amplSetup = new BonminAmplSetup;
+      setup = amplSetup;
+      amplSetup->readOptionsString(options);
+      amplSetup->initialize(amplArgv);
+    }
+    if (setup != NULL) {
+      Bab bb;
+      bb(*setup);
+      status = statusNames[bb.mipStatus()];
+      objective = bb.bestObj();
+      bound = bb.bestBound();
+      nodes = bb.numNodes();
+      OsiTMINLPInterface * nlp = dynamic_cast<OsiTMINLPInterface *>(bb.model().solver());
+      if (nlp == NULL)
+        nlp = setup->nonlinearSolver();
+      if (nlp != NULL)
+        nlpIterations = nlp->totalIterations();
+      for (int j = 0 ; j < bb.model().numberCutGenerators() ; j++)
+        cuts += bb.model().cutGenerator(j)->numberCutsInTotal();
+    }
+  }
+  catch(OsiTMINLPInterface::SimpleError &E) {
+    std::cerr<<E.className()<<"::"<<E.methodName()
+             <<std::endl
+             <<E.message()<<std::endl;
+  }
+  catch(CoinError &E) {
+    std::cerr<<E.className()<<"::"<<E.methodName()
+             <<std::endl
+             <<E.message()<<std::endl;
+  }
+  catch (Ipopt::IpoptException &E) {
+    std::cerr<<"Ipopt exception : "<<E.Message()<<std::endl;
+  }
+  catch(TNLPSolver::UnsolvedError *E) {
+    E->printError(std::cerr);
+  }
+  delete setup;
+  double time = CoinWallclockTime() - start;
+  nlpSolves += Profiler::count(Profiler::NlpSolve)
+      + Profiler::count(Profiler::FeasibilityNlpSolve);
+
+  FILE * f = fopen(resultsFile.c_str(), "a");
+  if (f == NULL) {
+    std::cerr<<"Could not open "<<resultsFile<<std::endl;
+    return 1;
+  }
+  fseek(f, 0, SEEK_END);
+  if (ftell(f) == 0)
+    fprintf(f, "instance\talgorithm\tstatus\tobjective\tbound\ttime\tnodes"
+        "\tnlp_solves\tnlp_iterations\tcuts\tpeak_rss_kb\n");
+  fprintf(f, "%s\t%s\t%s\t%.10g\t%.10g\t%.3f\t%d\t%lld\t%d\t%d\t%ld\n",
+      name.c_str(), algorithm.c_str(), status.c_str(), objective, bound,
+      time, nodes, nlpSolves, nlpIterations, cuts, peakMemory());
+  fclose(f);
+  std::cout<<name<<" "<<algorithm<<" "<<status<<" "<<objective
+           <<" in "<<time<<" seconds"<<std::endl;
+  return status == "error";
+}
@@ -0,0 +1,76 @@
+// (C) Copyright Bonmin contributors 2026
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+//
+// Date : 10/19/2026
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <list>
+#include <vector>
+
+#include "CoinPragma.hpp"
+#include "CoinTime.hpp"
+#include "CoinFinite.hpp"
+#include "CbcNode.hpp"
+#include "BonDiver.hpp"
+
+/************************************************************************
+
+Times the dive stack of CbcDfsDiver against the list it replaces on the
+operations of a dive (push, pop, scan for the bound):
+
+  diveStackBench [numberDives]
+
+unitTest checks the dive stack, this only measures it.
+
+************************************************************************/
+
+using namespace Bonmin;
+
+int main (int argc, char *argv[])
+{
+  int numberDives = argc > 1 ? atoi(argv[1]) : 20000;
+  const int numberNodes = 64;
+  std::vector<CbcNode> nodes(numberNodes);
+
+  // Both loops sum the same objectives, sum is printed so that they are
+  // not optimized away.
+  DiveStack dive;
+  double sum = 0.;
+  double start = CoinCpuTime();
+  for (int k = 0 ; k < numberDives ; k++) {
+    for (int i = 0 ; i < numberNodes ; i++)
+      dive.push(&nodes[i], 100. - i, i, 200. - i);
+    sum += dive.bestObjective();
+    while (!dive.empty()) {
+      sum += dive.objective(dive.size() - 1);
+      dive.pop();
+    }
+  }
+  double stackTime = CoinCpuTime() - start;
+
+  std::list<CbcNode *> list;
+  start = CoinCpuTime();
+  for (int k = 0 ; k < numberDives ; k++) {
+    for (int i = 0 ; i < numberNodes ; i++) {
+      nodes[i].setObjectiveValue(100. - i);
+      list.push_front(&nodes[i]);
+    }
+    double best = COIN_DBL_MAX;
+    for (std::list<CbcNode *>::iterator i = list.begin() ; i != list.end() ; i++)
+      best = std::min(best, (*i)->objectiveValue());
+    sum -= best;
+    while (!list.empty()) {
+      sum -= list.front()->objectiveValue();
+      list.pop_front();
+    }
+  }
+  double listTime = CoinCpuTime() - start;
+
+  std::cout<<"Dive stack: "<<stackTime<<"s, list: "<<listTime<<"s for "
+           <<numberDives<<" dives of "<<numberNodes<<" nodes (difference "
+           <<sum<<")"<<std::endl;
+  return 0;
+}
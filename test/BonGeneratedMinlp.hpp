@@ -0,0 +1,245 @@
+// (C) Copyright Bonmin contributors 2026
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+//
+// Date : 10/19/2026
+
+#ifndef BonGeneratedMinlp_H
+#define BonGeneratedMinlp_H
+
+#include <vector>
+
+#include "BonTMINLP.hpp"
+
+/** A generated convex MINLP with size binary variables x and size
+    continuous variables y in [0,1]:
+    \f[
+    \begin{array}{l}
+    \min \sum_i c_i x_i + \sum_i w_i (y_i - t_i)^2 \\
+    \mbox{s.t}\\
+    y_i - x_i \leq 0 \quad i = 1..size \\
+    \sum_i y_i^2 \leq size / 4 \\
+    \sum_i x_i \leq size / 2
+    \end{array}
+    \f]
+    The coefficients are drawn from seed by a linear congruential
+    generator, so an instance is the same on every platform.*/
+class GeneratedMinlp : public Bonmin::TMINLP
+{
+public:
+  /** Constructor.*/
+  GeneratedMinlp(int size, unsigned long long seed):
+    size_(size),
+    cost_(size),
+    weight_(size),
+    target_(size)
+  {
+    for (int i = 0 ; i < size ; i++) {
+      cost_[i] = 0.5 + random(seed);
+      weight_[i] = 1. + 4. * random(seed);
+      target_[i] = 0.5 + 0.5 * random(seed);
+    }
+  }
+
+  virtual bool get_variables_types(Ipopt::Index n, VariableType* var_types)
+  {
+    for (int i = 0 ; i < size_ ; i++) {
+      var_types[i] = BINARY;
+      var_types[size_ + i] = CONTINUOUS;
+    }
+    return true;
+  }
+
+  virtual bool get_variables_linearity(Ipopt::Index n, Ipopt::TNLP::LinearityType* var_types)
+  {
+    for (int i = 0 ; i < size_ ; i++) {
+      var_types[i] = Ipopt::TNLP::LINEAR;
+      var_types[size_ + i] = Ipopt::TNLP::NON_LINEAR;
+    }
+    return true;
+  }
+
+  virtual bool get_constraints_linearity(Ipopt::Index m, Ipopt::TNLP::LinearityType* const_types)
+  {
+    for (int i = 0 ; i < size_ ; i++)
+      const_types[i] = Ipopt::TNLP::LINEAR;
+    const_types[size_] = Ipopt::TNLP::NON_LINEAR;
+    const_types[size_ + 1] = Ipopt::TNLP::LINEAR;
+    return true;
+  }
+
+  virtual bool get_nlp_info(Ipopt::Index& n, Ipopt::Index& m, Ipopt::Index& nnz_jac_g,
+      Ipopt::Index& nnz_h_lag, Ipopt::TNLP::IndexStyleEnum& index_style)
+  {
+    n = 2 * size_;
+    m = size_ + 2;
+    nnz_jac_g = 4 * size_;
+    nnz_h_lag = size_;
+    index_style = Ipopt::TNLP::C_STYLE;
+    return true;
+  }
+
+  virtual bool get_bounds_info(Ipopt::Index n, Ipopt::Number* x_l, Ipopt::Number* x_u,
+      Ipopt::Index m, Ipopt::Number* g_l, Ipopt::Number* g_u)
+  {
+    for (int i = 0 ; i < n ; i++) {
+      x_l[i] = 0.;
+      x_u[i] = 1.;
+    }
+    for (int i = 0 ; i < m ; i++)
+      g_l[i] = -1e19;
+    for (int i = 0 ; i < size_ ; i++)
+      g_u[i] = 0.;
+    g_u[size_] = 0.25 * size_;
+    g_u[size_ + 1] = 0.5 * size_;
+    return true;
+  }
+
+  virtual bool get_starting_point(Ipopt::Index n, bool init_x, Ipopt::Number* x,
+      bool init_z, Ipopt::Number* z_L, Ipopt::Number* z_U,
+      Ipopt::Index m, bool init_lambda, Ipopt::Number* lambda)
+  {
+    for (int i = 0 ; i < n ; i++)
+      x[i] = 0.;
+    return true;
+  }
+
+  virtual bool eval_f(Ipopt::Index n, const Ipopt::Number* x, bool new_x,
+      Ipopt::Number& obj_value)
+  {
+    obj_value = 0.;
+    for (int i = 0 ; i < size_ ; i++) {
+      double d = x[size_ + i] - target_[i];
+      obj_value += cost_[i] * x[i] + weight_[i] * d * d;
+    }
+    return true;
+  }
+
+  virtual bool eval_grad_f(Ipopt::Index n, const Ipopt::Number* x, bool new_x,
+      Ipopt::Number* grad_f)
+  {
+    for (int i = 0 ; i < size_ ; i++) {
+      grad_f[i] = cost_[i];
+      grad_f[size_ + i] = 2. * weight_[i] * (x[size_ + i] - target_[i]);
+    }
+    return true;
+  }
+
+  virtual bool eval_g(Ipopt::Index n, const Ipopt::Number* x, bool new_x,
+      Ipopt::Index m, Ipopt::Number* g)
+  {
+    for (int i = 0 ; i < m ; i++)
+      eval_gi(n, x, new_x, i, g[i]);
+    return true;
+  }
+
+  virtual bool eval_jac_g(Ipopt::Index n, const Ipopt::Number* x, bool new_x,
+      Ipopt::Index m, Ipopt::Index nele_jac, Ipopt::Index* iRow,
+      Ipopt::Index *jCol, Ipopt::Number* values)
+  {
+    for (int i = 0, k = 0 ; i < m ; i++) {
+      Ipopt::Index nele;
+      eval_grad_gi(n, x, new_x, i, nele, jCol ? jCol + k : NULL,
+          values ? values + k : NULL);
+      if (iRow != NULL) {
+        for (int j = 0 ; j < nele ; j++)
+          iRow[k + j] = i;
+      }
+      k += nele;
+    }
+    return true;
+  }
+
+  virtual bool eval_h(Ipopt::Index n, const Ipopt::Number* x, bool new_x,
+      Ipopt::Number obj_factor, Ipopt::Index m, const Ipopt::Number* lambda,
+      bool new_lambda, Ipopt::Index nele_hess,
+      Ipopt::Index* iRow, Ipopt::Index* jCol, Ipopt::Number* values)
+  {
+    for (int i = 0 ; i < size_ ; i++) {
+      if (iRow != NULL) {
+        iRow[i] = size_ + i;
+        jCol[i] = size_ + i;
+      }
+      else
+        values[i] = 2. * (obj_factor * weight_[i] + lambda[size_]);
+    }
+    return true;
+  }
+
+  virtual bool eval_gi(Ipopt::Index n, const Ipopt::Number* x, bool new_x,
+      Ipopt::Index i, Ipopt::Number& gi)
+  {
+    gi = 0.;
+    if (i < size_)
+      gi = x[size_ + i] - x[i];
+    else if (i == size_) {
+      for (int j = 0 ; j < size_ ; j++)
+        gi += x[size_ + j] * x[size_ + j];
+    }
+    else {
+      for (int j = 0 ; j < size_ ; j++)
+        gi += x[j];
+    }
+    return true;
+  }
+
+  virtual bool eval_grad_gi(Ipopt::Index n, const Ipopt::Number* x, bool new_x,
+      Ipopt::Index i, Ipopt::Index& nele_grad_gi, Ipopt::Index* jCol,
+      Ipopt::Number* values)
+  {
+    if (i < size_) {
+      nele_grad_gi = 2;
+      if (jCol != NULL) {
+        jCol[0] = i;
+        jCol[1] = size_ + i;
+      }
+      if (values != NULL) {
+        values[0] = -1.;
+        values[1] = 1.;
+      }
+      return true;
+    }
+    nele_grad_gi = size_;
+    int offset = i == size_ ? size_ : 0;
+    for (int j = 0 ; j < size_ ; j++) {
+      if (jCol != NULL)
+        jCol[j] = offset + j;
+      if (values != NULL)
+        values[j] = i == size_ ? 2. * x[size_ + j] : 1.;
+    }
+    return true;
+  }
+
+  virtual void finalize_solution(TMINLP::SolverReturn status,
+      Ipopt::Index n, const Ipopt::Number* x, Ipopt::Number obj_value)
+  {}
+
+  virtual const BranchingInfo * branchingInfo() const
+  {
+    return NULL;
+  }
+
+  virtual const SosInfo * sosConstraints() const
+  {
+    return NULL;
+  }
+
+private:
+  /** Next number in [0,1) of the generator.*/
+  static double random(unsigned long long & seed)
+  {
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    return (seed >> 11) * (1. / 9007199254740992.);
+  }
+
+  /** Number of binary (and of continuous) variables.*/
+  int size_;
+  /** Costs of the binary variables.*/
+  std::vector<double> cost_;
+  /** Weights of the quadratic terms.*/
+  std::vector<double> weight_;
+  /** Targets of the continuous variables.*/
+  std::vector<double> target_;
+};
+
+#endif
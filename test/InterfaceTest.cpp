@@ -12,9 +12,12 @@
 #include "OsiClpSolverInterface.hpp"
 #include "BonTMINLP.hpp"
 #include "IpIpoptApplication.hpp"
+#include "IpoptConfig.h"
 #ifdef BONMIN_HAS_ASL
 #include "BonAmplTMINLP.hpp"
 #include "BonAmplSetup.hpp"
+#include "BonAmplCompiledEvaluator.hpp"
+#include "BonSolReader.hpp"
 #endif
 
 #include "BonIpoptSolver.hpp"
@@ -25,8 +28,27 @@
 #endif
 
 #include "CoinError.hpp"
+#include "CbcNode.hpp"
+#include "BonDiver.hpp"
+#include "BonBonminSetup.hpp"
+#include "BonSolverContext.hpp"
+#include "BonBatchSolver.hpp"
+#include "BonBabCheckpoint.hpp"
+#include "BonGeneratedMinlp.hpp"
+#include "BonOuterDescriptionCuts.hpp"
+#include "BonDataFile.hpp"
+#include "BonBoundsReader.hpp"
+#include "BonStartPointReader.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <sstream>
 #include <string>
+#include <vector>
 #include <cmath>
 using namespace Bonmin;
 
@@ -273,6 +295,681 @@ void testFp(Bonmin::AmplInterface &si)
          std::cout<<si.getColSolution()[1]<<std::endl;
        DblEqAssert(si.getColSolution()[1],(1./2.));
 }
+/** Check that fused evaluations of rows agree with row by row evaluations.*/
+void testEvalRows(OsiTMINLPInterface &si)
+{
+  using namespace Ipopt;
+  TMINLP * model = si.model();
+  Index n, m, nnz_jac, nnz_h;
+  TNLP::IndexStyleEnum index_style;
+  model->get_nlp_info(n, m, nnz_jac, nnz_h, index_style);
+  std::vector<Index> rows(m), start(m + 1), jCol(nnz_jac + 1), jCol1(n);
+  std::vector<Number> x(n), g(m), values(nnz_jac + 1), values1(n);
+  for (int i = 0 ; i < n ; i++) x[i] = 0.2 * (i + 1);
+  for (int i = 0 ; i < m ; i++) rows[i] = m - 1 - i;
+  MyAssert(model->eval_gi_and_grad_gi(n, &x[0], true, m, &rows[0], &g[0],
+                                      &start[0], &jCol[0], &values[0]));
+  for (int k = 0 ; k < m ; k++) {
+    Number gi;
+    Index nnz;
+    model->eval_gi(n, &x[0], false, rows[k], gi);
+    DblEqAssert(g[k], gi);
+    model->eval_grad_gi(n, &x[0], false, rows[k], nnz, &jCol1[0], NULL);
+    model->eval_grad_gi(n, &x[0], false, rows[k], nnz, NULL, &values1[0]);
+    MyAssert(start[k + 1] - start[k] == nnz);
+    for (int i = 0 ; i < nnz ; i++) {
+      MyAssert(jCol[start[k] + i] == jCol1[i]);
+      DblEqAssert(values[start[k] + i], values1[i]);
+    }
+  }
+}
+
+#ifdef BONMIN_HAS_ASL
+/** Check evaluations of the compiled evaluator against ASL's.*/
+void testCompiledEvaluator(OsiTMINLPInterface &si)
+{
+  using namespace Ipopt;
+  AmplTMINLP * model = dynamic_cast<AmplTMINLP *>(si.model());
+  MyAssert(model != NULL);
+  AmplCompiledEvaluator compiled(model->AmplSolverObject());
+  MyAssert(compiled.isCompiled());
+
+  Index n, m, nnz_jac, nnz_h;
+  TNLP::IndexStyleEnum index_style;
+  model->get_nlp_info(n, m, nnz_jac, nnz_h, index_style);
+  std::vector<Index> iRow(std::max(nnz_jac, nnz_h) + 1);
+  std::vector<Index> jCol(iRow.size());
+  model->eval_jac_g(n, NULL, false, m, nnz_jac, &iRow[0], &jCol[0], NULL);
+  compiled.setJacobianStructure(nnz_jac, &iRow[0], &jCol[0], index_style);
+  model->eval_h(n, NULL, false, 1., m, NULL, false, nnz_h, &iRow[0], &jCol[0], NULL);
+  compiled.setHessianStructure(nnz_h, &iRow[0], &jCol[0], index_style);
+
+  std::vector<Number> x(n), lambda(m);
+  std::vector<Number> a(std::max(std::max(n, m), std::max(nnz_jac, nnz_h)) + 1);
+  std::vector<Number> b(a.size());
+  for (int p = 0 ; p < 3 ; p++) {
+    // Points in (0, 0.4), inside the domains of the generated instances.
+    for (int i = 0 ; i < n ; i++) x[i] = 0.05 + 0.1 * p + 0.07 * i;
+    for (int i = 0 ; i < m ; i++) lambda[i] = 1. - 0.3 * (p + i);
+
+    Number fa, fb;
+    model->eval_f(n, &x[0], true, fa);
+    compiled.eval_f(n, &x[0], true, fb);
+    DblEqAssert(fa, fb);
+
+    model->eval_grad_f(n, &x[0], false, &a[0]);
+    compiled.eval_grad_f(n, &x[0], false, &b[0]);
+    for (int i = 0 ; i < n ; i++) DblEqAssert(a[i], b[i]);
+
+    model->eval_g(n, &x[0], false, m, &a[0]);
+    compiled.eval_g(n, &x[0], false, m, &b[0]);
+    for (int i = 0 ; i < m ; i++) DblEqAssert(a[i], b[i]);
+
+    model->eval_jac_g(n, &x[0], false, m, nnz_jac, NULL, NULL, &a[0]);
+    compiled.eval_jac_g(n, &x[0], false, m, nnz_jac, &b[0]);
+    for (int i = 0 ; i < nnz_jac ; i++) DblEqAssert(a[i], b[i]);
+
+    model->eval_h(n, &x[0], false, 0.5, m, &lambda[0], true, nnz_h, NULL, NULL, &a[0]);
+    compiled.eval_h(n, &x[0], false, 0.5, m, &lambda[0], nnz_h, &b[0]);
+    for (int i = 0 ; i < nnz_h ; i++) DblEqAssert(a[i], b[i]);
+  }
+  std::cout<<"Compiled evaluator agrees with ASL"<<std::endl;
+}
+
+/** Write stub.nl, a model in 3 variables in [0,1] and 3 constraints (all
+    of them nonlinear in every variable) with numberDefined defined
+    variables, given the text of its V, C and O segments. Constraint i
+    also has the linear term x_i and the objective the linear term x0.*/
+static void writeGeneratedNl(const std::string & stub, int numberDefined,
+    const std::string & segments)
+{
+  std::ofstream out((stub + ".nl").c_str());
+  out<<"g3 1 1 0\n"
+     <<" 3 3 1 0 0\n"
+     <<" 3 1\n"
+     <<" 0 0\n"
+     <<" 3 3 3\n"
+     <<" 0 0 0 1\n"
+     <<" 0 0 0 0 0\n"
+     <<" 9 3\n"
+     <<" 0 0\n"
+     <<" "<<numberDefined<<" 0 0 0 0\n"
+     <<segments
+     <<"r\n1 10\n1 10\n1 10\n"
+     <<"b\n0 0 1\n0 0 1\n0 0 1\n"
+     <<"k2\n3\n6\n";
+  for (int i = 0 ; i < 3 ; i++) {
+    out<<"J"<<i<<" 3\n";
+    for (int j = 0 ; j < 3 ; j++)
+      out<<j<<" "<<(i == j ? 1 : 0)<<"\n";
+  }
+  out<<"G0 3\n0 1\n1 0\n2 0\n";
+}
+
+/** Compare the compiled evaluator with ASL on generated instances which
+    use every operator it compiles.*/
+void testCompiledEvaluatorOperators()
+{
+  std::cout<<"Testing compiled evaluator on all operators"<<std::endl;
+  const int numberInstances = 3;
+  const char * stubs[numberInstances] = {"bonminArith", "bonminElementary",
+      "bonminHyperbolic"};
+  // +, -, *, /, x^y, x^2, x^c, c^x, unary minus and sums, minimized.
+  writeGeneratedNl(stubs[0], 0,
+      // x0 * x1 + x2 / (1 + x0)
+      "C0\no0\no2\nv0\nv1\no3\nv2\no0\nn1\nv0\n"
+      // x0^x1 - (-x2)^2
+      "C1\no1\no5\nv0\nv1\no5\no16\nv2\nn2\n"
+      // x0^2.5 + 2^x1 - x2
+      "C2\no54\n3\no5\nv0\nn2.5\no5\nn2\nv1\no16\nv2\n"
+      // x0 * x1 * x2 + x0^2
+      "O0 0\no0\no2\no2\nv0\nv1\nv2\no5\nv0\nn2\n");
+  // sqrt, exp, log, log10, sin, cos, tan and abs, maximized.
+  writeGeneratedNl(stubs[1], 0,
+      // sqrt(1 + x0) + exp(x1) * log(1 + x2)
+      "C0\no0\no39\no0\nn1\nv0\no2\no44\nv1\no43\no0\nn1\nv2\n"
+      // log10(1 + x0 * x1) - sin(x2) * cos(x0)
+      "C1\no1\no42\no0\nn1\no2\nv0\nv1\no2\no41\nv2\no46\nv0\n"
+      // tan(x1) + abs(x0 - x2)
+      "C2\no0\no38\nv1\no15\no1\nv0\nv2\n"
+      // cos(x0 + x1) + exp(-x2)
+      "O0 1\no0\no46\no0\nv0\nv1\no44\no16\nv2\n");
+  // sinh, cosh, tanh, asin, acos, atan, asinh, acosh, atanh and a defined
+  // variable t = sinh(x0 * x1) + 0.5 x2 used by two constraints and the
+  // objective.
+  writeGeneratedNl(stubs[2], 1,
+      "V3 1 0\n2 0.5\no40\no2\nv0\nv1\n"
+      // cosh(t) + tanh(x1)
+      "C0\no0\no45\nv3\no37\nv1\n"
+      // asin(0.5 x0) + acos(0.5 x1) * atan(x2)
+      "C1\no0\no51\no2\nn0.5\nv0\no2\no53\no2\nn0.5\nv1\no49\nv2\n"
+      // asinh(t) + acosh(1 + x0) - atanh(0.5 x2)
+      "C2\no1\no0\no50\nv3\no52\no0\nn1\nv0\no47\no2\nn0.5\nv2\n"
+      // t * t
+      "O0 0\no2\nv3\nv3\n");
+
+  for (int k = 0 ; k < numberInstances ; k++) {
+    const char * args[3] = {"name", stubs[k], NULL};
+    const char ** argv = args;
+    BonminAmplSetup reader;
+    reader.initialize(const_cast<char **&>(argv));
+    std::cout<<stubs[k]<<": ";
+    testCompiledEvaluator(*reader.nonlinearSolver());
+    std::remove((std::string(stubs[k]) + ".nl").c_str());
+  }
+}
+#endif
+
+/** Check the dive stack of CbcDfsDiver (diveStackBench times it).*/
+void testDiveStack()
+{
+  const int numberNodes = 64;
+  std::vector<CbcNode> nodes(numberNodes);
+  DiveStack dive;
+  for (int i = 0 ; i < numberNodes ; i++)
+    dive.push(&nodes[i], 100. - i, i, 200. - i);
+  MyAssert(dive.size() == numberNodes);
+  MyAssert(dive.top() == &nodes[numberNodes - 1]);
+  MyAssert(dive.bottom() == &nodes[0]);
+  DblEqAssert(dive.bestObjective(), 100. - numberNodes + 1);
+  for (int i = 0 ; i < 40 ; i++)
+    dive.popBottom();
+  MyAssert(dive.bottom() == &nodes[40]);
+  MyAssert(dive.depth(0) == 40);
+  DblEqAssert(dive.estimate(0), 160.);
+  dive.pop();
+  MyAssert(dive.top() == &nodes[numberNodes - 2]);
+  DblEqAssert(dive.bestObjective(), 100. - numberNodes + 2);
+  while (!dive.empty())
+    dive.pop();
+  DblEqAssert(dive.bestObjective(), COIN_DBL_MAX);
+}
+
+/** Setup counting the calls to registerOptions.*/
+class CountingSetup : public BonminSetup
+{
+public:
+  CountingSetup():
+      BonminSetup()
+  {}
+  virtual void registerOptions()
+  {
+    numberRegistrations++;
+    BonminSetup::registerOptions();
+  }
+  static int numberRegistrations;
+};
+int CountingSetup::numberRegistrations = 0;
+
+void testSharedRegisteredOptions()
+{
+  std::cout<<"Testing sharing of registered options"<<std::endl;
+  // Not shared by default: each setup can register its own options.
+  {
+    BonminSetup first;
+    first.initializeOptionsAndJournalist();
+    BonminSetup second;
+    second.initializeOptionsAndJournalist();
+    MyAssert(GetRawPtr(first.roptions()) != GetRawPtr(second.roptions()));
+    first.roptions()->AddStringOption2("print_solution", "Do we print the solution or not?",
+        "yes", "no", "No, we don't.", "yes", "Yes, we do.");
+    second.roptions()->AddStringOption2("print_solution", "Do we print the solution or not?",
+        "yes", "no", "No, we don't.", "yes", "Yes, we do.");
+  }
+
+  const int numberSetups = 200;
+  CountingSetup::numberRegistrations = 0;
+  for (int i = 0 ; i < numberSetups ; i++) {
+    CountingSetup setup;
+    setup.initializeOptionsAndJournalist();
+  }
+  MyAssert(CountingSetup::numberRegistrations == numberSetups);
+
+  BabSetupBase::shareRegisteredOptions(true);
+  {
+    CountingSetup first;
+    first.initializeOptionsAndJournalist();
+    CountingSetup second;
+    second.initializeOptionsAndJournalist();
+    MyAssert(GetRawPtr(first.roptions()) == GetRawPtr(second.roptions()));
+    MyAssert(GetRawPtr(first.options()) != GetRawPtr(second.options()));
+    second.options()->SetIntegerValue("bonmin.bb_log_level", 0);
+    int logLevel;
+    first.options()->GetIntegerValue("bb_log_level", logLevel, "bonmin.");
+    MyAssert(logLevel == 1);
+  }
+  CountingSetup::numberRegistrations = 0;
+  for (int i = 0 ; i < numberSetups ; i++) {
+    CountingSetup setup;
+    setup.initializeOptionsAndJournalist();
+  }
+  // Registered once before the loop, never again.
+  MyAssert(CountingSetup::numberRegistrations == 0);
+  BabSetupBase::shareRegisteredOptions(false);
+}
+
+#ifdef BONMIN_HAS_ASL
+void testSolverContext()
+{
+  std::cout<<"Testing solver context"<<std::endl;
+  const char * args[3] ={"name","mytoy",NULL};
+  const char ** argv = args;
+  BonminAmplSetup reader;
+  reader.initialize(const_cast<char **&>(argv));
+  Ipopt::SmartPtr<TMINLP> model = reader.nonlinearSolver()->model();
+
+  SolverContext context("bonmin.bb_log_level 0\nbonmin.nlp_log_level 0\nprint_level 0");
+  MyAssert(context.solve(model) == Bab::FeasibleOptimal);
+  MyAssert(context.bestSolution() != NULL);
+  double firstObj = context.bestObj();
+  OsiTMINLPInterface * nlp = context.setup().nonlinearSolver();
+
+  // The second solve must reuse the NLP solver and find the same optimum.
+  MyAssert(context.solve(model) == Bab::FeasibleOptimal);
+  MyAssert(context.setup().nonlinearSolver() == nlp);
+  DblEqAssert(context.bestObj(), firstObj);
+  MyAssert(context.numberSolves() == 2);
+  MyAssert(context.setupTime() >= 0. && context.solveTime() >= 0.);
+
+  // Options of the NLP solver changed between solves apply to the next one.
+  context.setup().options()->SetNumericValue("bonmin.oa_rhs_relax", 1e-7);
+  MyAssert(context.solve(model) == Bab::FeasibleOptimal);
+  double tiny, veryTiny, rhsRelax, infty;
+  nlp->get_tolerances(tiny, veryTiny, rhsRelax, infty);
+  DblEqAssert(rhsRelax, 1e-7);
+  DblEqAssert(context.bestObj(), firstObj);
+
+  // The NLP solver itself can not change.
+  context.setup().options()->SetStringValue("bonmin.nlp_solver", "filterSQP");
+  bool rejected = false;
+  try {
+    context.solve(model);
+  }
+  catch (CoinError &) {
+    rejected = true;
+  }
+  MyAssert(rejected);
+}
+#endif
+
+/** Raised by Ctrl-C (defined in BonCbc.cpp).*/
+extern std::atomic<bool> BonminAbortAll;
+
+void testBatchSolver()
+{
+  std::cout<<"Testing batch solver"<<std::endl;
+  const int numberModels = 16;
+  std::vector<Ipopt::SmartPtr<TMINLP> > models;
+  for (int k = 0 ; k < numberModels ; k++)
+    models.push_back(new GeneratedMinlp(6, 11 + k));
+
+  // The default linear solver of Ipopt (MUMPS) can only be called from
+  // several threads when Ipopt serializes the calls (since 3.14).
+#if IPOPT_VERSION_MAJOR > 3 || (IPOPT_VERSION_MAJOR == 3 && IPOPT_VERSION_MINOR >= 14)
+  const int numberThreads = 4;
+#else
+  const int numberThreads = 1;
+#endif
+  BatchSolver batch(numberThreads);
+  MyAssert(batch.numberThreads() == numberThreads);
+  // The interruption of an earlier search does not stop a new batch.
+  BonminAbortAll = true;
+  std::vector<BatchSolver::Result> results = batch.solve(models);
+  MyAssert(!BonminAbortAll);
+  MyAssert(results.size() == models.size());
+
+  // The same models solved one after the other on this thread.
+  for (int k = 0 ; k < numberModels ; k++) {
+    SolverContext context("bonmin.bb_log_level 0\nbonmin.nlp_log_level 0\nprint_level 0");
+    Bab::MipStatuses status = context.solve(models[k]);
+    MyAssert(results[k].error.empty());
+    MyAssert(results[k].status == status);
+    MyAssert(status == Bab::FeasibleOptimal);
+    DblEqAssert(results[k].bestObj, context.bestObj());
+    MyAssert(results[k].solution.size() == 12);
+  }
+
+  // Checkpoints would be written by all the workers to the same file.
+  bool rejected = false;
+  try {
+    BatchSolver withCheckpoint(2, "bonmin.checkpoint_file batch.ckpt");
+  }
+  catch (CoinError &) {
+    rejected = true;
+  }
+  MyAssert(rejected);
+}
+
+void testCheckpointRestart()
+{
+  std::cout<<"Testing restart from a checkpoint"<<std::endl;
+  const char * fileName = "bonminCheckpointTest.ckpt";
+  const std::string quiet = "bonmin.bb_log_level 0\nbonmin.nlp_log_level 0\nprint_level 0\n";
+  Ipopt::SmartPtr<TMINLP> model = new GeneratedMinlp(20, 5);
+
+  SolverContext fresh(quiet);
+  MyAssert(fresh.solve(model) == Bab::FeasibleOptimal);
+  int freshNodes = fresh.numNodes();
+  MyAssert(freshNodes > 2);
+
+  // Stopped half way, the last checkpoint holds the open nodes.
+  std::ostringstream interrupted;
+  interrupted<<quiet<<"bonmin.checkpoint_file "<<fileName
+             <<"\nbonmin.checkpoint_interval 0\nbonmin.node_limit "<<freshNodes / 2;
+  SolverContext first(interrupted.str());
+  MyAssert(first.solve(model) != Bab::FeasibleOptimal);
+  BabCheckpoint::Snapshot snapshot;
+  MyAssert(BabCheckpoint::read(fileName, snapshot));
+  MyAssert(!snapshot.nodes.empty());
+
+  // The restart searches only what was left.
+  SolverContext restarted(quiet + "bonmin.checkpoint_file " + fileName +
+                          "\nbonmin.checkpoint_restart yes");
+  MyAssert(restarted.solve(model) == Bab::FeasibleOptimal);
+  DblEqAssert(restarted.bestObj(), fresh.bestObj());
+  MyAssert(restarted.numNodes() < freshNodes);
+  std::remove(fileName);
+}
+
+void testOuterDescriptionCuts()
+{
+  std::cout<<"Testing outer description cuts"<<std::endl;
+  // 4 binaries and 4 continuous variables, constraint 4 is
+  // sum y_i^2 <= 1, the others are linear.
+  const int size = 4;
+  BonminSetup setup;
+  setup.readOptionsString("bonmin.outer_description_max_points 2\n"
+      "bonmin.bb_log_level 0\nbonmin.nlp_log_level 0\nprint_level 0\n");
+  setup.initialize(new GeneratedMinlp(size, 3));
+  setup.nonlinearSolver()->initialSolve();
+  OuterDescriptionCuts outer(setup);
+  MyAssert(outer.nonLinearRows().size() == 1);
+  MyAssert(outer.nonLinearRows()[0] == size);
+
+  OsiClpSolverInterface lp;
+  for (int i = 0 ; i < 2 * size ; i++)
+    lp.addCol(0, NULL, NULL, 0., 1., 0.);
+  std::vector<double> x(2 * size, 1.);
+  lp.setColSolution(&x[0]);
+
+  // A violated constraint gets a tangent and a breakpoint.
+  OsiCuts cs;
+  outer.generateCuts(lp, cs);
+  MyAssert(cs.sizeRowCuts() == 1);
+  MyAssert(outer.numBreakpoints(size) == 1);
+  DblEqAssert(outer.errorBound(size), 3.);
+  DblEqAssert(outer.maxErrorBound(), 3.);
+
+  // The same point again: the tangent is put back, no new breakpoint.
+  outer.generateCuts(lp, cs);
+  MyAssert(cs.sizeRowCuts() == 2);
+  MyAssert(outer.numBreakpoints(size) == 1);
+  MyAssert(outer.numCuts() == 2);
+
+  // Breakpoints given from outside, counted once, none for linear rows.
+  std::vector<double> y(2 * size, 0.5);
+  outer.addBreakpoint(size, &y[0]);
+  outer.addBreakpoint(size, &y[0]);
+  outer.addBreakpoint(0, &y[0]);
+  MyAssert(outer.numBreakpoints(size) == 2);
+  MyAssert(outer.numBreakpoints(0) == 0);
+
+  // The constraint has all its breakpoints, no tangent at a new point.
+  std::vector<double> z(2 * size, 0.9);
+  lp.setColSolution(&z[0]);
+  outer.generateCuts(lp, cs);
+  MyAssert(cs.sizeRowCuts() == 2);
+  MyAssert(outer.numBreakpoints(size) == 2);
+  DblEqAssert(outer.errorBound(size), 2.24);
+}
+
+/** GeneratedMinlp counting the calls to eval_f_and_g_batch.*/
+class BatchCountingMinlp : public GeneratedMinlp
+{
+public:
+  BatchCountingMinlp(int size, unsigned long long seed):
+    GeneratedMinlp(size, seed),
+    batchCalls(0)
+  {}
+  virtual bool eval_f_and_g_batch(Ipopt::Index n, Ipopt::Index npoints,
+      const Ipopt::Number* x, Ipopt::Number* obj, Ipopt::Index m, Ipopt::Number* g)
+  {
+    batchCalls++;
+    return GeneratedMinlp::eval_f_and_g_batch(n, npoints, x, obj, m, g);
+  }
+  int batchCalls;
+};
+
+void testBatchEvaluation()
+{
+  std::cout<<"Testing batch evaluation"<<std::endl;
+  // 4 binaries x and 4 continuous y, the nonlinear constraint is
+  // sum y_i^2 <= 1.
+  const int size = 4;
+  BatchCountingMinlp * minlp = new BatchCountingMinlp(size, 5);
+  Ipopt::SmartPtr<TMINLP> model = minlp;
+  BonminSetup setup;
+  setup.readOptionsString("bonmin.bb_log_level 0\nbonmin.nlp_log_level 0\nprint_level 0\n");
+  setup.initialize(model);
+  OsiTMINLPInterface * nlp = setup.nonlinearSolver();
+
+  // Three points evaluated with one call.
+  double x[3 * 2 * size] = {0., 0., 0., 0., 0., 0., 0., 0.,
+                            1., 1., 1., 1., 1., 1., 1., 1.,
+                            1., 1., 0., 0., 0.75, 0.75, 0., 0.};
+  double obj[3];
+  double violation[3];
+  minlp->batchCalls = 0;
+  MyAssert(nlp->getConstraintsViolations(3, x, obj, violation));
+  MyAssert(minlp->batchCalls == 1);
+  DblEqAssert(violation[0], 0.);
+  DblEqAssert(violation[1], 3.);
+  DblEqAssert(violation[2], 0.125);
+
+  // The same as one point at a time.
+  for (int k = 0 ; k < 3 ; k++) {
+    double f;
+    DblEqAssert(nlp->getConstraintsViolation(x + 2 * size * k, f), violation[k]);
+    DblEqAssert(f, obj[k]);
+    minlp->eval_f(2 * size, x + 2 * size * k, true, f);
+    DblEqAssert(f, obj[k]);
+  }
+  MyAssert(minlp->batchCalls == 4);
+}
+
+/** Write content to fileName.*/
+static void writeRawFile(const std::string & fileName, const std::string & content)
+{
+  std::ofstream out(fileName.c_str(), std::ios::out | std::ios::binary);
+  out.write(content.data(), content.size());
+}
+
+/** Content of fileName.*/
+static std::string readRawFile(const std::string & fileName)
+{
+  std::ifstream in(fileName.c_str(), std::ios::in | std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+/** Is reading bounds from fileName rejected?*/
+static bool badBounds(const std::string & fileName)
+{
+  BoundsReader reader(fileName);
+  try {
+    reader.read();
+  }
+  catch (CoinError &) {
+    return true;
+  }
+  return false;
+}
+
+/** Is reading records from fileName rejected?*/
+static bool badRecords(const std::string & fileName)
+{
+  std::vector<BoundsReader::Record> records;
+  try {
+    BoundsReader::readRecords(fileName, records);
+  }
+  catch (CoinError &) {
+    return true;
+  }
+  return false;
+}
+
+void testDataFiles()
+{
+  std::cout<<"Testing data files"<<std::endl;
+  // Integers out of the range of int are rejected, not truncated.
+  const char numbers[] = "2147483647 2147483648 -2147483648 -2147483649 "
+      "99999999999999999999999 12a";
+  TextScanner scanner(numbers, numbers + sizeof(numbers) - 1);
+  int value;
+  MyAssert(scanner.number(value) && value == INT_MAX);
+  MyAssert(!scanner.number(value));
+  MyAssert(scanner.number(value) && value == INT_MIN);
+  MyAssert(!scanner.number(value));
+  MyAssert(!scanner.number(value));
+  MyAssert(!scanner.number(value));
+  MyAssert(scanner.atEnd());
+
+  const std::string text = "bonminDataTest.txt";
+  const std::string binary = "bonminDataTest.bin";
+
+  // Bounds: text -> binary -> text gives the same values.
+  const int indexLowers[3] = {0, 7, 2};
+  const double lowerBounds[3] = {-1.5, 1e-300, 0.1};
+  const int indexUppers[2] = {3, 1};
+  const double upperBounds[2] = {1e20, 2. / 3.};
+  MyAssert(DataFile::writeBounds(text, false, 3, indexLowers, lowerBounds,
+      2, indexUppers, upperBounds));
+  {
+    BoundsReader reader(text);
+    reader.read();
+    MyAssert(DataFile::writeBounds(binary, true,
+        reader.numberLowers(), reader.indexLowers(), reader.lowerBounds(),
+        reader.numberUppers(), reader.indexUppers(), reader.upperBounds()));
+    reader.read(binary);
+    MyAssert(DataFile::writeBounds(text, false,
+        reader.numberLowers(), reader.indexLowers(), reader.lowerBounds(),
+        reader.numberUppers(), reader.indexUppers(), reader.upperBounds()));
+    reader.read(text);
+    MyAssert(reader.numberLowers() == 3 && reader.numberUppers() == 2);
+    MyAssert(std::equal(indexLowers, indexLowers + 3, reader.indexLowers()));
+    MyAssert(std::equal(lowerBounds, lowerBounds + 3, reader.lowerBounds()));
+    MyAssert(std::equal(indexUppers, indexUppers + 2, reader.indexUppers()));
+    MyAssert(std::equal(upperBounds, upperBounds + 2, reader.upperBounds()));
+  }
+  // Truncated and garbage bounds.
+  std::string content = readRawFile(binary);
+  writeRawFile(binary, content.substr(0, content.size() - 4));
+  MyAssert(badBounds(binary));
+  writeRawFile(text, "LO 1 2.5\nUP 3\n");
+  MyAssert(badBounds(text));
+  writeRawFile(text, "LO 4294967297 1.\n");
+  MyAssert(badBounds(text));
+  writeRawFile(text, "LO -1 1.\n");
+  MyAssert(badBounds(text));
+  writeRawFile(text, "garbage\n");
+  MyAssert(badBounds(text));
+
+  // Records of bound changes: text records end with END (an empty record
+  // too), binary records are bounds data one after the other.
+  writeRawFile(text, "# first\nLO 0 -1.5\nUP 3 1e20\nEND\nEND\nUP 1 0.5\n");
+  {
+    std::vector<BoundsReader::Record> records;
+    BoundsReader::readRecords(text, records);
+    MyAssert(records.size() == 3);
+    MyAssert(records[0].indexLowers.size() == 1 && records[0].indexLowers[0] == 0);
+    DblEqAssert(records[0].lowerBounds[0], -1.5);
+    MyAssert(records[0].indexUppers.size() == 1 && records[0].indexUppers[0] == 3);
+    MyAssert(records[0].upperBounds[0] == 1e20);
+    MyAssert(records[1].indexLowers.empty() && records[1].indexUppers.empty());
+    MyAssert(records[2].indexLowers.empty() && records[2].indexUppers.size() == 1);
+    DblEqAssert(records[2].upperBounds[0], 0.5);
+
+    MyAssert(DataFile::writeBounds(binary, true, 3, indexLowers, lowerBounds,
+        2, indexUppers, upperBounds));
+    std::string first = readRawFile(binary);
+    MyAssert(DataFile::writeBounds(binary, true, 0, NULL, NULL, 1, indexUppers, upperBounds));
+    std::string second = readRawFile(binary);
+    writeRawFile(binary, first + second);
+    records.clear();
+    BoundsReader::readRecords(binary, records);
+    MyAssert(records.size() == 2);
+    MyAssert(std::equal(indexLowers, indexLowers + 3, records[0].indexLowers.begin()));
+    MyAssert(std::equal(lowerBounds, lowerBounds + 3, records[0].lowerBounds.begin()));
+    MyAssert(std::equal(indexUppers, indexUppers + 2, records[0].indexUppers.begin()));
+    MyAssert(std::equal(upperBounds, upperBounds + 2, records[0].upperBounds.begin()));
+    MyAssert(records[1].indexLowers.empty() && records[1].indexUppers.size() == 1);
+    MyAssert(records[1].upperBounds[0] == upperBounds[0]);
+
+    // A truncated last record or a bad line is an error.
+    writeRawFile(binary, first + second.substr(0, second.size() - 4));
+    MyAssert(badRecords(binary));
+    writeRawFile(text, "LO 0 1.\nEND\nUP 2\n");
+    MyAssert(badRecords(text));
+  }
+
+  // Starting points.
+  const double primals[4] = {1., -0.25, 3e-17, 12345.678};
+  const double duals[2] = {0.5, -7.};
+  MyAssert(DataFile::writeStartPoint(text, false, 4, primals, 2, duals));
+  {
+    StartPointReader reader(text);
+    MyAssert(reader.readFile());
+    MyAssert(DataFile::writeStartPoint(binary, true,
+        reader.numberPrimals(), reader.getPrimals(),
+        reader.numberDuals(), reader.getDuals()));
+    MyAssert(reader.readFile(binary));
+    MyAssert(DataFile::writeStartPoint(text, false,
+        reader.numberPrimals(), reader.getPrimals(),
+        reader.numberDuals(), reader.getDuals()));
+    MyAssert(reader.readFile(text));
+    MyAssert(reader.numberPrimals() == 4 && reader.numberDuals() == 2);
+    MyAssert(std::equal(primals, primals + 4, reader.getPrimals()));
+    MyAssert(std::equal(duals, duals + 2, reader.getDuals()));
+
+    content = readRawFile(binary);
+    writeRawFile(binary, content.substr(0, content.size() - 8));
+    MyAssert(!reader.readFile(binary));
+    writeRawFile(text, "4 2\n1.\n2.\n");
+    MyAssert(!reader.readFile(text));
+    MyAssert(reader.getPrimals() == NULL);
+    writeRawFile(text, "3000000000 0\n");
+    MyAssert(!reader.readFile(text));
+    writeRawFile(text, "garbage\n");
+    MyAssert(!reader.readFile(text));
+  }
+
+#ifdef BONMIN_HAS_ASL
+  // Solutions.
+  const double x[3] = {0., 1., -2.5e-8};
+  MyAssert(DataFile::writeSolution(text, false, 3, x));
+  {
+    SolReader reader(text, "");
+    MyAssert(reader.readFile());
+    MyAssert(DataFile::writeSolution(binary, true, reader.n_cols(), reader.x()));
+    MyAssert(reader.readFile(binary));
+    MyAssert(DataFile::writeSolution(text, false, reader.n_cols(), reader.x()));
+    MyAssert(reader.readFile(text));
+    MyAssert(reader.n_cols() == 3);
+    MyAssert(std::equal(x, x + 3, reader.x()));
+
+    content = readRawFile(binary);
+    writeRawFile(binary, content.substr(0, content.size() - 8));
+    MyAssert(!reader.readFile(binary));
+    content = readRawFile(text);
+    writeRawFile(text, content.substr(0, content.rfind('\n', content.size() - 2) + 1));
+    MyAssert(!reader.readFile(text));
+    writeRawFile(text, "garbage\n");
+    MyAssert(!reader.readFile(text));
+  }
+#endif
+  std::remove(text.c_str());
+  std::remove(binary.c_str());
+}
+
 void interfaceTest(Ipopt::SmartPtr<TNLPSolver> solver)
 {
   /**********************************************************************************/
@@ -314,6 +1011,8 @@ void interfaceTest(Ipopt::SmartPtr<TNLPSolver> solver)
       testGetMethods(si);
       testOptimAndSolutionQuery(si);
       testSetMethods(si);
+      testCompiledEvaluator(si);
+      testEvalRows(si);
 
   }
   // Test copy constructor
@@ -391,6 +1090,18 @@ int main()
 {
   WindowsErrorPopupBlocker();
 
+  testDiveStack();
+  testSharedRegisteredOptions();
+#ifdef BONMIN_HAS_ASL
+  testSolverContext();
+  testCompiledEvaluatorOperators();
+#endif
+  testBatchSolver();
+  testCheckpointRestart();
+  testOuterDescriptionCuts();
+  testBatchEvaluation();
+  testDataFiles();
+
   Ipopt::SmartPtr<IpoptSolver> ipopt_solver = new IpoptSolver;
   interfaceTest(GetRawPtr(ipopt_solver));
 
@@ -0,0 +1,85 @@
+#!/bin/bash
+# Copyright (C) 2026 Bonmin contributors
+# All Rights Reserved.
+# This file is distributed under the Eclipse Public License.
+#
+# Compare two results files of run_benchmarks.sh and flag regressions.
+#
+# usage: compare_benchmarks.sh [-r ratio] [-m seconds] baseline.tsv new.tsv
+#
+# A run regresses when its status changes from optimal, when its objective
+# differs from the baseline by more than 1e-6 (relative), or when its time,
+# nodes, NLP solves or peak memory grow by more than ratio (default 1.2)
+# times the baseline. Times under -m seconds (default 0.5) are not compared,
+# they are too noisy. Prints one line per run and exits with 1 if some run
+# regressed.
+
+RATIO=1.2
+MINTIME=0.5
+
+usage() {
+  echo "usage: $0 [-r ratio] [-m seconds] baseline.tsv new.tsv"
+  exit 2
+}
+
+while getopts "r:m:" opt ; do
+  case $opt in
+    r) RATIO="$OPTARG" ;;
+    m) MINTIME="$OPTARG" ;;
+    *) usage ;;
+  esac
+done
+shift $((OPTIND - 1))
+if test $# -ne 2 ; then
+  usage
+fi
+
+awk -F '\t' -v ratio=$RATIO -v mintime=$MINTIME '
+function abs(x) { return x < 0 ? -x : x }
+function worse(column, threshold) {
+  return $column > threshold && $column > ratio * old[key, column]
+}
+FNR == 1 { next }
+FNR == NR {
+  for (i = 1 ; i <= NF ; i++)
+    old[$1 "\t" $2, i] = $i
+  seen[$1 "\t" $2] = 1
+  next
+}
+{
+  key = $1 "\t" $2
+  if (!(key in seen)) {
+    printf "%-32s %-6s new\n", $1, $2
+    next
+  }
+  compared[key] = 1
+  flags = ""
+  if (old[key, 3] == "optimal" && $3 != "optimal")
+    flags = flags " status(" old[key, 3] "->" $3 ")"
+  if (old[key, 3] == "optimal" && $3 == "optimal" &&
+      abs($4 - old[key, 4]) > 1e-6 * (1 + abs(old[key, 4])))
+    flags = flags " objective(" old[key, 4] "->" $4 ")"
+  if (worse(6, mintime))
+    flags = flags " time(" old[key, 6] "->" $6 ")"
+  if (worse(7, 10))
+    flags = flags " nodes(" old[key, 7] "->" $7 ")"
+  if (worse(8, 10))
+    flags = flags " nlp_solves(" old[key, 8] "->" $8 ")"
+  if (worse(11, 1024))
+    flags = flags " peak_rss_kb(" old[key, 11] "->" $11 ")"
+  if (flags != "")
+    regressions++
+  printf "%-32s %-6s %8.3fs -> %8.3fs %s\n", $1, $2, old[key, 6], $6,
+      flags == "" ? "ok" : "REGRESSION" flags
+}
+END {
+  for (key in seen) {
+    if (!(key in compared)) {
+      split(key, k, "\t")
+      printf "%-32s %-6s missing\n", k[1], k[2]
+      regressions++
+    }
+  }
+  printf "%d regression(s)\n", regressions
+  exit regressions > 0
+}' "$1" "$2"
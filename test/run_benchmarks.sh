@@ -0,0 +1,50 @@
+#!/bin/bash
+# Copyright (C) 2026 Bonmin contributors
+# All Rights Reserved.
+# This file is distributed under the Eclipse Public License.
+#
+# Run the benchmark suite: every algorithm of Bonmin on the bundled and
+# generated instances, one line per run in a tab separated results file
+# (see BonBenchmark.cpp for the columns).
+#
+# usage: run_benchmarks.sh [-o results.tsv] [-t timelimit] [-a "B-BB B-OA"] [file.nl ...]
+#
+# Without .nl files the suite runs mytoy.nl and the generated instances of
+# GENERATED, batches of generated instances are solved on THREADS threads.
+# Compare two results files with compare_benchmarks.sh.
+
+ALGORITHMS="B-BB B-OA B-QG B-Hyb B-Ecp B-iFP"
+GENERATED=${GENERATED:-"gen:10:1 gen:20:2 gen:40:3 gen:80:4 batch:64:10:5"}
+THREADS=${THREADS:-4}
+RESULTS=benchmark.tsv
+TIMELIMIT=600
+BENCHMARK=${BENCHMARK:-./bonminBench}
+SRCDIR=`dirname $0`
+
+usage() {
+  echo "usage: $0 [-o results.tsv] [-t timelimit] [-a \"B-BB B-OA\"] [file.nl ...]"
+  exit 1
+}
+
+while getopts "o:t:a:" opt ; do
+  case $opt in
+    o) RESULTS="$OPTARG" ;;
+    t) TIMELIMIT="$OPTARG" ;;
+    a) ALGORITHMS="$OPTARG" ;;
+    *) usage ;;
+  esac
+done
+shift $((OPTIND - 1))
+
+if test $# -eq 0 ; then
+  set -- $SRCDIR/mytoy.nl $GENERATED
+fi
+
+rm -f "$RESULTS"
+failed=0
+for instance in "$@" ; do
+  for algorithm in $ALGORITHMS ; do
+    $BENCHMARK -o "$RESULTS" -time_limit $TIMELIMIT -threads $THREADS $algorithm "$instance" || failed=1
+  done
+done
+exit $failed